@@ -0,0 +1,80 @@
+// modules/mod-real-online/bench/bench.cpp
+
+#include "bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace RealOnline::Bench
+{
+    namespace
+    {
+        struct BenchCase
+        {
+            std::string name;
+            std::function<BenchRun()> prepare;
+        };
+
+        std::vector<BenchCase>& Cases()
+        {
+            static std::vector<BenchCase> cases;
+            return cases;
+        }
+
+        using BenchClock = std::chrono::steady_clock;
+
+        constexpr uint64 MaxIters = uint64(1) << 30;
+    }
+
+    void RegisterBenchCase(char const* name, std::function<BenchRun()> prepare)
+    {
+        Cases().push_back({ name, std::move(prepare) });
+    }
+
+    uint32 RunBenchmarks(std::string_view filter, uint32 minTimeMs)
+    {
+        auto const minTime = std::chrono::milliseconds(minTimeMs);
+        uint32 ran = 0;
+
+        for (BenchCase const& c : Cases())
+        {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos)
+                continue;
+
+            BenchRun run = c.prepare();
+            uint64 sink = run.op(); // zahřátí (cache, lazy alokace)
+
+            // zdvojuj, dokud jedno měření netrvá aspoň minTime
+            uint64 iters = 1;
+            BenchClock::duration elapsed{};
+            while (true)
+            {
+                auto t0 = BenchClock::now();
+                for (uint64 i = 0; i < iters; ++i)
+                    sink += run.op();
+                elapsed = BenchClock::now() - t0;
+
+                if (elapsed >= minTime || iters >= MaxIters)
+                    break;
+                iters *= 2;
+            }
+
+            double ns      = double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            double nsPerOp = ns / double(iters);
+
+            // sink jde do výstupu, jinak by op mohl zmizet při optimalizaci
+            if (run.bytesPerOp)
+                std::printf("{\"bench\":\"%s\",\"iters\":%llu,\"ns_per_op\":%.1f,\"mb_per_s\":%.1f,\"sink\":%llu}\n",
+                    c.name.c_str(), (unsigned long long)iters, nsPerOp,
+                    double(run.bytesPerOp) * 1e9 / nsPerOp / (1024.0 * 1024.0), (unsigned long long)(sink % 1000));
+            else
+                std::printf("{\"bench\":\"%s\",\"iters\":%llu,\"ns_per_op\":%.1f,\"sink\":%llu}\n",
+                    c.name.c_str(), (unsigned long long)iters, nsPerOp, (unsigned long long)(sink % 1000));
+            std::fflush(stdout);
+            ++ran;
+        }
+        return ran;
+    }
+}
@@ -0,0 +1,48 @@
+// modules/mod-real-online/bench/bench.h
+
+#ifndef MOD_REAL_ONLINE_BENCH_H
+#define MOD_REAL_ONLINE_BENCH_H
+
+#include "core_types.h"
+
+#include <functional>
+#include <string_view>
+
+// =============================
+// Mikrobenchmarky (samostatný program real_online_bench)
+// =============================
+// Měří jen části bez jádra (src/text_parse, roster_view, roster_harness,
+// streak_logic, sql_reader, storage_ops nad paměťovým úložištěm) – stejný
+// kód, jaký běží v modulu, ale mimo worldserver.
+// Vstupy se generují v prepare mimo měření, op se opakuje (zdvojováním),
+// dokud nepřesáhne minimální čas.
+//
+// Výstup je jeden JSON objekt na řádek na stdout, např.
+//   {"bench":"online.parse_ranges_2k","iters":4096,"ns_per_op":51234.2,"mb_per_s":312.4}
+namespace RealOnline::Bench
+{
+    // vrací libovolný checksum, aby překladač op nevyhodil
+    using BenchOp = std::function<uint64()>;
+
+    struct BenchRun
+    {
+        BenchOp op;
+        uint64  bytesPerOp = 0; // 0 = bez mb_per_s
+    };
+
+    void RegisterBenchCase(char const* name, std::function<BenchRun()> prepare);
+
+    // filter = podřetězec názvu (prázdný = vše); vrací počet spuštěných případů
+    uint32 RunBenchmarks(std::string_view filter, uint32 minTimeMs);
+
+    // --sql-compare <MB|soubor.sql>: starý splitter vs. mmap tokenizer,
+    // každý v samostatném procesu (peak RSS + propustnost), bench_sql_compare.cpp
+    int RunSqlCompare(std::string_view arg);
+
+    // registrace případů po souborech (bench_*.cpp)
+    void RegisterOnlineBenchCases();
+    void RegisterStreakBenchCases();
+    void RegisterSqlBenchCases();
+}
+
+#endif // MOD_REAL_ONLINE_BENCH_H
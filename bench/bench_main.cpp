@@ -0,0 +1,46 @@
+// modules/mod-real-online/bench/bench_main.cpp
+
+#include "bench.h"
+#include "text_parse.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string_view>
+
+// real_online_bench [filtr] [min. ms na případ]
+// real_online_bench --sql-compare <MB|soubor.sql>
+int main(int argc, char** argv)
+{
+    using namespace RealOnline;
+
+    if (argc == 3 && std::string_view(argv[1]) == "--sql-compare")
+        return Bench::RunSqlCompare(argv[2]);
+
+    std::string_view filter;
+    uint32 minMs = 200;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        uint32 n = 0;
+        if (ParseU32(arg, n))
+            minMs = n;
+        else if (filter.empty())
+            filter = arg;
+        else
+        {
+            std::fprintf(stderr, "usage: %s [filter] [min ms per case]\n       %s --sql-compare <MB|file.sql>\n", argv[0], argv[0]);
+            return 2;
+        }
+    }
+
+    Bench::RegisterOnlineBenchCases();
+    Bench::RegisterStreakBenchCases();
+    Bench::RegisterSqlBenchCases();
+
+    if (Bench::RunBenchmarks(filter, std::clamp(minMs, 1u, 60000u)) == 0)
+    {
+        std::fprintf(stderr, "no benchmark matches '%.*s'\n", int(filter.size()), filter.data());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,219 @@
+// modules/mod-real-online/bench/bench_online.cpp
+
+#include "bench.h"
+#include "message_catalog.h"
+#include "reward_storage_memory.h"
+#include "roster_harness.h"
+#include "roster_view.h"
+#include "storage_ops.h"
+#include "text_parse.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Syntetické vstupy ve velikosti větší akce: 5k hráčů, stovky rozsahů.
+// Škálování .online a playtime ticku: StandInRoster s 1k / 5k / 20k hráči.
+namespace RealOnline::Bench
+{
+    namespace
+    {
+        std::vector<std::string> BenchNames(size_t n)
+        {
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<int> len(4, 12), ch(0, 25);
+            std::vector<std::string> names(n);
+            for (std::string& name : names)
+            {
+                name.resize(size_t(len(rng)));
+                for (size_t i = 0; i < name.size(); ++i)
+                    name[i] = char((i ? 'a' : 'A') + ch(rng));
+            }
+            return names;
+        }
+
+        std::string BenchRangeList(size_t n)
+        {
+            std::string txt;
+            for (size_t i = 0; i < n; ++i)
+                txt += std::to_string(i * 1000 + 1) + "-" + std::to_string(i * 1000 + 250) + (i % 7 ? ";" : " ; ");
+            return txt;
+        }
+
+        // každý 50. účet bot, každý 10. AFK – jen aby filtr prošel všemi větvemi
+        bool BenchIsBot(uint32 account)                  { return account % 50 == 7; }
+        bool BenchIsActiveSince(uint32 account, uint32) { return account % 10 != 3; }
+
+        // filtr playtime ticku: GM, level, 64 rozsahů, bot, AFK
+        EligibilityFilter BenchTickFilter()
+        {
+            EligibilityFilter f;
+            f.hideGMs       = true;
+            f.minLevel      = 10;
+            f.activeSince   = 1;
+            f.ignoreRanges  = ParseRanges(BenchRangeList(64));
+            f.isBot         = &BenchIsBot;
+            f.isActiveSince = &BenchIsActiveSince;
+            return f;
+        }
+
+        // .online 7 nad celým rosterem (filtr, řazení, stránka, hlavička, výpis)
+        void RegisterRosterPage(char const* name, uint32 players)
+        {
+            RegisterBenchCase(name, [players]
+            {
+                auto roster = std::make_shared<StandInRoster>();
+                roster->Reset(players, 1);
+                EligibilityFilter f;
+                f.hideGMs = true;
+                return BenchRun{ [roster, f, players]
+                {
+                    size_t bytes = 0;
+                    Msg err = Msg::PageExpected;
+                    roster->RenderPage(f, players, "7", 50, true, Lang::EN, bytes, err);
+                    return uint64(bytes);
+                } };
+            });
+        }
+
+        // výběr účtů playtime ticku
+        void RegisterEligibility(char const* name, uint32 players)
+        {
+            RegisterBenchCase(name, [players]
+            {
+                auto roster = std::make_shared<StandInRoster>();
+                roster->Reset(players, 1);
+                auto f = std::make_shared<EligibilityFilter>(BenchTickFilter());
+                auto accounts = std::make_shared<std::vector<uint32>>();
+                return BenchRun{ [roster, f, accounts, players]
+                {
+                    uint32 afk = 0;
+                    roster->CollectEligible(*f, players, *accounts, afk);
+                    return uint64(accounts->size()) + afk;
+                } };
+            });
+        }
+
+        // celý tick bez hráčů: výběr účtů, grant do fronty, flush do paměťového úložiště
+        void RegisterTick(char const* name, uint32 players)
+        {
+            RegisterBenchCase(name, [players]
+            {
+                auto roster = std::make_shared<StandInRoster>();
+                roster->Reset(players, 1);
+                auto f = std::make_shared<EligibilityFilter>(BenchTickFilter());
+                auto storage = std::make_shared<MemoryRewardStorage>();
+                auto queue = std::make_shared<EntitlementQueue>();
+                auto accounts = std::make_shared<std::vector<uint32>>();
+                auto rows = std::make_shared<std::vector<LedgerDelta>>();
+                return BenchRun{ [roster, f, storage, queue, accounts, rows, players]
+                {
+                    uint32 afk = 0;
+                    roster->CollectEligible(*f, players, *accounts, afk);
+                    for (uint32 acc : *accounts)
+                        queue->Add(acc, 40000, 1);
+                    queue->Flush(*storage, *rows);
+                    return uint64(rows->size());
+                } };
+            });
+        }
+    }
+
+    void RegisterOnlineBenchCases()
+    {
+        RegisterBenchCase("online.parse_page_or_range", []
+        {
+            auto args = std::make_shared<std::vector<std::string>>(std::vector<std::string>{
+                "", "1", "42", "500", "501", "1-10", "120 - 180", "4990-5000", "0", "abc", "10-2", "-5", "99999999999" });
+            uint64 bytes = 0;
+            for (std::string const& a : *args) bytes += a.size();
+            return BenchRun{ [args]
+            {
+                uint64 sum = 0;
+                for (std::string const& a : *args)
+                {
+                    uint32 b = 0, e = 0, errArg = 0;
+                    Msg err = Msg::PageExpected;
+                    if (ParsePageOrRange(a, 5000, 10, b, e, err, errArg))
+                        sum += e - b;
+                    else
+                        sum += uint64(err);
+                }
+                return sum;
+            }, bytes };
+        });
+
+        RegisterBenchCase("online.parse_ranges_2k", []
+        {
+            auto txt = std::make_shared<std::string>(BenchRangeList(2000));
+            return BenchRun{ [txt]{ return uint64(ParseRanges(*txt).size()); }, txt->size() };
+        });
+
+        RegisterBenchCase("online.in_ranges_64x5k", []
+        {
+            auto ranges = std::make_shared<std::vector<Range>>(ParseRanges(BenchRangeList(64)));
+            auto ids = std::make_shared<std::vector<uint32>>();
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<uint32> id(1, 80000);
+            for (int i = 0; i < 5000; ++i)
+                ids->push_back(id(rng));
+            return BenchRun{ [ranges, ids]
+            {
+                uint64 hits = 0;
+                for (uint32 acc : *ids)
+                    hits += InRanges(acc, *ranges);
+                return hits;
+            } };
+        });
+
+        RegisterBenchCase("online.sort_roster_5k", []
+        {
+            auto names = std::make_shared<std::vector<std::string>>(BenchNames(5000));
+            auto order = std::make_shared<std::vector<std::string const*>>();
+            return BenchRun{ [names, order]
+            {
+                order->clear();
+                for (std::string const& n : *names)
+                    order->push_back(&n);
+                std::sort(order->begin(), order->end(), [](std::string const* a, std::string const* b){ return *a < *b; });
+                return uint64(order->front()->size());
+            } };
+        });
+
+        RegisterBenchCase("online.render_5k", []
+        {
+            auto names = std::make_shared<std::vector<std::string>>(BenchNames(5000));
+            auto lines = std::make_shared<std::vector<RosterLine>>();
+            for (size_t i = 0; i < names->size(); ++i)
+                lines->push_back({ (*names)[i], uint32(1 + i % 80), MsgText(i % 2 ? Msg::FactionHorde : Msg::FactionAlliance, Lang::EN) });
+            return BenchRun{ [names, lines]
+            {
+                uint64 bytes = 0;
+                RenderRoster(lines->data(), lines->size(), true, [&bytes](std::string_view chunk){ bytes += chunk.size(); });
+                return bytes;
+            } };
+        });
+
+        RegisterRosterPage("online.roster_page_1k", 1000);
+        RegisterRosterPage("online.roster_page_5k", 5000);
+        RegisterRosterPage("online.roster_page_20k", 20000);
+
+        RegisterEligibility("reward.eligibility_1k", 1000);
+        RegisterEligibility("reward.eligibility_5k", 5000);
+        RegisterEligibility("reward.eligibility_20k", 20000);
+
+        RegisterTick("reward.tick_1k", 1000);
+        RegisterTick("reward.tick_5k", 5000);
+        RegisterTick("reward.tick_20k", 20000);
+
+        RegisterBenchCase("milestone.parse_csv_255", []
+        {
+            auto txt = std::make_shared<std::string>();
+            for (uint32 m = 255; m >= 1; --m)
+                *txt += std::to_string(m) + (m % 10 ? "," : " , ");
+            return BenchRun{ [txt]{ return uint64(ParseCSVu32(*txt).size()); }, txt->size() };
+        });
+    }
+}
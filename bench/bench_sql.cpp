@@ -0,0 +1,75 @@
+// modules/mod-real-online/bench/bench_sql.cpp
+
+#include "bench.h"
+#include "legacy_sql_split.h"
+#include "sql_reader.h"
+
+#include <memory>
+#include <string>
+
+namespace RealOnline::Bench
+{
+    namespace
+    {
+        // ~4 MB migrace: bloky INSERTů s řetězci a escapy, komentáře, DDL, DELIMITER blok
+        std::string BenchSqlFile()
+        {
+            std::string sql = "-- generated benchmark input\n/* header */\nUSE customs;\n";
+            sql += "CREATE TABLE IF NOT EXISTS bench_t (id INT UNSIGNED NOT NULL, name VARCHAR(64), note TEXT, PRIMARY KEY (id));\n";
+            uint32 id = 0;
+            while (sql.size() < 4u * 1024 * 1024)
+            {
+                for (int i = 0; i < 200; ++i, ++id)
+                    sql += "INSERT INTO bench_t (id, name, note) VALUES (" + std::to_string(id) +
+                           ", 'Name\\'s #" + std::to_string(id) + "', \"semi;colon -- not a comment\");\n";
+                sql += "# batch boundary\nUPDATE bench_t SET note = CONCAT(note, '/* x */') WHERE id < " + std::to_string(id) + ";\n";
+            }
+            sql += "DELIMITER $$\nCREATE PROCEDURE bench_p() BEGIN SELECT 1; SELECT 2; END$$\nDELIMITER ;\n";
+            return sql;
+        }
+    }
+
+    void RegisterSqlBenchCases()
+    {
+        RegisterBenchCase("customs.tokenize_4mb", []
+        {
+            auto sql = std::make_shared<std::string>(BenchSqlFile());
+            return BenchRun{ [sql]
+            {
+                SqlStatementReader reader(*sql);
+                std::string_view stmt;
+                uint64 n = 0;
+                while (reader.Next(stmt))
+                    ++n;
+                return n;
+            }, sql->size() };
+        });
+
+        // starý splitter nad stejným vstupem (bez čtení souboru); \' a DELIMITER
+        // dělí jinak, takže se srovnává jen propustnost, ne výsledek
+        RegisterBenchCase("customs.legacy_split_4mb", []
+        {
+            auto sql = std::make_shared<std::string>(BenchSqlFile());
+            return BenchRun{ [sql]
+            {
+                return uint64(Legacy::SplitSqlStatements(Legacy::StripSqlComments(*sql)).size());
+            }, sql->size() };
+        });
+
+        RegisterBenchCase("customs.tokenize_batch_4mb", []
+        {
+            auto sql = std::make_shared<std::string>(BenchSqlFile());
+            return BenchRun{ [sql]
+            {
+                uint64 bytes = 0;
+                StatementBatcher batcher(1024 * 1024, [&bytes](std::string_view stmt){ bytes += stmt.size(); });
+                SqlStatementReader reader(*sql);
+                std::string_view stmt;
+                while (reader.Next(stmt))
+                    batcher.Add(stmt);
+                batcher.Flush();
+                return bytes + batcher.RoundTrips();
+            }, sql->size() };
+        });
+    }
+}
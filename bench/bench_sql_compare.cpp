@@ -0,0 +1,231 @@
+// modules/mod-real-online/bench/bench_sql_compare.cpp
+
+#include "bench.h"
+#include "legacy_sql_split.h"
+#include "sql_reader.h"
+#include "text_parse.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+// =============================
+// Srovnání cest updateru na velkém souboru (--sql-compare)
+// =============================
+// Každá cesta běží ve vlastním forknutém procesu, špička RSS je ru_maxrss
+// potomka z wait4 – měření se neovlivňují a rodič si nic velkého nedrží.
+// Statementy nejdou do DB, sink jen sčítá bajty; měří se čtení a dělení.
+//   legacy = ReadFile + StripSqlComments + SplitSqlStatements (kopie souboru x3)
+//   mmap   = jako ExecuteSqlFile bez transakce: klasifikační průchod,
+//            SqlStatementReader + StatementBatcher, ReleaseBehind v obou průchodech
+namespace RealOnline::Bench
+{
+    namespace
+    {
+        namespace fs = std::filesystem;
+
+        struct PathResult
+        {
+            uint64 statements = 0;
+            uint64 bytes      = 0; // součet délek statementů (sink)
+            double seconds    = 0;
+        };
+
+        // Vstup, který obě cesty dělí stejně: '' místo \' a bez DELIMITER
+        // (starý splitter neznal ani jedno). Komentáře mezi statementy i
+        // středník a "--" uvnitř řetězců zůstávají.
+        bool WriteCompareFile(std::string const& path, uint64 targetBytes)
+        {
+            std::FILE* f = std::fopen(path.c_str(), "wb");
+            if (!f)
+                return false;
+
+            std::string chunk = "-- generated by real_online_bench --sql-compare\nUSE customs;\n"
+                "CREATE TABLE IF NOT EXISTS bench_t (id INT UNSIGNED NOT NULL, name VARCHAR(64), note TEXT, PRIMARY KEY (id));\n";
+            uint64 written = 0;
+            uint32 id = 0;
+            while (written < targetBytes)
+            {
+                for (int i = 0; i < 200; ++i, ++id)
+                    chunk += "INSERT INTO bench_t (id, name, note) VALUES (" + std::to_string(id) +
+                             ", 'Name''s #" + std::to_string(id) + "', \"semi;colon -- not a comment\");\n";
+                chunk += "# batch boundary\n/* block */\nUPDATE bench_t SET note = CONCAT(note, 'x') WHERE id < " + std::to_string(id) + ";\n";
+
+                if (chunk.size() >= 1024 * 1024)
+                {
+                    written += std::fwrite(chunk.data(), 1, chunk.size(), f);
+                    chunk.clear();
+                }
+            }
+            written += std::fwrite(chunk.data(), 1, chunk.size(), f);
+            return std::fclose(f) == 0;
+        }
+
+        PathResult RunLegacy(std::string const& path)
+        {
+            PathResult r;
+            std::string raw = Legacy::ReadFile(path);
+            if (raw.size() >= 3 && (unsigned char)raw[0] == 0xEF && (unsigned char)raw[1] == 0xBB && (unsigned char)raw[2] == 0xBF)
+                raw.erase(0, 3);
+
+            std::string cleaned = Legacy::StripSqlComments(raw);
+            std::vector<std::string> stmts = Legacy::SplitSqlStatements(cleaned);
+            for (std::string const& s : stmts)
+            {
+                ++r.statements;
+                r.bytes += s.size();
+            }
+            return r;
+        }
+
+        PathResult RunMapped(std::string const& path)
+        {
+            PathResult r;
+            MappedSqlFile file(path);
+            if (!file.IsOpen())
+                return r;
+
+            std::string_view s;
+            bool hasDdl = false;
+            {
+                SqlStatementReader scan(file.View());
+                while (scan.Next(s))
+                {
+                    hasDdl = hasDdl || IsDdl(s);
+                    file.ReleaseBehind(scan.Offset());
+                }
+                file.Rewind();
+            }
+
+            StatementBatcher batcher(1024 * 1024, [](std::string_view) {});
+            SqlStatementReader reader(file.View());
+            while (reader.Next(s))
+            {
+                ++r.statements;
+                r.bytes += s.size();
+                batcher.Add(s);
+                file.ReleaseBehind(reader.Offset());
+            }
+            batcher.Flush();
+            (void)hasDdl; // v ExecuteSqlFile volí transakci; tady jen cena průchodu
+            return r;
+        }
+
+#ifndef _WIN32
+        // cesta v potomkovi; výsledek rourou, RSS z wait4
+        bool RunInChild(PathResult (*run)(std::string const&), std::string const& path, PathResult& out, uint64& peakRssKB)
+        {
+            int fds[2];
+            if (::pipe(fds) != 0)
+                return false;
+
+            pid_t pid = ::fork();
+            if (pid < 0)
+                return false;
+            if (pid == 0)
+            {
+                ::close(fds[0]);
+                auto t0 = std::chrono::steady_clock::now();
+                PathResult r = run(path);
+                r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                bool ok = ::write(fds[1], &r, sizeof(r)) == ssize_t(sizeof(r));
+                ::_exit(ok ? 0 : 1);
+            }
+
+            ::close(fds[1]);
+            bool ok = ::read(fds[0], &out, sizeof(out)) == ssize_t(sizeof(out));
+            ::close(fds[0]);
+
+            int status = 0;
+            struct rusage ru;
+            if (::wait4(pid, &status, 0, &ru) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                return false;
+            peakRssKB = uint64(ru.ru_maxrss);
+            return ok;
+        }
+#endif
+    }
+
+    int RunSqlCompare(std::string_view arg)
+    {
+#ifdef _WIN32
+        (void)arg;
+        std::fprintf(stderr, "--sql-compare needs fork/wait4 (POSIX only)\n");
+        return 2;
+#else
+        // číslo = vygenerovat soubor o tolika MB, jinak cesta k existujícímu .sql
+        std::string path;
+        bool generated = false;
+        uint32 mb = 0;
+        if (ParseU32(arg, mb))
+        {
+            if (mb == 0)
+                return 2;
+            path = (fs::temp_directory_path() / ("real_online_sql_compare_" + std::to_string(mb) + "mb.sql")).string();
+            if (!WriteCompareFile(path, uint64(mb) * 1024 * 1024))
+            {
+                std::fprintf(stderr, "cannot write %s\n", path.c_str());
+                return 1;
+            }
+            generated = true;
+        }
+        else
+            path = std::string(arg);
+
+        std::error_code ec;
+        uint64 size = fs::file_size(path, ec);
+        if (ec)
+        {
+            std::fprintf(stderr, "cannot stat %s\n", path.c_str());
+            return 1;
+        }
+
+        struct Variant
+        {
+            char const* name;
+            PathResult (*run)(std::string const&);
+        };
+
+        std::vector<PathResult> results;
+        int rc = 0;
+        for (Variant const& v : { Variant{ "legacy", &RunLegacy }, Variant{ "mmap", &RunMapped } })
+        {
+            PathResult r;
+            uint64 rssKB = 0;
+            if (!RunInChild(v.run, path, r, rssKB))
+            {
+                std::fprintf(stderr, "%s: child failed (out of memory?)\n", v.name);
+                rc = 1;
+                continue;
+            }
+
+            double fileMB = double(size) / (1024.0 * 1024.0);
+            std::printf("{\"sql_compare\":\"%s\",\"file_mb\":%.1f,\"statements\":%llu,\"seconds\":%.3f,\"mb_per_s\":%.1f,\"peak_rss_mb\":%.1f}\n",
+                v.name, fileMB, (unsigned long long)r.statements, r.seconds,
+                r.seconds > 0 ? fileMB / r.seconds : 0.0, double(rssKB) / 1024.0);
+            std::fflush(stdout);
+            results.push_back(r);
+        }
+
+        // obě cesty musí dát stejné statementy (na vygenerovaném vstupu)
+        if (generated && results.size() == 2 && results[0].statements != results[1].statements)
+        {
+            std::fprintf(stderr, "statement count differs: legacy %llu, mmap %llu\n",
+                (unsigned long long)results[0].statements, (unsigned long long)results[1].statements);
+            rc = 1;
+        }
+
+        if (generated)
+            fs::remove(path, ec);
+        return rc;
+#endif
+    }
+}
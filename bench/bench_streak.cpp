@@ -0,0 +1,51 @@
+// modules/mod-real-online/bench/bench_streak.cpp
+
+#include "bench.h"
+#include "streak_logic.h"
+
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace RealOnline::Bench
+{
+    void RegisterStreakBenchCases()
+    {
+        RegisterBenchCase("streak.today_serial", []
+        {
+            auto now = std::make_shared<time_t>(std::time(nullptr));
+            return BenchRun{ [now]{ return uint64(StreakDaySerial(++*now, 4)); } };
+        });
+
+        // posun 10k sérií o den (mix navazujících, přerušených a nových),
+        // výchozí config: cyklus 28 dní, bonusy 7/14/21/28, reset při vynechání
+        RegisterBenchCase("streak.advance_10k", []
+        {
+            auto states = std::make_shared<std::vector<StreakState>>(10000);
+            for (size_t i = 0; i < states->size(); ++i)
+            {
+                StreakState& st = (*states)[i];
+                st.exists    = i % 10 != 0;
+                st.streakDay = uint32(i % 28) + 1;
+            }
+            auto byDay = std::make_shared<std::vector<SpecialReward>>(29);
+            for (uint32 day : { 7u, 14u, 21u, 28u })
+                (*byDay)[day] = { day == 28 ? 37711u : 0u, 1 };
+            auto today = std::make_shared<uint32>(20000);
+            return BenchRun{ [states, byDay, today]
+            {
+                uint32 day = ++*today;
+                uint64 sum = 0;
+                for (size_t i = 0; i < states->size(); ++i)
+                {
+                    StreakState& st = (*states)[i];
+                    if (i % 13 == 0)
+                        st.lastSerial = day - 3; // vynechané dny
+                    if (AdvanceStreak(st, day, 28, true))
+                        sum += ResolveStreakGrant(1, *byDay, st.streakDay).totalCount;
+                }
+                return sum;
+            } };
+        });
+    }
+}
@@ -0,0 +1,86 @@
+// modules/mod-real-online/bench/legacy_sql_split.cpp
+
+#include "legacy_sql_split.h"
+#include "text_parse.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+// Těla beze změny oproti původnímu autoupdate.cpp (jen namespace).
+namespace RealOnline::Bench::Legacy
+{
+    std::string StripSqlComments(std::string const& in)
+    {
+        std::string out; out.reserve(in.size());
+        bool inS=false, inD=false, inB=false; // ' " `
+        for (size_t i=0; i<in.size(); )
+        {
+            char c=in[i], n = (i+1<in.size()? in[i+1] : '\0');
+
+            if (!inD && !inB && c=='\''){ inS=!inS; out.push_back(c); ++i; continue; }
+            if (!inS && !inB && c=='"'){  inD=!inD; out.push_back(c); ++i; continue; }
+            if (!inS && !inD && c=='`'){  inB=!inB; out.push_back(c); ++i; continue; }
+
+            if (!inS && !inD && !inB)
+            {
+                if (c=='-' && n=='-'){ i+=2; while (i<in.size() && in[i]!='\n') ++i; continue; }
+                if (c=='#'){ ++i; while (i<in.size() && in[i]!='\n') ++i; continue; }
+                if (c=='/' && n=='*'){
+                    i+=2;
+                    while (i+1<in.size() && !(in[i]=='*' && in[i+1]=='/')) ++i;
+                    if (i+1<in.size()) i+=2;
+                    continue;
+                }
+            }
+
+            out.push_back(c); ++i;
+        }
+        return out;
+    }
+
+    std::vector<std::string> SplitSqlStatements(std::string const& src)
+    {
+        std::vector<std::string> out;
+        std::string cur; cur.reserve(src.size());
+        bool inS=false, inD=false, inB=false;
+
+        auto isIgnore = [](std::string s){
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char ch){ return std::toupper(ch); });
+            return s.rfind("USE ",0)==0 || s.rfind("DELIMITER ",0)==0 || s=="SELECT 1";
+        };
+
+        for (size_t i=0;i<src.size();++i)
+        {
+            char c=src[i];
+            if (c=='\'' && !inD && !inB){ inS=!inS; cur.push_back(c); continue; }
+            if (c=='"'  && !inS && !inB){ inD=!inD; cur.push_back(c); continue; }
+            if (c=='`'  && !inS && !inD){ inB=!inB; cur.push_back(c); continue; }
+
+            if (c==';' && !inS && !inD && !inB)
+            {
+                std::string stmt = Trim(cur); cur.clear();
+                if (!stmt.empty() && !isIgnore(stmt)) out.emplace_back(std::move(stmt));
+                continue;
+            }
+            cur.push_back(c);
+        }
+        std::string tail = Trim(cur);
+        if (!tail.empty())
+        {
+            auto up = tail; std::transform(up.begin(), up.end(), up.begin(), [](unsigned char ch){ return std::toupper(ch); });
+            if (!(up.rfind("USE ",0)==0 || up.rfind("DELIMITER ",0)==0 || up=="SELECT 1"))
+                out.emplace_back(std::move(tail));
+        }
+        return out;
+    }
+
+    std::string ReadFile(std::string const& path)
+    {
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in) return {};
+        std::ostringstream ss; ss << in.rdbuf();
+        return ss.str();
+    }
+}
@@ -0,0 +1,23 @@
+// modules/mod-real-online/bench/legacy_sql_split.h
+
+#ifndef MOD_REAL_ONLINE_LEGACY_SQL_SPLIT_H
+#define MOD_REAL_ONLINE_LEGACY_SQL_SPLIT_H
+
+#include <string>
+#include <vector>
+
+// =============================
+// Původní dělení SQL souborů (před mmap tokenizerem)
+// =============================
+// Kopie ReadFile / StripSqlComments / SplitSqlStatements z autoupdate.cpp
+// v podobě před přechodem na SqlStatementReader – jen pro srovnání v
+// benchmarku. Soubor se celý načte, očistí od komentářů (druhá kopie) a
+// rozdělí na statementy (třetí kopie). Nezná \ escape ani DELIMITER.
+namespace RealOnline::Bench::Legacy
+{
+    std::string ReadFile(std::string const& path);
+    std::string StripSqlComments(std::string const& in);
+    std::vector<std::string> SplitSqlStatements(std::string const& src);
+}
+
+#endif // MOD_REAL_ONLINE_LEGACY_SQL_SPLIT_H
@@ -0,0 +1,37 @@
+-- počty postav na (účet, milník) – limit "prvních 10 postav" je pak jeden PK lookup
+CREATE TABLE IF NOT EXISTS `customs`.`level_milestone_counts` (
+  `account`   INT UNSIGNED NOT NULL,
+  `milestone` TINYINT UNSIGNED NOT NULL,
+  `cnt`       SMALLINT UNSIGNED NOT NULL DEFAULT 0,
+  PRIMARY KEY (`account`, `milestone`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+-- backfill z existujících záznamů
+INSERT INTO `customs`.`level_milestone_counts` (`account`, `milestone`, `cnt`)
+SELECT `account`, `milestone`, COUNT(*)
+FROM `customs`.`level_milestones`
+GROUP BY `account`, `milestone`
+ON DUPLICATE KEY UPDATE `cnt` = VALUES(`cnt`);
+
+-- idx_acc_mil je prefix primárního klíče. DROP INDEX jen když index existuje,
+-- aby šel soubor pustit znovu (změna sha1, ruční re-run). Podmíněný prepared
+-- statement běží uvnitř procedury: updater posílá statementy přes pool a
+-- @proměnné ani PREPARE mezi dvěma DirectExecute nemusí zůstat na stejném spojení.
+DROP PROCEDURE IF EXISTS `customs`.`gv_drop_idx_acc_mil`;
+DELIMITER $$
+CREATE PROCEDURE `customs`.`gv_drop_idx_acc_mil`()
+BEGIN
+  SET @gv_sql := IF(
+    EXISTS (SELECT 1 FROM `information_schema`.`STATISTICS`
+            WHERE `TABLE_SCHEMA` = 'customs'
+              AND `TABLE_NAME`   = 'level_milestones'
+              AND `INDEX_NAME`   = 'idx_acc_mil'),
+    'ALTER TABLE `customs`.`level_milestones` DROP INDEX `idx_acc_mil`',
+    'DO 0');
+  PREPARE gv_stmt FROM @gv_sql;
+  EXECUTE gv_stmt;
+  DEALLOCATE PREPARE gv_stmt;
+END$$
+DELIMITER ;
+CALL `customs`.`gv_drop_idx_acc_mil`();
+DROP PROCEDURE `customs`.`gv_drop_idx_acc_mil`;
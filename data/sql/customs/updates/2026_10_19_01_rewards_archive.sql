@@ -0,0 +1,11 @@
+-- archiv vyrovnaných a dlouho neaktivních řádků customs.rewards
+-- (entitled = claimed, stored = 0); čtení sčítá live + archiv
+CREATE TABLE IF NOT EXISTS `customs`.`rewards_archive` (
+  `account`     INT UNSIGNED NOT NULL,
+  `item`        INT UNSIGNED NOT NULL,
+  `entitled`    INT UNSIGNED NOT NULL DEFAULT 0,
+  `claimed`     INT UNSIGNED NOT NULL DEFAULT 0,
+  `updated_at`  TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+  `archived_at` TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+  PRIMARY KEY (`account`, `item`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
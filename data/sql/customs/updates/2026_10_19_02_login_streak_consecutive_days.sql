@@ -0,0 +1,20 @@
+-- skutečný počet dní v řadě pro .streak top; streak_day je jen den cyklu
+-- odměn a po Token.Streak.CycleLength přetéká zpět na 1
+DROP PROCEDURE IF EXISTS `customs`.`gv_add_consecutive_days`;
+DELIMITER $$
+CREATE PROCEDURE `customs`.`gv_add_consecutive_days`()
+BEGIN
+  IF NOT EXISTS (SELECT 1 FROM `information_schema`.`COLUMNS`
+                 WHERE `TABLE_SCHEMA` = 'customs'
+                   AND `TABLE_NAME`   = 'login_streak'
+                   AND `COLUMN_NAME`  = 'consecutive_days') THEN
+    ALTER TABLE `customs`.`login_streak`
+      ADD COLUMN `consecutive_days` INT UNSIGNED NOT NULL DEFAULT 0 AFTER `streak_day`;
+    -- backfill jen při přidání sloupce: série delší než cyklus už se
+    -- nedají zjistit, začínají na dni cyklu
+    UPDATE `customs`.`login_streak` SET `consecutive_days` = `streak_day`;
+  END IF;
+END$$
+DELIMITER ;
+CALL `customs`.`gv_add_consecutive_days`();
+DROP PROCEDURE `customs`.`gv_add_consecutive_days`;
@@ -0,0 +1,93 @@
+// modules/mod-real-online/src/activity.cpp
+
+#include "activity.h"
+#include "replay.h"
+
+#include "ScriptMgr.h"
+#include "Player.h"
+#include "WorldSession.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        // 1 << 24 účtů = 64 MB; vyšší ID se nesledují (vždy aktivní)
+        constexpr uint32 MaxTrackedAccountId = 1u << 24;
+
+        std::vector<uint32> sLastActive; // index = ID účtu, 0 = nesledováno
+
+        uint32 NowSeconds() { return uint32(Now()); }
+
+        void Track(uint32 account)
+        {
+            if (account >= MaxTrackedAccountId)
+                return;
+            if (account >= sLastActive.size())
+                sLastActive.resize(std::max<size_t>(account + 1, sLastActive.size() * 2));
+            sLastActive[account] = NowSeconds();
+        }
+    }
+
+    bool IsActiveSince(uint32 account, uint32 since)
+    {
+        if (account >= sLastActive.size() || !sLastActive[account])
+            return true;
+        return sLastActive[account] >= since;
+    }
+
+    void NoteActivity(uint32 account)
+    {
+        if (account < sLastActive.size())
+            sLastActive[account] = NowSeconds();
+    }
+}
+
+static inline void NotePlayerActivity(Player* player)
+{
+    if (player)
+        if (WorldSession* session = player->GetSession())
+            RealOnline::NoteActivity(session->GetAccountId());
+}
+
+class RealOnlineActivityPS : public PlayerScript
+{
+public:
+    RealOnlineActivityPS() : PlayerScript("RealOnlineActivityPS") {}
+
+    // jediné místo, kde pole roste (world thread)
+    void OnPlayerLogin(Player* player) override
+    {
+        if (player && player->GetSession())
+            RealOnline::Track(player->GetSession()->GetAccountId());
+    }
+
+    void OnPlayerSpellCast(Player* player, Spell* /*spell*/, bool /*skipCheck*/) override
+    {
+        NotePlayerActivity(player);
+    }
+
+    void OnPlayerChat(Player* player, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) override
+    {
+        NotePlayerActivity(player);
+    }
+};
+
+class RealOnlineActivityMovement : public MovementHandlerScript
+{
+public:
+    RealOnlineActivityMovement() : MovementHandlerScript("RealOnlineActivityMovement") {}
+
+    void OnPlayerMove(Player* player, MovementInfo /*movementInfo*/, uint32 /*opcode*/) override
+    {
+        NotePlayerActivity(player);
+    }
+};
+
+void AddRealOnlineActivityScripts()
+{
+    new RealOnlineActivityPS();
+    new RealOnlineActivityMovement();
+}
@@ -0,0 +1,24 @@
+// modules/mod-real-online/src/activity.h
+
+#ifndef MOD_REAL_ONLINE_ACTIVITY_H
+#define MOD_REAL_ONLINE_ACTIVITY_H
+
+#include "Define.h"
+
+// =============================
+// Poslední aktivita účtu (AFK filtr playtime odměn)
+// =============================
+// Pohyb, cast a chat zapíšou čas (RealOnline::Now(), sekundy) do hustého
+// pole indexovaného ID účtu – jeden store na událost, bez hledání. Login
+// se počítá jako aktivita. Pole roste jen při loginu (world thread, mimo
+// update map); hooky z map threadů zapisují každý jen prvek svého hráče.
+namespace RealOnline
+{
+    // true = účet byl aktivní v čase >= since; účty mimo pole (simulace,
+    // ID nad limitem) se berou jako aktivní
+    bool IsActiveSince(uint32 account, uint32 since);
+
+    void NoteActivity(uint32 account);
+}
+
+#endif // MOD_REAL_ONLINE_ACTIVITY_H
@@ -1,5 +1,8 @@
 // modules/mod-real-online/src/autoupdate.cpp
 
+#include "autoupdate.h"
+#include "sql_reader.h"
+
 #include "ScriptMgr.h"
 #include "DatabaseEnv.h"
 #include "Config.h"
@@ -7,107 +10,96 @@
 #include "CryptoHash.h"
 #include "Util.h"
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include <unordered_map>
 #include <algorithm>
-#include <cctype>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <thread>
 
 namespace fs = std::filesystem;
 using Acore::Crypto::SHA1;
+using RealOnline::MappedSqlFile;
+using RealOnline::SqlStatementReader;
+using RealOnline::StatementBatcher;
+using RealOnline::IsDdl;
+using RealOnline::PeakRssKB;
 
-// ---------- helpers ----------
-static inline std::string Trim(std::string s)
+static std::string DigestHex(SHA1::Digest const& d)
 {
-    auto notspace = [](int ch){ return !std::isspace(ch); };
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), notspace));
-    s.erase(std::find_if(s.rbegin(), s.rend(), notspace).base(), s.end());
-    return s;
+    static char const* hex="0123456789abcdef";
+    std::string out; out.reserve(d.size()*2);
+    for (uint8_t b : d){ out.push_back(hex[(b>>4)&0xF]); out.push_back(hex[b&0xF]); }
+    return out;
 }
 
-static std::string StripSqlComments(std::string const& in)
+// SHA1 po 64KB blocích, bez načtení celého souboru
+static std::string Sha1FileHex(std::string const& path)
 {
-    std::string out; out.reserve(in.size());
-    bool inS=false, inD=false, inB=false; // ' " `
-    for (size_t i=0; i<in.size(); )
-    {
-        char c=in[i], n = (i+1<in.size()? in[i+1] : '\0');
-
-        if (!inD && !inB && c=='\''){ inS=!inS; out.push_back(c); ++i; continue; }
-        if (!inS && !inB && c=='"'){  inD=!inD; out.push_back(c); ++i; continue; }
-        if (!inS && !inD && c=='`'){  inB=!inB; out.push_back(c); ++i; continue; }
-
-        if (!inS && !inD && !inB)
-        {
-            if (c=='-' && n=='-'){ i+=2; while (i<in.size() && in[i]!='\n') ++i; continue; }
-            if (c=='#'){ ++i; while (i<in.size() && in[i]!='\n') ++i; continue; }
-            if (c=='/' && n=='*'){
-                i+=2;
-                while (i+1<in.size() && !(in[i]=='*' && in[i+1]=='/')) ++i;
-                if (i+1<in.size()) i+=2;
-                continue;
-            }
-        }
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in) return {};
 
-        out.push_back(c); ++i;
+    SHA1 sha;
+    std::array<char, 64 * 1024> buf;
+    while (in)
+    {
+        in.read(buf.data(), buf.size());
+        std::streamsize n = in.gcount();
+        if (n > 0) sha.UpdateData(reinterpret_cast<uint8 const*>(buf.data()), size_t(n));
     }
-    return out;
+    sha.Finalize();
+    return DigestHex(sha.GetDigest());
 }
 
-static std::vector<std::string> SplitSqlStatements(std::string const& src)
+// ---------- manifest (cesta -> size, mtime, sha1) ----------
+// Lokální cache: soubor se stejnou velikostí a mtime se znovu nečte ani nehashuje.
+struct ManifestEntry
 {
-    std::vector<std::string> out;
-    std::string cur; cur.reserve(src.size());
-    bool inS=false, inD=false, inB=false;
-
-    auto isIgnore = [](std::string s){
-        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char ch){ return std::toupper(ch); });
-        return s.rfind("USE ",0)==0 || s.rfind("DELIMITER ",0)==0 || s=="SELECT 1";
-    };
-
-    for (size_t i=0;i<src.size();++i)
-    {
-        char c=src[i];
-        if (c=='\'' && !inD && !inB){ inS=!inS; cur.push_back(c); continue; }
-        if (c=='"'  && !inS && !inB){ inD=!inD; cur.push_back(c); continue; }
-        if (c=='`'  && !inS && !inD){ inB=!inB; cur.push_back(c); continue; }
+    uint64      size  = 0;
+    int64       mtime = 0;
+    std::string sha1;
+};
+using Manifest = std::unordered_map<std::string, ManifestEntry>;
 
-        if (c==';' && !inS && !inD && !inB)
-        {
-            std::string stmt = Trim(cur); cur.clear();
-            if (!stmt.empty() && !isIgnore(stmt)) out.emplace_back(std::move(stmt));
-            continue;
-        }
-        cur.push_back(c);
-    }
-    std::string tail = Trim(cur);
-    if (!tail.empty())
+static Manifest LoadManifest(fs::path const& file)
+{
+    Manifest m;
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line))
     {
-        auto up = tail; std::transform(up.begin(), up.end(), up.begin(), [](unsigned char ch){ return std::toupper(ch); });
-        if (!(up.rfind("USE ",0)==0 || up.rfind("DELIMITER ",0)==0 || up=="SELECT 1"))
-            out.emplace_back(std::move(tail));
+        // key \t size \t mtime \t sha1
+        std::istringstream ls(line);
+        std::string key; ManifestEntry e;
+        if (std::getline(ls, key, '\t') && (ls >> e.size >> e.mtime >> e.sha1) && e.sha1.size() == 40)
+            m[key] = std::move(e);
     }
-    return out;
+    return m;
 }
 
-static std::string ReadFile(std::string const& path)
+static void SaveManifest(fs::path const& file, Manifest const& m)
 {
-    std::ifstream in(path, std::ios::in | std::ios::binary);
-    if (!in) return {};
-    std::ostringstream ss; ss << in.rdbuf();
-    return ss.str();
-}
-
-static std::string Sha1Hex(std::string const& data)
-{
-    auto const d = SHA1::GetDigestOf(data);
-    static char const* hex="0123456789abcdef";
-    std::string out; out.reserve(d.size()*2);
-    for (uint8_t b : d){ out.push_back(hex[(b>>4)&0xF]); out.push_back(hex[b&0xF]); }
-    return out;
+    fs::path tmp = file; tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::out | std::ios::trunc);
+        if (!out)
+        {
+            LOG_WARN("gv.customs", "[customs] Cannot write manifest: {}", tmp.string());
+            return;
+        }
+        for (auto const& [key, e] : m)
+            out << key << '\t' << e.size << '\t' << e.mtime << '\t' << e.sha1 << '\n';
+    }
+    std::error_code ec;
+    fs::rename(tmp, file, ec);
+    if (ec) LOG_WARN("gv.customs", "[customs] Cannot replace manifest {}: {}", file.string(), ec.message());
 }
 
 // Název modulu detekovaný z cesty
@@ -119,14 +111,14 @@ static std::string DetectModuleName()
 }
 
 // --- tracking tabulka ---
-static void EnsureTrackingTable()
+// Každá cílová DB má gv_updates dosažitelnou přes své spojení: world a customs
+// sdílí `customs`.`gv_updates`, characters má vlastní `gv_updates` (může být
+// na jiném serveru). Díky tomu jde zápis o souboru do stejné transakce.
+template<class Pool>
+static void EnsureTrackingTable(Pool& db, std::string const& table)
 {
-    WorldDatabase.DirectExecute(
-        "CREATE DATABASE IF NOT EXISTS `customs` "
-        "DEFAULT CHARACTER SET utf8mb4 COLLATE utf8mb4_unicode_ci");
-
-    WorldDatabase.DirectExecute(
-        "CREATE TABLE IF NOT EXISTS `customs`.`gv_updates` ("
+    db.DirectExecute(
+        "CREATE TABLE IF NOT EXISTS {} ("
         "  `id` BIGINT UNSIGNED NOT NULL AUTO_INCREMENT,"
         "  `module` VARCHAR(64) NOT NULL,"
         "  `filename` VARCHAR(255) NOT NULL,"
@@ -134,41 +126,101 @@ static void EnsureTrackingTable()
         "  `applied_at` TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,"
         "  PRIMARY KEY (`id`),"
         "  UNIQUE KEY `uq_module_file` (`module`,`filename`)"
-        ") ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;"
+        ") ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;", table
     );
 }
 
-static std::unordered_set<std::string> LoadApplied(std::string const& moduleName)
+// filename -> sha1 zapsané při aplikaci
+template<class Pool>
+static std::unordered_map<std::string, std::string> LoadApplied(Pool& db, std::string const& table, std::string const& moduleName)
 {
-    std::unordered_set<std::string> seen;
-    if (QueryResult r = WorldDatabase.Query(
-            "SELECT `filename` FROM `customs`.`gv_updates` WHERE `module` = '{}'", moduleName))
-        do { seen.insert(r->Fetch()[0].Get<std::string>()); } while (r->NextRow());
+    std::unordered_map<std::string, std::string> seen;
+    if (QueryResult r = db.Query(
+            "SELECT `filename`, `sha1` FROM {} WHERE `module` = '{}'", table, moduleName))
+        do { Field* f = r->Fetch(); seen[f[0].Get<std::string>()] = f[1].Get<std::string>(); } while (r->NextRow());
     return seen;
 }
 
-static void MarkApplied(std::string const& moduleName, std::string const& filename, std::string const& sha1)
+template<class Pool>
+static void MarkApplied(Pool& db, std::string const& table, std::string const& moduleName, std::string const& filename, std::string const& sha1)
 {
-    WorldDatabase.DirectExecute(
-        "INSERT INTO `customs`.`gv_updates` (`module`,`filename`,`sha1`) "
+    db.DirectExecute(
+        "INSERT INTO {} (`module`,`filename`,`sha1`) "
+        "VALUES ('{}','{}','{}') "
+        "ON DUPLICATE KEY UPDATE `sha1`=VALUES(`sha1`), `applied_at`=CURRENT_TIMESTAMP",
+        table, moduleName, filename, sha1
+    );
+}
+
+// stejný zápis jako MarkApplied, ale uvnitř transakce souboru
+template<class Trans>
+static void MarkAppliedIn(Trans& trans, std::string const& table, std::string const& moduleName, std::string const& filename, std::string const& sha1)
+{
+    trans->Append(
+        "INSERT INTO {} (`module`,`filename`,`sha1`) "
         "VALUES ('{}','{}','{}') "
         "ON DUPLICATE KEY UPDATE `sha1`=VALUES(`sha1`), `applied_at`=CURRENT_TIMESTAMP",
-        moduleName, filename, sha1
+        table, moduleName, filename, sha1
     );
 }
 
+// commit transakce nevrací výsledek -> ověří se podle řádku v gv_updates
+template<class Pool>
+static bool IsAppliedWithSha(Pool& db, std::string const& table, std::string const& moduleName, std::string const& filename, std::string const& sha1)
+{
+    return db.Query(
+        "SELECT 1 FROM {} WHERE `module` = '{}' AND `filename` = '{}' AND `sha1` = '{}'",
+        table, moduleName, filename, sha1) != nullptr;
+}
+
+template<class Pool>
+static void ClearMark(Pool& db, std::string const& table, std::string const& moduleName, std::string const& filename)
+{
+    db.DirectExecute("DELETE FROM {} WHERE `module` = '{}' AND `filename` = '{}'", table, moduleName, filename);
+}
+
 // ---------- early bootstrap ----------
-static void EnsureBootstrapEarly()
+static void EnsureCustomsDatabase()
 {
     WorldDatabase.DirectExecute(
         "CREATE DATABASE IF NOT EXISTS `customs` "
         "DEFAULT CHARACTER SET utf8mb4 COLLATE utf8mb4_unicode_ci");
-
-    EnsureTrackingTable();
 }
 
+// ---------- cílové databáze ----------
+// data/sql/<dir>/{base,updates_include,updates}; klíč v gv_updates má prefix
+// cíle (customs bez prefixu – klíče z dřívějších verzí zůstávají platné).
+enum class SqlTarget : uint8
+{
+    Customs,
+    World,
+    Characters,
+    Count
+};
+
+struct SqlTargetInfo
+{
+    char const* dir;
+    char const* keyPrefix;
+    char const* tracking;
+};
+
+static constexpr std::array<SqlTargetInfo, size_t(SqlTarget::Count)> SqlTargets =
+{{
+    { "customs",    "",            "`customs`.`gv_updates`" },
+    { "world",      "world/",      "`customs`.`gv_updates`" },
+    { "characters", "characters/", "`gv_updates`"           },
+}};
+
 // ---------- file collect ----------
-static void CollectSqlFiles(std::string const& root, std::vector<std::string>& out)
+struct SqlFile
+{
+    std::string path;
+    uint64      size  = 0;
+    int64       mtime = 0;
+};
+
+static void CollectSqlFiles(std::string const& root, std::vector<SqlFile>& out)
 {
     std::error_code ec;
     if (!fs::exists(root, ec))
@@ -181,48 +233,163 @@ static void CollectSqlFiles(std::string const& root, std::vector<std::string>& o
         if (ec) break;
         if (!de.is_regular_file()) continue;
         auto p = de.path();
-        if (p.has_extension() && ::StringEqualI(p.extension().string(), ".sql"))
-            out.emplace_back(p.string());
+        if (!p.has_extension() || !::StringEqualI(p.extension().string(), ".sql"))
+            continue;
+
+        // velikost + mtime z directory entry (jediný stat na soubor)
+        SqlFile f;
+        f.path  = p.string();
+        f.size  = de.file_size(ec);
+        if (ec) { ec.clear(); continue; }
+        f.mtime = de.last_write_time(ec).time_since_epoch().count();
+        if (ec) { ec.clear(); continue; }
+        out.push_back(std::move(f));
     }
-    std::sort(out.begin(), out.end());
+    std::sort(out.begin(), out.end(), [](SqlFile const& a, SqlFile const& b){ return a.path < b.path; });
 }
 
 // ---------- executor ----------
-static bool ExecuteSqlFile(std::string const& moduleName, std::string const& filePath, std::string const& filenameKey)
+struct ExecLimits
 {
-    std::string raw = ReadFile(filePath);
-    std::string sha = Sha1Hex(raw);
+    size_t maxPacketBytes = 1024 * 1024;       // sloučený INSERT nejvýš takhle velký
+    size_t maxTransBytes  = 16 * 1024 * 1024;  // větší soubor jde bez transakce (transakce drží statementy v paměti)
+};
 
-    if (raw.empty())
+// Soubor bez DDL: jedna transakce včetně zápisu do gv_updates (vše nebo nic).
+// Soubor s DDL: statement po statementu, gv_updates až na konci.
+template<class Pool>
+static bool ExecuteSqlFile(Pool& db, std::string const& table, std::string const& moduleName, std::string const& filePath,
+                           std::string const& filenameKey, std::string const& sha, ExecLimits const& limits)
+{
+    MappedSqlFile file(filePath);
+    if (!file.IsOpen())
+    {
+        LOG_ERROR("gv.customs", "[customs] Cannot open {} – skipped, will retry next start.", filenameKey);
+        return false;
+    }
+
+    if (file.Size() == 0)
     {
         LOG_WARN("gv.customs", "[customs] Empty file -> mark applied: {} (sha1={})", filenameKey, sha);
-        MarkApplied(moduleName, filenameKey, sha);
+        MarkApplied(db, table, moduleName, filenameKey, sha);
         return true;
     }
 
-    if (raw.size() >= 3 && (unsigned char)raw[0] == 0xEF && (unsigned char)raw[1] == 0xBB && (unsigned char)raw[2] == 0xBF)
-        raw.erase(0,3);
-
-    std::string cleaned = StripSqlComments(raw);
-    auto stmts = SplitSqlStatements(cleaned);
+    // 1. průchod jen klasifikuje (mapovaný soubor, bez kopií)
+    std::string_view s;
+    uint32 total = 0;
+    bool hasDdl  = false;
+    {
+        SqlStatementReader scan(file.View());
+        while (scan.Next(s))
+        {
+            ++total;
+            hasDdl = hasDdl || IsDdl(s);
+            file.ReleaseBehind(scan.Offset());
+        }
+        file.Rewind();
+    }
 
-    if (stmts.empty())
+    if (total == 0)
     {
         LOG_INFO("gv.customs", "[customs] {}: nothing to execute after stripping comments (mark applied).", filenameKey);
-        MarkApplied(moduleName, filenameKey, sha);
+        MarkApplied(db, table, moduleName, filenameKey, sha);
         return true;
     }
 
-    LOG_INFO("gv.customs", "[customs] Executing {} statement(s) from {}", stmts.size(), filenameKey);
-    for (auto const& s : stmts)
+    // Soubor nad MaxTransactionBytes se nedělí na víc commitů: při chybě
+    // pozdější části by dřívější zůstaly zapsané a další start by soubor
+    // pouštěl znovu přes ně. Jde statement po statementu jako soubor s DDL.
+    bool const oversized     = file.Size() > limits.maxTransBytes;
+    bool const transactional = !hasDdl && !oversized;
+    if (oversized && !hasDdl)
+        LOG_WARN("gv.customs", "[customs] {} ({} bytes) exceeds RealOnline.Updater.MaxTransactionBytes ({}) – applied WITHOUT a transaction. "
+            "A failure leaves it partially applied; make the file re-runnable (IF NOT EXISTS / ON DUPLICATE KEY) or raise the limit.",
+            filenameKey, file.Size(), limits.maxTransBytes);
+    LOG_INFO("gv.customs", "[customs] Executing {} statement(s) from {} ({} bytes, {})", total, filenameKey, file.Size(),
+        transactional ? "one transaction" : hasDdl ? "contains DDL – not atomic" : "too large for one transaction – not atomic");
+
+    auto const started = std::chrono::steady_clock::now();
+
+    decltype(db.BeginTransaction()) trans;
+    if (transactional)
+        trans = db.BeginTransaction();
+
+    // Bez transakce: DirectExecute výsledek nevrací, takže každý příkaz jde
+    // ve vlastní transakci se značkou průběhu (<soubor>#progress, sha1 = pořadí
+    // příkazu). Značka se zapíše jen po úspěchu příkazu (DDL commitne sám);
+    // chybějící značka = chyba, zbytek souboru se nepouští.
+    std::string const progressKey = filenameKey + "#progress";
+    uint32 step  = 0;
+    bool failed  = false;
+
+    StatementBatcher batcher(limits.maxPacketBytes, [&](std::string_view stmt)
     {
-        std::string prev = s.substr(0, std::min<size_t>(160, s.size()));
-        WorldDatabase.DirectExecute(s);
-        LOG_DEBUG("gv.customs", "[customs] exec: {}{}", prev.c_str(), s.size()>160?" ...":"");
+        if (failed)
+            return;
+
+        LOG_DEBUG("gv.customs", "[customs] exec: {}{}", stmt.substr(0, 160), stmt.size()>160?" ...":"");
+        if (transactional)
+        {
+            trans->Append(stmt);
+            return;
+        }
+
+        std::string const mark = std::to_string(++step);
+        auto stepTrans = db.BeginTransaction();
+        stepTrans->Append(stmt);
+        MarkAppliedIn(stepTrans, table, moduleName, progressKey, mark);
+        db.DirectCommitTransaction(stepTrans);
+
+        if (!IsAppliedWithSha(db, table, moduleName, progressKey, mark))
+        {
+            failed = true;
+            LOG_ERROR("gv.customs", "[customs] {}: statement #{} failed, the rest of the file is skipped: {}{}",
+                filenameKey, step, stmt.substr(0, 160), stmt.size()>160?" ...":"");
+        }
+    });
+
+    SqlStatementReader reader(file.View());
+    while (!failed && reader.Next(s))
+    {
+        batcher.Add(s);
+        file.ReleaseBehind(reader.Offset());
+    }
+    batcher.Flush();
+
+    if (transactional)
+    {
+        MarkAppliedIn(trans, table, moduleName, filenameKey, sha);
+        db.DirectCommitTransaction(trans);
+
+        if (!IsAppliedWithSha(db, table, moduleName, filenameKey, sha))
+        {
+            LOG_ERROR("gv.customs", "[customs] {} failed and was rolled back – not marked as applied, will retry next start.", filenameKey);
+            return false;
+        }
     }
+    else
+    {
+        ClearMark(db, table, moduleName, progressKey);
+        if (failed)
+        {
+            LOG_ERROR("gv.customs", "[customs] {} is partially applied – not marked as applied, will retry next start. "
+                "Fix the failing statement and make the file re-runnable.", filenameKey);
+            return false;
+        }
 
-    MarkApplied(moduleName, filenameKey, sha);
-    LOG_INFO("gv.customs", "[customs] Applied: {}", filenameKey);
+        MarkApplied(db, table, moduleName, filenameKey, sha);
+        if (!IsAppliedWithSha(db, table, moduleName, filenameKey, sha))
+        {
+            LOG_ERROR("gv.customs", "[customs] {} was applied but could not be marked in {}.", filenameKey, table);
+            return false;
+        }
+    }
+
+    uint64 ms = uint64(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count());
+    double mbps = ms ? (double(file.Size()) / (1024.0 * 1024.0)) / (double(ms) / 1000.0) : 0.0;
+    LOG_INFO("gv.customs", "[customs] Applied: {} ({} statement(s) in {} round trip(s), {} ms, {:.1f} MB/s, peak RSS {} KB)",
+        filenameKey, batcher.Statements(), batcher.RoundTrips(), ms, mbps, PeakRssKB());
     return true;
 }
 
@@ -234,14 +401,59 @@ static std::string RelKey(std::string const& root, std::string const& full)
     return fs::path(full).filename().string();
 }
 
-static void RunPass(char const* label, fs::path const& dir, std::string const& moduleName, std::unordered_set<std::string>& applied, uint32& nApplied)
+struct UpdaterRun
+{
+    std::string moduleName;
+    std::string tracking;   // gv_updates cílové DB
+    std::string keyPrefix;
+    std::unordered_map<std::string, std::string> applied; // filename -> sha1
+    Manifest const* manifest = nullptr; // z minulého startu, sdílený (jen čtení)
+    Manifest nextManifest;  // jen soubory, které pořád existují
+    ExecLimits limits;
+    bool   reapplyChanged = false;
+    uint32 nApplied = 0, nHashed = 0, nChanged = 0, nFiles = 0;
+    int64  ms = 0;
+};
+
+// jeden průchod: stat -> (hash jen při změně) -> porovnání s gv_updates -> apply
+template<class Pool>
+static void RunPass(Pool& db, char const* label, fs::path const& dir, UpdaterRun& run)
 {
-    std::vector<std::string> files; CollectSqlFiles(dir.string(), files);
-    for (auto const& full : files)
+    std::vector<SqlFile> files; CollectSqlFiles(dir.string(), files);
+    for (auto const& file : files)
     {
-        std::string filenameKey = (std::string(label) + "/" + RelKey(dir.string(), full));
-        if (applied.count(filenameKey)) continue;
-        if (ExecuteSqlFile(moduleName, full, filenameKey)){ applied.insert(filenameKey); ++nApplied; }
+        ++run.nFiles;
+        std::string filenameKey = run.keyPrefix + label + "/" + RelKey(dir.string(), file.path);
+
+        ManifestEntry entry;
+        auto cached = run.manifest->find(filenameKey);
+        if (cached != run.manifest->end() && cached->second.size == file.size && cached->second.mtime == file.mtime)
+            entry = cached->second;
+        else
+        {
+            entry.size  = file.size;
+            entry.mtime = file.mtime;
+            entry.sha1  = Sha1FileHex(file.path);
+            ++run.nHashed;
+        }
+        run.nextManifest[filenameKey] = entry;
+
+        auto done = run.applied.find(filenameKey);
+        if (done != run.applied.end())
+        {
+            if (done->second.empty() || done->second == entry.sha1) continue;
+
+            ++run.nChanged;
+            if (!run.reapplyChanged)
+            {
+                LOG_WARN("gv.customs", "[customs] {} changed after it was applied (db sha1={}, file sha1={}). "
+                    "Set RealOnline.Updater.ReapplyChanged = 1 to re-apply.", filenameKey, done->second, entry.sha1);
+                continue;
+            }
+            LOG_WARN("gv.customs", "[customs] {} changed after it was applied -> re-applying.", filenameKey);
+        }
+
+        if (ExecuteSqlFile(db, run.tracking, run.moduleName, file.path, filenameKey, entry.sha1, run.limits)){ run.applied[filenameKey] = entry.sha1; ++run.nApplied; }
     }
 }
 
@@ -252,45 +464,265 @@ static fs::path ModuleRoot()
     return p.parent_path().parent_path();
 }
 
+// ---------- běh updateru ----------
+struct UpdaterSettings
+{
+    std::string moduleName;
+    fs::path    sqlRoot;      // data/sql
+    fs::path    manifestPath;
+    ExecLimits  limits;
+    bool        reapplyChanged = false;
+    bool        parallel       = true;
+    bool        worldSplit     = false; // world pool má 2+ synchronní spojení
+};
+
+// config se čte ve world threadu, updater dostane jen hotovou kopii
+static UpdaterSettings ReadUpdaterSettings()
+{
+    UpdaterSettings st;
+    st.moduleName = DetectModuleName();
+    st.sqlRoot    = ModuleRoot() / "data/sql";
+
+    std::string manifestCfg = sConfigMgr->GetOption<std::string>("RealOnline.Updater.Manifest", "");
+    st.manifestPath   = manifestCfg.empty() ? (st.sqlRoot / "customs/.customs_manifest") : fs::path(manifestCfg);
+    st.reapplyChanged = sConfigMgr->GetOption<bool>("RealOnline.Updater.ReapplyChanged", false);
+    st.parallel       = sConfigMgr->GetOption<bool>("RealOnline.Updater.Parallel", true);
+    st.limits.maxPacketBytes = std::max<size_t>(4096, sConfigMgr->GetOption<uint32>("RealOnline.Updater.MaxPacketBytes", 1024u * 1024));
+    st.limits.maxTransBytes  = std::max<size_t>(st.limits.maxPacketBytes, sConfigMgr->GetOption<uint32>("RealOnline.Updater.MaxTransactionBytes", 16u * 1024 * 1024));
+
+    // customs i world jdou přes WorldDatabase; s jediným synchronním spojením
+    // by se o něj dva thready jen přetahovaly (pool na volné spojení čeká ve smyčce)
+    st.worldSplit = sConfigMgr->GetOption<uint32>("WorldDatabase.SynchThreads", 1) >= 2;
+    return st;
+}
+
+template<class Pool>
+static void RunTargetOn(Pool& db, SqlTarget target, UpdaterSettings const& st, Manifest const& manifest, UpdaterRun& run)
+{
+    SqlTargetInfo const& info = SqlTargets[size_t(target)];
+    fs::path root = st.sqlRoot / info.dir;
+    auto const t0 = std::chrono::steady_clock::now();
+
+    EnsureTrackingTable(db, info.tracking);
+
+    run.moduleName     = st.moduleName;
+    run.tracking       = info.tracking;
+    run.keyPrefix      = info.keyPrefix;
+    run.applied        = LoadApplied(db, run.tracking, st.moduleName);
+    run.manifest       = &manifest;
+    run.reapplyChanged = st.reapplyChanged;
+    run.limits         = st.limits;
+
+    RunPass(db, "base",    root / "base",            run);
+    RunPass(db, "include", root / "updates_include", run);
+    RunPass(db, "updates", root / "updates",         run);
+
+    run.ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    LOG_INFO("gv.customs", "[customs] {}: {} file(s), {} applied, {} ms.", info.dir, run.nFiles, run.nApplied, run.ms);
+}
+
+static void RunTarget(SqlTarget target, UpdaterSettings const& st, Manifest const& manifest, UpdaterRun& run)
+{
+    if (target == SqlTarget::Characters)
+        RunTargetOn(CharacterDatabase, target, st, manifest, run);
+    else
+        RunTargetOn(WorldDatabase, target, st, manifest, run);
+}
+
+// Cíle se rozdělí do pruhů podle spojení: v pruhu jdou postupně (pořadí
+// souborů v rámci DB zůstává), pruhy běží souběžně, každý na svém threadu.
+static void RunCustomsUpdater(UpdaterSettings const& st)
+{
+    LOG_INFO("gv.customs", "┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓");
+    LOG_INFO("gv.customs", "┃ Real Online – Customs SQL Updater ┃");
+    LOG_INFO("gv.customs", "┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛");
+    LOG_INFO("gv.customs", "[customs] Module: {}", st.moduleName);
+    LOG_INFO("gv.customs", "[customs] SQL root: {}", st.sqlRoot.string());
+
+    Manifest manifest = LoadManifest(st.manifestPath);
+
+    // customs.gv_updates používá i world pruh -> databáze musí existovat dřív,
+    // než se kterýkoli pruh spustí
+    EnsureCustomsDatabase();
+
+    // customs vždy (bootstrap gv_updates), ostatní jen s adresářem
+    std::vector<std::vector<SqlTarget>> lanes;
+    lanes.push_back({ SqlTarget::Customs });
+
+    std::error_code ec;
+    if (fs::exists(st.sqlRoot / SqlTargets[size_t(SqlTarget::World)].dir, ec))
+    {
+        if (st.worldSplit)
+            lanes.push_back({ SqlTarget::World });
+        else
+            lanes.front().push_back(SqlTarget::World);
+    }
+    if (fs::exists(st.sqlRoot / SqlTargets[size_t(SqlTarget::Characters)].dir, ec))
+        lanes.push_back({ SqlTarget::Characters });
+
+    std::array<UpdaterRun, size_t(SqlTarget::Count)> runs;
+    auto runLane = [&](std::vector<SqlTarget> const& lane)
+    {
+        for (SqlTarget t : lane)
+            RunTarget(t, st, manifest, runs[size_t(t)]);
+    };
+
+    auto const t0 = std::chrono::steady_clock::now();
+    if (st.parallel && lanes.size() > 1)
+    {
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < lanes.size(); ++i)
+            workers.emplace_back(runLane, std::cref(lanes[i]));
+        runLane(lanes.front());
+        for (std::thread& w : workers)
+            w.join();
+    }
+    else
+        for (auto const& lane : lanes)
+            runLane(lane);
+    int64 wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+
+    Manifest nextManifest;
+    uint32 nFiles = 0, nHashed = 0, nChanged = 0, nApplied = 0;
+    int64 sumMs = 0;
+    for (UpdaterRun& run : runs)
+    {
+        nextManifest.merge(run.nextManifest);
+        nFiles   += run.nFiles;
+        nHashed  += run.nHashed;
+        nChanged += run.nChanged;
+        nApplied += run.nApplied;
+        sumMs    += run.ms;
+    }
+
+    SaveManifest(st.manifestPath, nextManifest);
+    LOG_INFO("gv.customs", "[customs] {} file(s) checked, {} re-hashed (manifest: {}).", nFiles, nHashed, st.manifestPath.string());
+    if (lanes.size() > 1)
+        LOG_INFO("gv.customs", "[customs] {} database lane(s) {}: {} ms (databases one by one: {} ms).",
+            lanes.size(), st.parallel ? "in parallel" : "sequentially", wallMs, sumMs);
+    if (nChanged && !st.reapplyChanged)
+        LOG_WARN("gv.customs", "[customs] {} applied file(s) were modified on disk and NOT re-applied.", nChanged);
+
+    if (nApplied==0) LOG_INFO("gv.customs","[customs] Nothing to update – up to date.");
+    else             LOG_WARN("gv.customs","[customs] Applied {} file(s). If schema/gameplay changed, restart is recommended.", nApplied);
+}
+
+// ---------- stav ----------
+using UpdaterClock = std::chrono::steady_clock;
+
+static std::atomic<bool>   sSchemaReady{false};
+static std::thread         sUpdaterThread;
+static UpdaterClock::time_point sConfigLoadedAt;
+static std::atomic<int64>  sUpdaterMs{-1};   // délka běhu updateru, -1 = ještě běží
+static int64               sCoreLoadMs = -1; // OnAfterConfigLoad -> OnStartup
+
+namespace RealOnline
+{
+    bool IsCustomsSchemaReady()
+    {
+        return sSchemaReady.load(std::memory_order_acquire);
+    }
+}
+
+static int64 MsSince(UpdaterClock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(UpdaterClock::now() - t).count();
+}
+
+// Startovní report: updater běžel souběžně s jádrem, ušetřený čas je překryv obou.
+static void ReportStartupTiming()
+{
+    int64 upd = sUpdaterMs.load();
+    if (upd < 0 || sCoreLoadMs < 0)
+        return;
+
+    int64 saved = std::min(upd, sCoreLoadMs);
+    LOG_INFO("gv.customs", "[customs] Startup timing: updater {} ms, core load {} ms, saved ~{} ms of startup.",
+        upd, sCoreLoadMs, saved);
+    if (upd > sCoreLoadMs)
+        LOG_INFO("gv.customs", "[customs] Reward features were enabled {} ms after world startup.", upd - sCoreLoadMs);
+}
+
 // ---------- WorldScript ----------
 class RealOnline_Customs_UpdaterWS : public WorldScript
 {
 public:
     RealOnline_Customs_UpdaterWS()
-        : WorldScript("RealOnline_Customs_UpdaterWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP }) {}
+        : WorldScript("RealOnline_Customs_UpdaterWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP, WORLDHOOK_ON_UPDATE, WORLDHOOK_ON_SHUTDOWN }) {}
 
-    void OnAfterConfigLoad(bool /*reload*/) override
+    void OnAfterConfigLoad(bool reload) override
     {
-        LOG_INFO("gv.customs", "[customs] Early bootstrap (schema + tracking)...");
-        EnsureBootstrapEarly();
+        if (reload || _started)
+            return;
+        _started = true;
+
+        sConfigLoadedAt = UpdaterClock::now();
+        UpdaterSettings st = ReadUpdaterSettings();
+
+        if (!sConfigMgr->GetOption<bool>("RealOnline.Updater.Async", true))
+        {
+            _sync = std::move(st);
+            return;
+        }
+
+        LOG_INFO("gv.customs", "[customs] Starting background updater (parallel with core loading)...");
+        sUpdaterThread = std::thread([st = std::move(st)]()
+        {
+            auto const t0 = UpdaterClock::now();
+            RunCustomsUpdater(st);
+            sUpdaterMs = MsSince(t0);
+            sSchemaReady.store(true, std::memory_order_release);
+        });
     }
 
     void OnStartup() override
     {
-        std::string moduleName = DetectModuleName();
+        sCoreLoadMs = MsSince(sConfigLoadedAt);
 
-        fs::path root    = ModuleRoot();
-        fs::path sqlRoot = root / "data/sql/customs";
-        fs::path dirBase = sqlRoot / "base";
-        fs::path dirInc  = sqlRoot / "updates_include";
-        fs::path dirUpd  = sqlRoot / "updates";
+        if (_sync)
+        {
+            // RealOnline.Updater.Async = 0: původní chování, vše před startem světa
+            auto const t0 = UpdaterClock::now();
+            RunCustomsUpdater(*_sync);
+            _sync.reset();
+            LOG_INFO("gv.customs", "[customs] Updater ran synchronously: {} ms.", MsSince(t0));
+            sSchemaReady.store(true, std::memory_order_release);
+            return;
+        }
 
-        LOG_INFO("gv.customs", "┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓");
-        LOG_INFO("gv.customs", "┃ Real Online – Customs SQL Updater ┃");
-        LOG_INFO("gv.customs", "┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛");
-        LOG_INFO("gv.customs", "[customs] Module: {}", moduleName);
-        LOG_INFO("gv.customs", "[customs] SQL root: {}", sqlRoot.string());
+        if (!IsReady())
+            LOG_INFO("gv.customs", "[customs] World is up, customs updater still running – reward features wait for it.");
+        TryReport();
+    }
 
-        auto applied    = LoadApplied(moduleName);
-        uint32 appliedN = 0;
+    void OnUpdate(uint32 /*diff*/) override
+    {
+        if (!_reported)
+            TryReport();
+    }
 
-        RunPass("base",    dirBase, moduleName, applied, appliedN);
-        RunPass("include", dirInc,  moduleName, applied, appliedN);
-        RunPass("updates", dirUpd,  moduleName, applied, appliedN);
+    void OnShutdown() override
+    {
+        if (sUpdaterThread.joinable())
+            sUpdaterThread.join();
+    }
+
+private:
+    static bool IsReady() { return RealOnline::IsCustomsSchemaReady(); }
 
-        if (appliedN==0) LOG_INFO("gv.customs","[customs] Nothing to update – up to date.");
-        else             LOG_WARN("gv.customs","[customs] Applied {} file(s). If schema/gameplay changed, restart is recommended.", appliedN);
+    void TryReport()
+    {
+        if (_reported || !IsReady() || sCoreLoadMs < 0)
+            return;
+        _reported = true;
+        if (sUpdaterThread.joinable())
+            sUpdaterThread.join();
+        ReportStartupTiming();
     }
+
+    std::optional<UpdaterSettings> _sync;
+    bool _started  = false;
+    bool _reported = false;
 };
 
 // registrace pro modul Real Online
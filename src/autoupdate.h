@@ -0,0 +1,18 @@
+// modules/mod-real-online/src/autoupdate.h
+
+#ifndef MOD_REAL_ONLINE_AUTOUPDATE_H
+#define MOD_REAL_ONLINE_AUTOUPDATE_H
+
+// =============================
+// Customs SQL updater
+// =============================
+// Updater běží na pozadí souběžně s načítáním jádra. Dokud nedoběhne,
+// funkce pracující s tabulkami customs.* zůstávají neaktivní.
+// data/sql/customs a data/sql/world jdou přes WorldDatabase, data/sql/characters
+// přes CharacterDatabase; různé databáze se aplikují souběžně.
+namespace RealOnline
+{
+    bool IsCustomsSchemaReady();
+}
+
+#endif // MOD_REAL_ONLINE_AUTOUPDATE_H
@@ -0,0 +1,188 @@
+// modules/mod-real-online/src/bot_accounts.cpp
+
+#include "bot_accounts.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "DatabaseEnv.h"
+#include "QueryCallback.h"
+#include "AsyncCallbackProcessor.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        struct BotCfg
+        {
+            std::string query;              // "" = vypnuto
+            uint32      refreshMs = 300000; // 0 = jen při startu / reloadu configu
+        };
+
+        BotCfg sBotCfg;
+
+        // bit (id % 64) slova (id / 64) = účet je bot; 1 << 26 ID = 8 MB
+        constexpr uint32 MaxBotAccountId = 1u << 26;
+
+        std::vector<uint64> sBits;
+        uint32 sCount  = 0;
+        uint32 sLastId = 0;
+
+        bool   sLoading  = false;
+        uint32 sLoadSeq  = 0;  // změna configu zahodí rozběhnuté načtení
+        uint32 sRefreshTimer = 0;
+
+        QueryCallbackProcessor sQueries;
+
+        void SetBit(std::vector<uint64>& bits, uint32& count, uint32 id)
+        {
+            size_t word = id / 64;
+            if (word >= bits.size())
+                bits.resize(std::max(word + 1, bits.size() * 2));
+
+            uint64 mask = uint64(1) << (id % 64);
+            if (!(bits[word] & mask))
+            {
+                bits[word] |= mask;
+                ++count;
+            }
+        }
+
+        std::string BuildQuery(uint32 lastId)
+        {
+            static constexpr std::string_view Placeholder = "{LAST_ID}";
+
+            std::string q = sBotCfg.query;
+            std::string id = std::to_string(lastId);
+            for (size_t pos = q.find(Placeholder); pos != std::string::npos; pos = q.find(Placeholder, pos + id.size()))
+                q.replace(pos, Placeholder.size(), id);
+            return q;
+        }
+
+        // full = celý seznam znovu (nahradí bitset), jinak jen ID nad sLastId
+        void StartLoad(bool full)
+        {
+            if (sBotCfg.query.empty() || sLoading)
+                return;
+
+            sLoading = true;
+            uint32 seq = sLoadSeq;
+
+            sQueries.AddCallback(LoginDatabase.AsyncQuery(BuildQuery(full ? 0 : sLastId)).WithCallback([full, seq](QueryResult res)
+            {
+                if (seq != sLoadSeq)
+                    return;
+                sLoading = false;
+
+                std::vector<uint64> fresh;
+                uint32 freshCount = 0;
+                std::vector<uint64>& bits = full ? fresh : sBits;
+                uint32& count = full ? freshCount : sCount;
+                uint32 lastId = full ? 0 : sLastId;
+                uint32 added = 0, skipped = 0;
+
+                if (res)
+                {
+                    do
+                    {
+                        uint32 id = res->Fetch()[0].Get<uint32>();
+                        if (id == 0 || id >= MaxBotAccountId)
+                        {
+                            ++skipped;
+                            continue;
+                        }
+                        uint32 before = count;
+                        SetBit(bits, count, id);
+                        added += count - before;
+                        lastId = std::max(lastId, id);
+                    } while (res->NextRow());
+                }
+
+                if (full)
+                {
+                    sBits  = std::move(fresh);
+                    sCount = freshCount;
+                }
+                sLastId = lastId;
+
+                if (skipped)
+                    LOG_WARN("module", "[bots] {} account ID(s) from RealOnline.BotAccounts.Query are 0 or above {}, ignored.", skipped, MaxBotAccountId);
+                if (full || added)
+                    LOG_INFO("module", "[bots] {} bot account(s) loaded ({} new, last ID {}).", sCount, added, sLastId);
+            }));
+        }
+
+        void Reset()
+        {
+            ++sLoadSeq;
+            sLoading = false;
+            sBits.clear();
+            sBits.shrink_to_fit();
+            sCount  = 0;
+            sLastId = 0;
+            sRefreshTimer = 0;
+        }
+    }
+
+    bool IsBotAccount(uint32 account)
+    {
+        size_t word = account / 64;
+        return word < sBits.size() && (sBits[word] >> (account % 64) & 1);
+    }
+
+    uint32 BotAccountCount() { return sCount; }
+    uint32 BotAccountLastId() { return sLastId; }
+}
+
+class RealOnlineBotAccountsWS : public WorldScript
+{
+public:
+    RealOnlineBotAccountsWS()
+        : WorldScript("RealOnlineBotAccountsWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP, WORLDHOOK_ON_UPDATE }) {}
+
+    void OnAfterConfigLoad(bool reload) override
+    {
+        using namespace RealOnline;
+        BotCfg c;
+        c.query     = sConfigMgr->GetOption<std::string>("RealOnline.BotAccounts.Query", "");
+        c.refreshMs = sConfigMgr->GetOption<uint32>("RealOnline.BotAccounts.RefreshSeconds", 300u) * 1000;
+
+        bool changed = c.query != sBotCfg.query;
+        sBotCfg = std::move(c);
+
+        // při prvním načtení ještě neběží DB -> první load až OnStartup;
+        // reload configu načte seznam celý znovu (i smazané účty)
+        if (!reload)
+            return;
+        if (changed)
+            Reset();
+        StartLoad(true);
+    }
+
+    void OnStartup() override { RealOnline::StartLoad(true); }
+
+    void OnUpdate(uint32 diff) override
+    {
+        using namespace RealOnline;
+        sQueries.ProcessReadyCallbacks();
+
+        if (sBotCfg.query.empty() || !sBotCfg.refreshMs)
+            return;
+
+        sRefreshTimer += diff;
+        if (sRefreshTimer < sBotCfg.refreshMs)
+            return;
+        sRefreshTimer = 0;
+
+        StartLoad(false);
+    }
+};
+
+void AddRealOnlineBotAccountsScripts()
+{
+    new RealOnlineBotAccountsWS();
+}
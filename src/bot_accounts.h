@@ -0,0 +1,27 @@
+// modules/mod-real-online/src/bot_accounts.h
+
+#ifndef MOD_REAL_ONLINE_BOT_ACCOUNTS_H
+#define MOD_REAL_ONLINE_BOT_ACCOUNTS_H
+
+#include "Define.h"
+
+// =============================
+// Účty botů z DB (RealOnline.BotAccounts.Query)
+// =============================
+// Volitelný zdroj vedle RealOnline.IgnoreAccountIdRanges: SELECT nad auth DB
+// vracející ID účtů botů (např. playerbots RNDBOT*). Načte se asynchronně při
+// startu do hustého bitsetu indexovaného ID účtu, na timeru se dočítají jen
+// nové účty ({LAST_ID} v dotazu). Boti se vyřazují z .online, playtime
+// tickeru, streaku, milníků a hromadného grantu.
+//
+// Bitset mění jen world thread ve WorldScript::OnUpdate (po update map),
+// čtení je proto bezpečné i z map threadů.
+namespace RealOnline
+{
+    bool IsBotAccount(uint32 account);
+
+    uint32 BotAccountCount();
+    uint32 BotAccountLastId();
+}
+
+#endif // MOD_REAL_ONLINE_BOT_ACCOUNTS_H
@@ -0,0 +1,28 @@
+// modules/mod-real-online/src/core_types.h
+
+#ifndef MOD_REAL_ONLINE_CORE_TYPES_H
+#define MOD_REAL_ONLINE_CORE_TYPES_H
+
+// =============================
+// Typy z Define.h i bez jádra
+// =============================
+// Části bez závislosti na jádru (parsery, SQL tokenizer, katalog zpráv, logika
+// streaku) se překládají i v samostatném buildu benchmarku (CMakeLists.txt,
+// cmake -S na adresář modulu). Tam Define.h není.
+#if __has_include("Define.h")
+  #include "Define.h"
+#else
+  #include <cstddef>
+  #include <cstdint>
+
+  typedef std::int64_t  int64;
+  typedef std::int32_t  int32;
+  typedef std::int16_t  int16;
+  typedef std::int8_t   int8;
+  typedef std::uint64_t uint64;
+  typedef std::uint32_t uint32;
+  typedef std::uint16_t uint16;
+  typedef std::uint8_t  uint8;
+#endif
+
+#endif // MOD_REAL_ONLINE_CORE_TYPES_H
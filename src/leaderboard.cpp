@@ -0,0 +1,494 @@
+// modules/mod-real-online/src/leaderboard.cpp
+
+#include "leaderboard.h"
+#include "autoupdate.h"
+#include "load_sim.h"
+#include "messages.h"
+#include "reward_storage.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "Player.h"
+#include "Chat.h"
+#include "DatabaseEnv.h"
+#include "QueryCallback.h"
+#include "AsyncCallbackProcessor.h"
+#include "WorldSession.h"
+#include "WorldSessionMgr.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        // Seřazený buffer 2*K nejlepších (hodnota desc, účet asc).
+        // complete = v bufferu jsou všechny existující účty; jakmile se něco
+        // vyhodí, o účtech pod minimem už nic nevíme a podle toho se chová Offer.
+        class TopK
+        {
+        public:
+            struct Entry
+            {
+                uint32      account = 0;
+                uint32      value   = 0;
+                std::string name;
+            };
+
+            void Reset(size_t capacity)
+            {
+                _entries.clear();
+                _entries.reserve(capacity + 1);
+                _capacity = capacity;
+                _complete = false;
+            }
+
+            // seed z dotazu, řádky už jsou seřazené
+            void Append(uint32 account, uint32 value, std::string name)
+            {
+                if (_entries.size() < _capacity)
+                    _entries.push_back({ account, value, std::move(name) });
+            }
+
+            void SetComplete(bool complete) { _complete = complete; }
+
+            bool Find(uint32 account, uint32& value) const
+            {
+                for (Entry const& e : _entries)
+                    if (e.account == account)
+                    {
+                        value = e.value;
+                        return true;
+                    }
+                return false;
+            }
+
+            void Offer(uint32 account, uint32 value, std::string_view name)
+            {
+                auto it = std::find_if(_entries.begin(), _entries.end(),
+                    [account](Entry const& e){ return e.account == account; });
+
+                if (it != _entries.end())
+                {
+                    bool decreased = value < it->value;
+                    it->value = value;
+                    if (!name.empty())
+                        it->name.assign(name);
+
+                    // spadl pod ostatní a mezi ním a minimem můžou být neznámé účty
+                    if (decreased && !_complete && _entries.size() > 1 && value < MinExcept(account))
+                    {
+                        _entries.erase(it);
+                        return;
+                    }
+                    Resort(size_t(it - _entries.begin()));
+                    return;
+                }
+
+                if (_capacity == 0)
+                    return;
+                // neúplný buffer: pod minimem může být kdokoli jiný, nelze zařadit
+                if (!_complete && (_entries.empty() || value <= _entries.back().value))
+                    return;
+
+                _entries.push_back({ account, value, std::string(name) });
+                Resort(_entries.size() - 1);
+
+                if (_entries.size() > _capacity)
+                {
+                    _entries.pop_back();
+                    _complete = false;
+                }
+            }
+
+            std::vector<Entry> const& Entries() const { return _entries; }
+
+        private:
+            static bool Before(Entry const& a, Entry const& b)
+            {
+                return a.value != b.value ? a.value > b.value : a.account < b.account;
+            }
+
+            uint32 MinExcept(uint32 account) const
+            {
+                for (auto it = _entries.rbegin(); it != _entries.rend(); ++it)
+                    if (it->account != account)
+                        return it->value;
+                return 0;
+            }
+
+            // jeden prvek na indexu i je mimo pořadí -> posunout na místo, O(K)
+            void Resort(size_t i)
+            {
+                while (i > 0 && Before(_entries[i], _entries[i - 1]))
+                {
+                    std::swap(_entries[i], _entries[i - 1]);
+                    --i;
+                }
+                while (i + 1 < _entries.size() && Before(_entries[i + 1], _entries[i]))
+                {
+                    std::swap(_entries[i], _entries[i + 1]);
+                    ++i;
+                }
+            }
+
+            std::vector<Entry> _entries;
+            size_t _capacity = 0;
+            bool   _complete = false;
+        };
+
+        struct LeaderboardCfg
+        {
+            uint32 size       = 10;
+            uint32 tokenItem  = 0;
+            uint32 lookupMax  = 500;  // víc neznámých součtů za tick -> reseed místo IN dotazu
+        };
+
+        LeaderboardCfg sCfg;
+        std::array<TopK, size_t(Leaderboard::Count)> sBoards;
+
+        // součet entitled online účtů (načteno při loginu), pro přesné inkrementy;
+        // paměťový backend sem ukládá i dohledané součty (login dotaz nemá)
+        std::unordered_map<uint32, uint32> sKnownTotals;
+
+        // Načítání součtu po loginu ještě běží: delty zapsané až po odeslání
+        // dotazu v jeho výsledku nejsou -> sečtou se sem a přičtou k načtené
+        // hodnotě. seq odliší starý callback po relogu.
+        struct PendingTotal
+        {
+            uint32 seq   = 0;
+            uint32 delta = 0;
+        };
+        std::unordered_map<uint32, PendingTotal> sPendingTotals;
+        uint32 sPendingSeq = 0;
+        std::unordered_set<uint32> sLookups;
+        bool sReseedTokens = false;
+        bool sSeedInFlight = false;
+
+        QueryCallbackProcessor sQueries;
+
+        std::string NameOf(uint32 account)
+        {
+            if (WorldSession* s = sWorldSessionMgr->FindSession(account))
+                if (Player* p = s->GetPlayer())
+                    return p->GetName();
+            return {};
+        }
+
+        // součet entitled z live tabulky i archivu, po účtech
+        std::string TokenTotalsSelect(std::string const& accountFilter)
+        {
+            std::string where = " WHERE item = " + std::to_string(sCfg.tokenItem) + accountFilter;
+            return "SELECT account, SUM(entitled) AS entitled FROM ("
+                   "SELECT account, entitled FROM customs.rewards" + where +
+                   " UNION ALL SELECT account, entitled FROM customs.rewards_archive" + where +
+                   ") u GROUP BY account";
+        }
+
+        // nejhranější postava účtu jako zobrazované jméno
+        std::string SeedSelect(uint32 type, std::string const& from, std::string const& value,
+                               std::string const& where, std::string const& alias)
+        {
+            return "(SELECT " + std::to_string(type) + ", " + alias + ".account, CAST(" + value + " AS UNSIGNED), "
+                   "IFNULL((SELECT c.name FROM characters c WHERE c.account = " + alias + ".account "
+                   "ORDER BY c.totaltime DESC LIMIT 1), '') "
+                   "FROM " + from + " " + alias + where +
+                   " ORDER BY " + value + " DESC, " + alias + ".account LIMIT " + std::to_string(sCfg.size * 2) + ")";
+        }
+
+        void Seed(bool streak, bool tokens)
+        {
+            if (sSeedInFlight || (!streak && !tokens))
+                return;
+
+            std::string q;
+            if (streak)
+                q = SeedSelect(0, "customs.login_streak", "s.consecutive_days", "", "s");
+            if (tokens)
+            {
+                if (!q.empty())
+                    q += " UNION ALL ";
+                q += SeedSelect(1, "(" + TokenTotalsSelect("") + ")", "r.entitled", "", "r");
+            }
+
+            size_t capacity = size_t(sCfg.size) * 2;
+            sSeedInFlight = true;
+            sQueries.AddCallback(CharacterDatabase.AsyncQuery(q).WithCallback([streak, tokens, capacity](QueryResult res)
+            {
+                sSeedInFlight = false;
+                if (streak)
+                    sBoards[size_t(Leaderboard::Streak)].Reset(capacity);
+                if (tokens)
+                    sBoards[size_t(Leaderboard::Tokens)].Reset(capacity);
+
+                std::array<size_t, size_t(Leaderboard::Count)> rows{};
+                if (res)
+                {
+                    do
+                    {
+                        Field* f = res->Fetch();
+                        size_t board = f[0].Get<uint64>() ? size_t(Leaderboard::Tokens) : size_t(Leaderboard::Streak);
+                        sBoards[board].Append(f[1].Get<uint32>(), uint32(f[2].Get<uint64>()), f[3].Get<std::string>());
+                        ++rows[board];
+                    } while (res->NextRow());
+                }
+
+                if (streak)
+                    sBoards[size_t(Leaderboard::Streak)].SetComplete(rows[size_t(Leaderboard::Streak)] < capacity);
+                if (tokens)
+                    sBoards[size_t(Leaderboard::Tokens)].SetComplete(rows[size_t(Leaderboard::Tokens)] < capacity);
+            }));
+        }
+
+        // Paměťový backend: součty se čtou tady ve world ticku (mimo scope
+        // reward.tick), nejvýš lookupMax účtů za tick, zbytek příště.
+        void ProcessMemoryLookups()
+        {
+            uint32 n = 0;
+            for (auto it = sLookups.begin(); it != sLookups.end() && n < sCfg.lookupMax; ++n)
+            {
+                uint32 acc = *it;
+                it = sLookups.erase(it);
+
+                LedgerBalance bal;
+                if (!Storage().ReadBalance(acc, sCfg.tokenItem, bal))
+                    continue;
+                sKnownTotals[acc] = bal.entitled;
+                sBoards[size_t(Leaderboard::Tokens)].Offer(acc, bal.entitled, NameOf(acc));
+            }
+        }
+
+        void ProcessLookups()
+        {
+            if (Storage().Backend() != StorageBackend::MySql)
+            {
+                ProcessMemoryLookups();
+                return;
+            }
+
+            if (sReseedTokens && !sSeedInFlight)
+            {
+                sReseedTokens = false;
+                sLookups.clear();
+                Seed(false, true);
+                return;
+            }
+
+            if (sLookups.empty())
+                return;
+
+            if (sLookups.size() > sCfg.lookupMax)
+            {
+                sReseedTokens = true;
+                return;
+            }
+
+            std::string in = " AND account IN (";
+            bool first = true;
+            for (uint32 acc : sLookups)
+            {
+                if (!first) in += ",";
+                in += std::to_string(acc);
+                first = false;
+            }
+            in += ")";
+            sLookups.clear();
+
+            std::string q = TokenTotalsSelect(in);
+
+            sQueries.AddCallback(CharacterDatabase.AsyncQuery(q).WithCallback([](QueryResult res)
+            {
+                if (!res)
+                    return;
+                do
+                {
+                    Field* f = res->Fetch();
+                    uint32 acc = f[0].Get<uint32>();
+                    sBoards[size_t(Leaderboard::Tokens)].Offer(acc, uint32(f[1].Get<uint64>()), NameOf(acc));
+                } while (res->NextRow());
+            }));
+        }
+    }
+
+    void OfferLeaderboardScore(Leaderboard board, uint32 account, uint32 value, std::string_view name)
+    {
+        if (name.empty())
+        {
+            std::string n = NameOf(account);
+            sBoards[size_t(board)].Offer(account, value, n);
+        }
+        else
+            sBoards[size_t(board)].Offer(account, value, name);
+    }
+
+    void NoteEntitlementDelta(uint32 account, uint32 itemId, uint32 delta)
+    {
+        // syntetické účty simulátoru do žebříčku nepatří
+        if (itemId != sCfg.tokenItem || delta == 0 || account >= SimAccountBase)
+            return;
+
+        if (auto it = sPendingTotals.find(account); it != sPendingTotals.end())
+        {
+            it->second.delta += delta; // nabídne se, až dorazí načtený součet
+            return;
+        }
+
+        uint32 total = 0;
+        if (auto it = sKnownTotals.find(account); it != sKnownTotals.end())
+            total = (it->second += delta);
+        else if (sBoards[size_t(Leaderboard::Tokens)].Find(account, total))
+            total += delta;
+        else
+        {
+            // neznámý součet dohledá ProcessLookups (volá se i uvnitř reward.tick)
+            if (!sReseedTokens)
+                sLookups.insert(account);
+            return;
+        }
+
+        OfferLeaderboardScore(Leaderboard::Tokens, account, total);
+    }
+
+    void ShowLeaderboard(ChatHandler* handler, Leaderboard board)
+    {
+        auto const& entries = sBoards[size_t(board)].Entries();
+        if (entries.empty())
+        {
+            SendMsg(handler, Msg::LeaderboardEmpty);
+            return;
+        }
+
+        SendMsg(handler, board == Leaderboard::Streak ? Msg::LeaderboardStreakHead : Msg::LeaderboardTokensHead, sCfg.size);
+
+        size_t shown = std::min<size_t>(sCfg.size, entries.size());
+        for (size_t i = 0; i < shown; ++i)
+        {
+            TopK::Entry const& e = entries[i];
+            if (e.name.empty())
+            {
+                MessageBuffer name;
+                name.Append("#").Append(e.account);
+                SendMsg(handler, Msg::LeaderboardRow, i + 1, name.View(), e.value);
+            }
+            else
+                SendMsg(handler, Msg::LeaderboardRow, i + 1, std::string_view(e.name), e.value);
+        }
+    }
+}
+
+class RealOnlineLeaderboardWS : public WorldScript
+{
+public:
+    RealOnlineLeaderboardWS()
+        : WorldScript("RealOnlineLeaderboardWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_UPDATE }) {}
+
+    void OnAfterConfigLoad(bool reload) override
+    {
+        using namespace RealOnline;
+        LeaderboardCfg c;
+        c.size      = std::clamp(sConfigMgr->GetOption<uint32>("RealOnline.Leaderboard.Size", 10u), 1u, 50u);
+        c.tokenItem = sConfigMgr->GetOption<uint32>("RealOnline.Reward.ItemId", 0u);
+        c.lookupMax = sConfigMgr->GetOption<uint32>("RealOnline.Leaderboard.LookupMax", 500u);
+
+        bool changed = c.size != sCfg.size || c.tokenItem != sCfg.tokenItem;
+        sCfg = c;
+
+        if (reload && changed && _seeded)
+        {
+            sKnownTotals.clear();
+            sLookups.clear();
+            if (Storage().Backend() == StorageBackend::MySql)
+                Seed(true, true);
+        }
+    }
+
+    void OnUpdate(uint32 /*diff*/) override
+    {
+        using namespace RealOnline;
+        sQueries.ProcessReadyCallbacks();
+
+        // tabulky customs existují až po doběhnutí updateru
+        if (!IsCustomsSchemaReady())
+            return;
+
+        // seed je SQL; paměťový backend plní žebříčky jen inkrementálně
+        if (!_seeded)
+        {
+            _seeded = true;
+            if (Storage().Backend() == StorageBackend::MySql)
+                Seed(true, true);
+        }
+        ProcessLookups();
+    }
+
+private:
+    bool _seeded = false;
+};
+
+class RealOnlineLeaderboardPS : public PlayerScript
+{
+public:
+    RealOnlineLeaderboardPS() : PlayerScript("RealOnlineLeaderboardPS") {}
+
+    void OnPlayerLogin(Player* player) override
+    {
+        using namespace RealOnline;
+        WorldSession* session = player->GetSession();
+        if (!session || sCfg.tokenItem == 0 || !IsCustomsSchemaReady() || Storage().Backend() != StorageBackend::MySql)
+            return;
+
+        uint32 acc = session->GetAccountId();
+        uint32 seq = ++sPendingSeq;
+        sKnownTotals.erase(acc);
+        sPendingTotals[acc] = { seq, 0 };
+
+        std::string q = TokenTotalsSelect(" AND account = " + std::to_string(acc));
+
+        session->GetQueryProcessor().AddCallback(CharacterDatabase.AsyncQuery(q).WithCallback([acc, seq](QueryResult res)
+        {
+            using namespace RealOnline;
+            auto it = sPendingTotals.find(acc);
+            if (it == sPendingTotals.end() || it->second.seq != seq)
+                return; // odhlášen nebo relog s novějším dotazem
+
+            uint32 delta = it->second.delta;
+            sPendingTotals.erase(it);
+
+            uint32 total = (res ? uint32(res->Fetch()[1].Get<uint64>()) : 0) + delta;
+            sKnownTotals[acc] = total;
+            if (delta)
+                OfferLeaderboardScore(Leaderboard::Tokens, acc, total);
+        }));
+    }
+
+    void OnPlayerLogout(Player* player) override
+    {
+        if (WorldSession* session = player->GetSession())
+        {
+            using namespace RealOnline;
+            uint32 acc = session->GetAccountId();
+            sKnownTotals.erase(acc);
+
+            // delty čekající na login dotaz by se ztratily -> dohledat součet
+            auto it = sPendingTotals.find(acc);
+            if (it != sPendingTotals.end())
+            {
+                if (it->second.delta && !sReseedTokens)
+                    sLookups.insert(acc);
+                sPendingTotals.erase(it);
+            }
+        }
+    }
+};
+
+void AddRealOnlineLeaderboardScripts()
+{
+    new RealOnlineLeaderboardWS();
+    new RealOnlineLeaderboardPS();
+}
@@ -0,0 +1,36 @@
+// modules/mod-real-online/src/leaderboard.h
+
+#ifndef MOD_REAL_ONLINE_LEADERBOARD_H
+#define MOD_REAL_ONLINE_LEADERBOARD_H
+
+#include "Define.h"
+
+#include <string_view>
+
+class ChatHandler;
+
+// =============================
+// Žebříčky (.streak top, .reward top)
+// =============================
+// Top-K v paměti, naplněné jedním dotazem při startu a dál udržované
+// inkrementálně ze zápisů streaku a entitlementů. Čtení je O(K) bez DB.
+// Vše běží ve world threadu.
+namespace RealOnline
+{
+    enum class Leaderboard : uint8
+    {
+        Streak,  // customs.login_streak.streak_day
+        Tokens,  // customs.rewards.entitled pro RealOnline.Reward.ItemId
+        Count
+    };
+
+    // nová hodnota účtu (name prázdné = vezme se z online session / ponechá staré)
+    void OfferLeaderboardScore(Leaderboard board, uint32 account, uint32 value, std::string_view name = {});
+
+    // volá se po zápisu entitled += delta; neznámé součty se dočtou dávkově
+    void NoteEntitlementDelta(uint32 account, uint32 itemId, uint32 delta);
+
+    void ShowLeaderboard(ChatHandler* handler, Leaderboard board);
+}
+
+#endif // MOD_REAL_ONLINE_LEADERBOARD_H
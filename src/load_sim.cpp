@@ -0,0 +1,263 @@
+// modules/mod-real-online/src/load_sim.cpp
+
+#include "load_sim.h"
+#include "messages.h"
+#include "reward_pipeline.h"
+#include "reward_storage.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "Chat.h"
+#include "WorldSession.h"
+#include "WorldSessionMgr.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        struct SimCfg
+        {
+            uint32 loginsPerSec     = 200;
+            uint32 levelUpsPerSec   = 20;
+            uint32 commandsPerSec   = 50;
+            uint32 rewardIntervalMs = 10000;
+            uint32 maxLevel         = 80;
+        };
+
+        SimCfg ReadSimCfg()
+        {
+            SimCfg c;
+            c.loginsPerSec     = sConfigMgr->GetOption<uint32>("RealOnline.Sim.LoginsPerSec", 200u);
+            c.levelUpsPerSec   = sConfigMgr->GetOption<uint32>("RealOnline.Sim.LevelUpsPerSec", 20u);
+            c.commandsPerSec   = sConfigMgr->GetOption<uint32>("RealOnline.Sim.CommandsPerSec", 50u);
+            c.rewardIntervalMs = std::max(100u, sConfigMgr->GetOption<uint32>("RealOnline.Sim.RewardIntervalMs", 10000u));
+            c.maxLevel         = std::clamp(sConfigMgr->GetOption<uint32>("RealOnline.Sim.MaxLevel", 80u), 2u, 255u);
+            return c;
+        }
+
+        std::array<std::vector<SimDriver>, size_t(SimEvent::Count)> sDrivers;
+
+        using SimClock = std::chrono::steady_clock;
+
+        struct SimRun
+        {
+            bool   active    = false;
+            uint32 requester = 0;
+            uint32 humans    = 0;
+            uint32 total     = 0;
+            uint32 durationMs = 0;
+            uint32 elapsedMs  = 0;
+            uint32 loggedIn   = 0;    // účty [0, loggedIn) jsou online
+            uint32 rewardTimer = 0;
+            double loginDebt  = 0.0;  // zlomky událostí mezi ticky
+            double levelDebt  = 0.0;
+            double cmdDebt    = 0.0;
+            SimCfg cfg;
+
+            std::vector<uint8>  level;     // index účtu -> level postavy
+            std::vector<uint32> workUs;    // práce simulace ve world threadu za tick
+            std::vector<uint32> tickMs;    // délka world ticku (diff)
+            std::array<uint64, size_t(SimEvent::Count)> events{};
+            StorageCounters counters;      // stav úložiště při startu
+            std::mt19937 rng{ 1 };
+        };
+
+        SimRun sRun;
+
+        uint32 SimAccount(uint32 index) { return SimAccountBase + index; }
+
+        // weight = kolik událostí volání zastupuje (RewardTick = počet online účtů)
+        void Fire(SimEvent event, uint32 account, uint32 arg, uint32 weight = 1)
+        {
+            for (SimDriver const& d : sDrivers[size_t(event)])
+                d(account, arg);
+            sRun.events[size_t(event)] += weight;
+        }
+
+        // hlášení jako u bulk grantu: session žadatele, jinak log
+        template<typename... Args>
+        void Report(uint32 requester, Msg id, Args const&... args)
+        {
+            WorldSession* session = requester ? sWorldSessionMgr->FindSession(requester) : nullptr;
+
+            MessageBuffer buf;
+            buf.Format(id, session ? SessionLang(session) : DefaultLang(), args...);
+
+            LOG_INFO("module", "[sim] {}", buf.View());
+            if (session)
+            {
+                ChatHandler handler(session);
+                handler.SendSysMessage(buf.View());
+            }
+        }
+
+        template<typename T>
+        T Percentile(std::vector<T>& v, uint32 pct)
+        {
+            if (v.empty())
+                return 0;
+            size_t idx = std::min(v.size() - 1, v.size() * pct / 100);
+            std::nth_element(v.begin(), v.begin() + idx, v.end());
+            return v[idx];
+        }
+
+        uint32 RandomHuman()
+        {
+            uint32 online = std::min(sRun.loggedIn, sRun.humans);
+            return std::uniform_int_distribution<uint32>(0, online - 1)(sRun.rng);
+        }
+
+        void FinishSimulation()
+        {
+            for (uint32 i = 0; i < sRun.loggedIn; ++i)
+                Fire(SimEvent::Logout, SimAccount(i), 0);
+            FlushRewardGrants();
+
+            StorageCounters now = Storage().Counters();
+            uint64 blocking = now.blocking - sRun.counters.blocking;
+            uint64 queued   = now.queued - sRun.counters.queued;
+            uint64 perSec   = sRun.elapsedMs ? (blocking + queued) * 1000 / sRun.elapsedMs : 0;
+
+            uint64 workSum = 0;
+            for (uint32 us : sRun.workUs)
+                workSum += us;
+            uint32 ticks  = uint32(sRun.workUs.size());
+            uint32 avgUs  = ticks ? uint32(workSum / ticks) : 0;
+            uint32 p99Us  = Percentile(sRun.workUs, 99);
+            uint32 maxUs  = sRun.workUs.empty() ? 0 : *std::max_element(sRun.workUs.begin(), sRun.workUs.end());
+            uint32 p99Ms  = Percentile(sRun.tickMs, 99);
+            uint32 maxMs  = sRun.tickMs.empty() ? 0 : *std::max_element(sRun.tickMs.begin(), sRun.tickMs.end());
+
+            Report(sRun.requester, Msg::SimReportTicks, ticks, avgUs, p99Us, maxUs, p99Ms, maxMs);
+            Report(sRun.requester, Msg::SimReportEvents,
+                sRun.events[size_t(SimEvent::Login)], sRun.events[size_t(SimEvent::LevelUp)],
+                sRun.events[size_t(SimEvent::Command)], sRun.events[size_t(SimEvent::RewardTick)],
+                blocking, queued, perSec);
+
+            sRun = SimRun();
+        }
+
+        void SimTick(uint32 diff)
+        {
+            auto t0 = SimClock::now();
+            SimCfg const& cfg = sRun.cfg;
+
+            // login storm: účty se přihlašují popořadě, dokud nejsou online všechny
+            sRun.loginDebt += double(cfg.loginsPerSec) * diff / 1000.0;
+            while (sRun.loginDebt >= 1.0 && sRun.loggedIn < sRun.total)
+            {
+                Fire(SimEvent::Login, SimAccount(sRun.loggedIn), 0);
+                ++sRun.loggedIn;
+                sRun.loginDebt -= 1.0;
+            }
+            if (sRun.loggedIn == sRun.total)
+                sRun.loginDebt = 0.0;
+
+            // level-upy a příkazy jen od lidí, boti jen sedí online
+            if (sRun.loggedIn && sRun.humans)
+            {
+                sRun.levelDebt += double(cfg.levelUpsPerSec) * diff / 1000.0;
+                for (; sRun.levelDebt >= 1.0; sRun.levelDebt -= 1.0)
+                {
+                    uint32 i = RandomHuman();
+                    if (sRun.level[i] < cfg.maxLevel)
+                        Fire(SimEvent::LevelUp, SimAccount(i), sRun.level[i]++);
+                }
+
+                sRun.cmdDebt += double(cfg.commandsPerSec) * diff / 1000.0;
+                for (; sRun.cmdDebt >= 1.0; sRun.cmdDebt -= 1.0)
+                    Fire(SimEvent::Command, SimAccount(RandomHuman()), sRun.rng());
+            }
+
+            sRun.rewardTimer += diff;
+            if (sRun.rewardTimer >= cfg.rewardIntervalMs)
+            {
+                sRun.rewardTimer = 0;
+                if (sRun.loggedIn)
+                    Fire(SimEvent::RewardTick, SimAccount(0), sRun.loggedIn, sRun.loggedIn);
+            }
+
+            sRun.workUs.push_back(uint32(std::chrono::duration_cast<std::chrono::microseconds>(SimClock::now() - t0).count()));
+            sRun.tickMs.push_back(diff);
+
+            sRun.elapsedMs += diff;
+            if (sRun.elapsedMs >= sRun.durationMs)
+                FinishSimulation();
+        }
+    }
+
+    void RegisterSimDriver(SimEvent event, SimDriver driver)
+    {
+        sDrivers[size_t(event)].push_back(std::move(driver));
+    }
+
+    uint32 SimOnlineCount()
+    {
+        return sRun.active ? sRun.loggedIn : 0;
+    }
+
+    void StartSimulation(ChatHandler* handler, uint32 requester, uint32 humans, uint32 bots, uint32 seconds)
+    {
+        if (Storage().Backend() != StorageBackend::Memory)
+        {
+            SendMsg(handler, Msg::SimNeedsMemory);
+            return;
+        }
+        if (sRun.active)
+        {
+            SendMsg(handler, Msg::SimBusy);
+            return;
+        }
+
+        sRun = SimRun();
+        sRun.active     = true;
+        sRun.requester  = requester;
+        sRun.humans     = humans;
+        sRun.total      = humans + bots;
+        sRun.durationMs = seconds * 1000;
+        sRun.cfg        = ReadSimCfg();
+        sRun.level.assign(sRun.total, 1);
+        sRun.workUs.reserve(size_t(seconds) * 20);
+        sRun.tickMs.reserve(size_t(seconds) * 20);
+        sRun.counters   = Storage().Counters();
+
+        SendMsg(handler, Msg::SimStarted, humans, bots, seconds,
+            sRun.cfg.loginsPerSec, sRun.cfg.levelUpsPerSec, sRun.cfg.commandsPerSec);
+        SendMsg(handler, Msg::SimScope);
+    }
+
+    void StopSimulation(ChatHandler* handler)
+    {
+        if (!sRun.active)
+        {
+            SendMsg(handler, Msg::SimNotRunning);
+            return;
+        }
+        FinishSimulation();
+    }
+}
+
+class RealOnlineLoadSimWS : public WorldScript
+{
+public:
+    RealOnlineLoadSimWS()
+        : WorldScript("RealOnlineLoadSimWS", std::vector<uint16>{ WORLDHOOK_ON_UPDATE }) {}
+
+    void OnUpdate(uint32 diff) override
+    {
+        if (RealOnline::sRun.active)
+            RealOnline::SimTick(diff);
+    }
+};
+
+void AddRealOnlineLoadSimScripts()
+{
+    new RealOnlineLoadSimWS();
+}
@@ -0,0 +1,58 @@
+// modules/mod-real-online/src/load_sim.h
+
+#ifndef MOD_REAL_ONLINE_LOAD_SIM_H
+#define MOD_REAL_ONLINE_LOAD_SIM_H
+
+#include "Define.h"
+
+#include <functional>
+
+class ChatHandler;
+
+// =============================
+// Simulátor zátěže (.realonline simulate)
+// =============================
+// Syntetické účty (bez Player/WorldSession) procházejí částí cest
+// skutečných hráčů: streak a načtení milníků při loginu, zápis milníků při
+// level-upu, výběr účtů, grant a flush playtime odměn, roster .online
+// (StandInRoster, roster_harness.h) a úložiště za .reward / .token.
+// Každý soubor si registruje driver pro své události, simulátor je rozkládá
+// do world ticků podle RealOnline.Sim.* a měří čas world threadu a round
+// tripy do úložiště.
+//
+// Co neměří (není Player ani session, běží uvnitř serveru):
+//   - procházení sessions (.online, sériový výběr účtů) a hráčů map
+//     v map threadech; filtr účtů běží nad náhradním rosterem
+//   - gettery Player (jméno, level, frakce, GM) a odeslání do chatu
+//   - level-upy z map threadů (fronta QueueLevelUp), jen přímé ProcessLevelUp
+//   - cesty s hráčem: doručení do tašek, maily, oznámení streaku a milníků
+// Běží jen nad paměťovým backendem (RealOnline.Storage.Backend) a ve
+// stejném procesu jako hráči – na živém serveru jejich ticky prodlužuje.
+namespace RealOnline
+{
+    enum class SimEvent : uint8
+    {
+        Login,       // arg = 0
+        Logout,      // arg = 0
+        LevelUp,     // arg = level před level-upem
+        RewardTick,  // jednou za interval, arg = počet online účtů; account = první z nich
+        Command,     // arg = náhodné číslo pro výběr příkazu
+        Count
+    };
+
+    // syntetické účty leží nad skutečnými ID, guid postavy = ID účtu
+    constexpr uint32 SimAccountBase = 0x7F000000;
+
+    using SimDriver = std::function<void(uint32 account, uint32 arg)>;
+
+    void RegisterSimDriver(SimEvent event, SimDriver driver);
+
+    // počet syntetických účtů online (stránkování .online driveru), 0 = simulace neběží
+    uint32 SimOnlineCount();
+
+    // requester = účet pro hlášení výsledku, 0 = konzole (log)
+    void StartSimulation(ChatHandler* handler, uint32 requester, uint32 humans, uint32 bots, uint32 seconds);
+    void StopSimulation(ChatHandler* handler);
+}
+
+#endif // MOD_REAL_ONLINE_LOAD_SIM_H
@@ -0,0 +1,407 @@
+// modules/mod-real-online/src/message_catalog.h
+
+#ifndef MOD_REAL_ONLINE_MESSAGE_CATALOG_H
+#define MOD_REAL_ONLINE_MESSAGE_CATALOG_H
+
+#include "core_types.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// =============================
+// Katalog zpráv (CZ/EN)
+// =============================
+// Každý jazyk je constexpr tabulka indexovaná Msg. Třetí jazyk = nová hodnota
+// v Lang, nová tabulka a řádek v Catalog; kontrolu pořadí a úplnosti dělá
+// static_assert. Jazyk se volí podle klienta session, fallback je RealOnline.Locale.
+namespace RealOnline
+{
+    enum class Lang : uint8
+    {
+        CS,
+        EN,
+        Count
+    };
+
+    enum class Msg : uint16
+    {
+        FactionAlliance,
+        FactionHorde,
+        FactionUnknown,
+
+        RangeFormat,
+        RangeDigits,
+        RangeInvalid,
+        RangeStartBeyond,
+        PageExpected,
+        PageStartsAtOne,
+        PageNotExist,
+        OnlineHeadPage,
+        OnlineHeadRange,
+
+        RewardDisabled,
+        SchemaNotReady,
+        RewardStatus,
+        RewardClaimHint,
+        RewardNothing,
+        RewardClaimNoSpace,
+        RewardStoreError,
+        RewardClaimed,
+        RewardUnknownParam,
+        RewardInventoryFull,
+        RewardInventoryFullMail,
+        RewardClaimedMail,
+        RewardMailSubject,
+        RewardMailBody,
+        GrantUsage,
+        GrantUnknownItem,
+        GrantNoTargets,
+        GrantDryRun,
+        GrantQueued,
+        GrantProgress,
+        GrantDone,
+
+        TokenStored,
+        TokenDepositUsage,
+        TokenNotEnoughInBags,
+        TokenDeposited,
+        TokenWithdrawUsage,
+        TokenNotEnoughStored,
+        TokenNoSpace,
+        TokenWithdrew,
+        TokenWithdrewMail,
+        TokenUnknownParam,
+        TokenBalance,
+        TokenVirtualOnly,
+        TokenWalletError,
+        VendorClosed,
+        VendorBalance,
+        VendorItem,
+        VendorNotEnough,
+        VendorBought,
+
+        MilestoneReached,
+
+        StreakBase,
+        StreakBonus,
+        StreakSeparate,
+        StreakUsage,
+        LeaderboardStreakHead,
+        LeaderboardTokensHead,
+        LeaderboardRow,
+        LeaderboardEmpty,
+
+        RateLimited,
+        StatsRateLimit,
+        StatsRewardSource,
+        StatsQueryBudget,
+        StatsBotAccounts,
+        StatsPlaytimeAfk,
+        SimUsage,
+        SimNeedsMemory,
+        SimBusy,
+        SimNotRunning,
+        SimStarted,
+        SimScope,
+        SimReportTicks,
+        SimReportEvents,
+        ReplayUsage,
+        ReplayFileError,
+        ReplayDone,
+        ReplayStreakTotals,
+        ReplayStreakSpread,
+        ReplayMilestoneTotals,
+
+        Count
+    };
+
+    struct MsgEntry
+    {
+        Msg id;
+        std::string_view text;
+    };
+
+    using MsgTable = std::array<MsgEntry, size_t(Msg::Count)>;
+
+    inline constexpr MsgTable MessagesCS =
+    {{
+        { Msg::FactionAlliance,      "Aliance" },
+        { Msg::FactionHorde,         "Horda" },
+        { Msg::FactionUnknown,       "Neznámá" },
+
+        { Msg::RangeFormat,          "Rozsah musí být ve tvaru A-B." },
+        { Msg::RangeDigits,          "Rozsah musí obsahovat pouze čísla." },
+        { Msg::RangeInvalid,         "Rozsah musí být A-B, A>=1, B>=A." },
+        { Msg::RangeStartBeyond,     "Začátek rozsahu je mimo počet online hráčů." },
+        { Msg::PageExpected,         "Očekávám číslo stránky nebo rozsah A-B." },
+        { Msg::PageStartsAtOne,      "Číslo stránky začíná od 1." },
+        { Msg::PageNotExist,         "Požadovaná stránka neexistuje. Celkem dostupných stránek: {}." },
+        { Msg::OnlineHeadPage,       "Skuteční hráči online: {} (stránka {}/{}, {} na stránku)" },
+        { Msg::OnlineHeadRange,      "Skuteční hráči online: {} (rozsah {}-{})" },
+
+        { Msg::RewardDisabled,       "Reward system je vypnutý." },
+        { Msg::SchemaNotReady,       "Databáze modulu se právě aktualizuje, zkus to prosím za chvíli." },
+        { Msg::RewardStatus,         "Celkem získáno: {} | Celkem vyzvednuto: {} | K dispozici: {}" },
+        { Msg::RewardClaimHint,      "Napiš \".reward claim\" pro výběr odměny." },
+        { Msg::RewardNothing,        "Nemáš nic k výběru." },
+        { Msg::RewardClaimNoSpace,   "Nemáš dost místa v taškách (výběr zrušen). Uvolni místo a zkus znovu." },
+        { Msg::RewardStoreError,     "Chyba při ukládání itemu do inventáře." },
+        { Msg::RewardClaimed,        "Vybráno: Mystery Token {}ks" },
+        { Msg::RewardUnknownParam,   "Neznámý parametr. Použij \".reward\" nebo \".reward claim\"." },
+        { Msg::RewardInventoryFull,  "Inventář je plný, odměna byla připsána na účet. Vyzvedni pomocí \".reward claim\"." },
+        { Msg::RewardInventoryFullMail, "Inventář je plný, odměna ({}ks) ti přijde poštou." },
+        { Msg::RewardClaimedMail,    "Vybráno: Mystery Token {}ks ({}ks přijde poštou, tašky jsou plné)" },
+        { Msg::RewardMailSubject,    "Odměna" },
+        { Msg::RewardMailBody,       "Tašky byly plné, tady je zbytek tvé odměny." },
+        { Msg::GrantUsage,           "Použití: .reward grant <item> <počet> online|range A-B|all-active [dry]" },
+        { Msg::GrantUnknownItem,     "Item {} neexistuje." },
+        { Msg::GrantNoTargets,       "Grant: žádné cílové účty." },
+        { Msg::GrantDryRun,          "Dry run: {} účtů by dostalo item {} ({}ks)." },
+        { Msg::GrantQueued,          "Grant #{}: {} účtů, item {} ({}ks) – zapisuje se." },
+        { Msg::GrantProgress,        "Grant #{}: zapsáno {}/{} účtů." },
+        { Msg::GrantDone,            "Grant #{} hotov: {} účtů." },
+
+        { Msg::TokenStored,          "Uskladněné tokeny: {}" },
+        { Msg::TokenDepositUsage,    "Zadej kladný počet: .token deposit <pocet>" },
+        { Msg::TokenNotEnoughInBags, "Nemáš dost tokenů v taškách. Máš {}." },
+        { Msg::TokenDeposited,       "Uloženo {} tokenů do úschovy." },
+        { Msg::TokenWithdrawUsage,   "Zadej kladný počet: .token withdraw <pocet>" },
+        { Msg::TokenNotEnoughStored, "Nemáš dost uskladněných tokenů. Máš {}." },
+        { Msg::TokenNoSpace,         "Nemáš dost místa v taškách. Uvolni místo a zkus znovu." },
+        { Msg::TokenWithdrew,        "Vybráno {} tokenů z úschovy." },
+        { Msg::TokenWithdrewMail,    "Vybráno {} tokenů z úschovy ({} přijde poštou, tašky jsou plné)." },
+        { Msg::TokenUnknownParam,    "Neznámý parametr. Použij \".token\", \".token deposit <pocet>\", nebo \".token withdraw <pocet>\"." },
+        { Msg::TokenBalance,         "Zůstatek tokenů: {} (virtuální, utrácí se u obchodníka s tokeny)" },
+        { Msg::TokenVirtualOnly,     "Tokeny jsou jen na účtu, do tašek se nevybírají. Zůstatek: {}" },
+        { Msg::TokenWalletError,     "Zůstatek tokenů teď nejde načíst ani změnit, nic nebylo strženo. Zkus to za chvíli." },
+        { Msg::VendorClosed,         "Obchodník s tokeny je zavřený." },
+        { Msg::VendorBalance,        "Tvůj zůstatek: {} tokenů" },
+        { Msg::VendorItem,           "{}x {} – {} tokenů" },
+        { Msg::VendorNotEnough,      "Nemáš dost tokenů, potřebuješ {}." },
+        { Msg::VendorBought,         "Koupeno {}x za {} tokenů." },
+
+        { Msg::MilestoneReached,     "Gratuluji! Dosáhl jsi {}. levelu a získáváš {}x Mystery Token." },
+
+        { Msg::StreakBase,           "Gratulace! {}. den v řadě z {}. Získáváš {}× Mystery Token." },
+        { Msg::StreakBonus,          "Gratulace! {}. den v řadě z {}. Získáváš {}× Mystery Token (včetně bonusu {}×)." },
+        { Msg::StreakSeparate,       "Gratulace! {}. den v řadě z {}. Získáváš {}× Mystery Token a navíc {}× Mystery Token." },
+        { Msg::StreakUsage,          "Použití: .streak top" },
+        { Msg::LeaderboardStreakHead, "Top {} – login streak (dny v řadě):" },
+        { Msg::LeaderboardTokensHead, "Top {} – nasbírané tokeny:" },
+        { Msg::LeaderboardRow,       "{}. {} – {}" },
+        { Msg::LeaderboardEmpty,     "Žebříček je zatím prázdný." },
+
+        { Msg::RateLimited,          "Příliš mnoho příkazů, zkus to za chvíli." },
+        { Msg::StatsRateLimit,       "Rate limit – odmítnuto: .online {} | .reward {} | .token {}" },
+        { Msg::StatsRewardSource,    "Odměny [{}]: grantů {}, itemů {}, do tašek {}, entitlement {}, fallback {}, mail {}" },
+        { Msg::StatsQueryBudget,     "DB rozpočet [{}]: volání {}, překročení {}, max blokujících {}, max ve frontě {}" },
+        { Msg::StatsBotAccounts,     "Boti z DB: {} účtů (nejvyšší ID {})" },
+        { Msg::StatsPlaytimeAfk,     "Playtime odměny: odměněno {}, přeskočeno jako AFK {} ({} %)" },
+        { Msg::SimUsage,             "Použití: .realonline simulate <lidé> <boti> <sekundy> | .realonline simulate stop" },
+        { Msg::SimNeedsMemory,       "Simulace běží jen s RealOnline.Storage.Backend = memory." },
+        { Msg::SimBusy,              "Simulace už běží (.realonline simulate stop)." },
+        { Msg::SimNotRunning,        "Žádná simulace neběží." },
+        { Msg::SimStarted,           "Simulace: {} lidí + {} botů na {} s (loginy {}/s, level-upy {}/s, příkazy {}/s)." },
+        { Msg::SimScope,             "Syntetické účty bez Player/WorldSession: filtr účtů a roster .online běží nad náhradním rosterem; neměří se procházení sessions a map threadů, doručení do tašek ani hlášky hráči." },
+        { Msg::SimReportTicks,       "Simulace: {} ticků, práce ve world threadu avg {} µs, p99 {} µs, max {} µs; world tick p99 {} ms, max {} ms" },
+        { Msg::SimReportEvents,      "Události: loginy {}, level-upy {}, příkazy {}, odměny {}; úložiště {} blocking + {} queued ({}/s)" },
+        { Msg::ReplayUsage,          "Použití: .realonline replay gen <účty> <dny> [% loginů za den] [seed] [Klíč=hodnota ...] | .realonline replay file <cesta> [Klíč=hodnota ...]" },
+        { Msg::ReplayFileError,      "Replay: soubor '{}' nelze otevřít." },
+        { Msg::ReplayDone,           "Replay: {} událostí (loginy {}, level-upy {}, přeskočeno řádků {}) za {} ms, {} událostí/s" },
+        { Msg::ReplayStreakTotals,   "Streak: odměn {} z {} loginů, resetů série {}; itemů {} (základ {}, bonus {}, samostatný bonus {})" },
+        { Msg::ReplayStreakSpread,   "Streak na účet ({} účtů): odměn p50 {} / p90 {}, itemů p50 {} / p90 {} / max {}; nejdelší série {} dní" },
+        { Msg::ReplayMilestoneTotals, "Milníky: odměn {} z {} level-upů, itemů {}, zastaveno limitem účtu {} ({} účtů)" },
+    }};
+
+    inline constexpr MsgTable MessagesEN =
+    {{
+        { Msg::FactionAlliance,      "Alliance" },
+        { Msg::FactionHorde,         "Horde" },
+        { Msg::FactionUnknown,       "Unknown" },
+
+        { Msg::RangeFormat,          "Range must be in the form A-B." },
+        { Msg::RangeDigits,          "Range must contain digits only." },
+        { Msg::RangeInvalid,         "Range must be A-B, A>=1, B>=A." },
+        { Msg::RangeStartBeyond,     "Range start is beyond online player count." },
+        { Msg::PageExpected,         "Expecting page number or A-B range." },
+        { Msg::PageStartsAtOne,      "Page number starts at 1." },
+        { Msg::PageNotExist,         "Requested page does not exist. Total pages: {}." },
+        { Msg::OnlineHeadPage,       "Real players online: {} (page {}/{}, {} per page)" },
+        { Msg::OnlineHeadRange,      "Real players online: {} (range {}-{})" },
+
+        { Msg::RewardDisabled,       "Reward system is disabled." },
+        { Msg::SchemaNotReady,       "The module database is being updated, please try again shortly." },
+        { Msg::RewardStatus,         "Total earned: {} | Total claimed: {} | Available: {}" },
+        { Msg::RewardClaimHint,      "Type \".reward claim\" to collect your reward." },
+        { Msg::RewardNothing,        "You have nothing to claim." },
+        { Msg::RewardClaimNoSpace,   "Not enough bag space (claim canceled). Free up space and try again." },
+        { Msg::RewardStoreError,     "Error storing item in inventory." },
+        { Msg::RewardClaimed,        "Claimed: Mystery Token {} pcs" },
+        { Msg::RewardUnknownParam,   "Unknown parameter. Use \".reward\" or \".reward claim\"." },
+        { Msg::RewardInventoryFull,  "Inventory is full, reward was credited to your account. Use \".reward claim\" to collect." },
+        { Msg::RewardInventoryFullMail, "Inventory is full, the reward ({} pcs) will arrive by mail." },
+        { Msg::RewardClaimedMail,    "Claimed: Mystery Token {} pcs ({} pcs sent by mail, bags are full)" },
+        { Msg::RewardMailSubject,    "Reward" },
+        { Msg::RewardMailBody,       "Your bags were full, here is the rest of your reward." },
+        { Msg::GrantUsage,           "Usage: .reward grant <item> <count> online|range A-B|all-active [dry]" },
+        { Msg::GrantUnknownItem,     "Item {} does not exist." },
+        { Msg::GrantNoTargets,       "Grant: no target accounts." },
+        { Msg::GrantDryRun,          "Dry run: {} account(s) would receive item {} ({} pcs)." },
+        { Msg::GrantQueued,          "Grant #{}: {} account(s), item {} ({} pcs) – writing." },
+        { Msg::GrantProgress,        "Grant #{}: written {}/{} account(s)." },
+        { Msg::GrantDone,            "Grant #{} done: {} account(s)." },
+
+        { Msg::TokenStored,          "Stored tokens: {}" },
+        { Msg::TokenDepositUsage,    "Enter a positive number: .token deposit <count>" },
+        { Msg::TokenNotEnoughInBags, "Not enough tokens in your bags. You have {}." },
+        { Msg::TokenDeposited,       "Deposited {} token(s) to storage." },
+        { Msg::TokenWithdrawUsage,   "Enter a positive number: .token withdraw <count>" },
+        { Msg::TokenNotEnoughStored, "Not enough stored tokens. You have {}." },
+        { Msg::TokenNoSpace,         "Not enough bag space. Free up space and try again." },
+        { Msg::TokenWithdrew,        "Withdrew {} token(s) from storage." },
+        { Msg::TokenWithdrewMail,    "Withdrew {} token(s) from storage ({} sent by mail, bags are full)." },
+        { Msg::TokenUnknownParam,    "Unknown parameter. Use \".token\", \".token deposit <count>\", or \".token withdraw <count>\"." },
+        { Msg::TokenBalance,         "Token balance: {} (virtual, spend it at the token vendor)" },
+        { Msg::TokenVirtualOnly,     "Tokens are kept on your account and are not put into bags. Balance: {}" },
+        { Msg::TokenWalletError,     "Your token balance cannot be read or changed right now, nothing was charged. Try again shortly." },
+        { Msg::VendorClosed,         "The token vendor is closed." },
+        { Msg::VendorBalance,        "Your balance: {} tokens" },
+        { Msg::VendorItem,           "{}x {} – {} tokens" },
+        { Msg::VendorNotEnough,      "Not enough tokens, you need {}." },
+        { Msg::VendorBought,         "Bought {}x for {} tokens." },
+
+        { Msg::MilestoneReached,     "Grats! You reached level {} and receive {}x Mystery Token." },
+
+        { Msg::StreakBase,           "Congrats! Day {} in a row out of {}. You receive {}× Mystery Token." },
+        { Msg::StreakBonus,          "Congrats! Day {} in a row out of {}. You receive {}× Mystery Token (including bonus {}×)." },
+        { Msg::StreakSeparate,       "Congrats! Day {} in a row out of {}. You receive {}× Mystery Token and additionally {}× Mystery Token." },
+        { Msg::StreakUsage,          "Usage: .streak top" },
+        { Msg::LeaderboardStreakHead, "Top {} – login streak (days in a row):" },
+        { Msg::LeaderboardTokensHead, "Top {} – lifetime tokens:" },
+        { Msg::LeaderboardRow,       "{}. {} – {}" },
+        { Msg::LeaderboardEmpty,     "The leaderboard is empty so far." },
+
+        { Msg::RateLimited,          "Too many commands, try again in a moment." },
+        { Msg::StatsRateLimit,       "Rate limit – rejected: .online {} | .reward {} | .token {}" },
+        { Msg::StatsRewardSource,    "Rewards [{}]: grants {}, items {}, inventory {}, entitlement {}, fallback {}, mail {}" },
+        { Msg::StatsQueryBudget,     "DB budget [{}]: calls {}, violations {}, max blocking {}, max queued {}" },
+        { Msg::StatsBotAccounts,     "Bot accounts from DB: {} (highest ID {})" },
+        { Msg::StatsPlaytimeAfk,     "Playtime rewards: {} rewarded, {} skipped as AFK ({} %)" },
+        { Msg::SimUsage,             "Usage: .realonline simulate <humans> <bots> <seconds> | .realonline simulate stop" },
+        { Msg::SimNeedsMemory,       "The simulation only runs with RealOnline.Storage.Backend = memory." },
+        { Msg::SimBusy,              "A simulation is already running (.realonline simulate stop)." },
+        { Msg::SimNotRunning,        "No simulation is running." },
+        { Msg::SimStarted,           "Simulation: {} humans + {} bots for {} s (logins {}/s, level-ups {}/s, commands {}/s)." },
+        { Msg::SimScope,             "Synthetic accounts without Player/WorldSession: the account filter and the .online roster run over a stand-in roster; the session and map-thread walks, bag delivery and player messages are not measured." },
+        { Msg::SimReportTicks,       "Simulation: {} ticks, world-thread work avg {} µs, p99 {} µs, max {} µs; world tick p99 {} ms, max {} ms" },
+        { Msg::SimReportEvents,      "Events: logins {}, level-ups {}, commands {}, rewards {}; storage {} blocking + {} queued ({}/s)" },
+        { Msg::ReplayUsage,          "Usage: .realonline replay gen <accounts> <days> [% logins per day] [seed] [Key=value ...] | .realonline replay file <path> [Key=value ...]" },
+        { Msg::ReplayFileError,      "Replay: cannot open file '{}'." },
+        { Msg::ReplayDone,           "Replay: {} events (logins {}, level-ups {}, skipped lines {}) in {} ms, {} events/s" },
+        { Msg::ReplayStreakTotals,   "Streak: {} rewards from {} logins, {} streak resets; {} items (base {}, bonus {}, separate bonus {})" },
+        { Msg::ReplayStreakSpread,   "Streak per account ({} accounts): rewards p50 {} / p90 {}, items p50 {} / p90 {} / max {}; longest run {} days" },
+        { Msg::ReplayMilestoneTotals, "Milestones: {} rewards from {} level-ups, {} items, {} stopped by the account cap ({} accounts)" },
+    }};
+
+    inline constexpr std::array<MsgTable const*, size_t(Lang::Count)> Catalog =
+    {{
+        &MessagesCS,
+        &MessagesEN,
+    }};
+
+    constexpr bool IsCompleteTable(MsgTable const& table)
+    {
+        for (size_t i = 0; i < table.size(); ++i)
+            if (size_t(table[i].id) != i || table[i].text.empty())
+                return false;
+        return true;
+    }
+
+    static_assert(IsCompleteTable(MessagesCS), "MessagesCS must list every Msg in enum order");
+    static_assert(IsCompleteTable(MessagesEN), "MessagesEN must list every Msg in enum order");
+
+    constexpr std::string_view MsgText(Msg id, Lang lang)
+    {
+        return (*Catalog[size_t(lang)])[size_t(id)].text;
+    }
+
+    // =============================
+    // Formátování bez alokací
+    // =============================
+    // Pevný buffer na zásobníku, "{}" v šabloně se postupně nahrazuje argumenty.
+    // Co se nevejde, se ořízne.
+    class MessageBuffer
+    {
+    public:
+        static constexpr size_t Capacity = 1024;
+
+        MessageBuffer() { _buf[0] = '\0'; }
+
+        void Clear() { _len = 0; _buf[0] = '\0'; }
+
+        size_t Size() const { return _len; }
+        size_t Remaining() const { return Capacity - 1 - _len; }
+        bool Empty() const { return _len == 0; }
+
+        char const* c_str() const { return _buf; }
+        std::string_view View() const { return { _buf, _len }; }
+
+        MessageBuffer& Append(std::string_view s)
+        {
+            size_t n = std::min(s.size(), Remaining());
+            std::memcpy(_buf + _len, s.data(), n);
+            _len += n;
+            _buf[_len] = '\0';
+            return *this;
+        }
+
+        MessageBuffer& Append(char const* s) { return Append(std::string_view(s)); }
+
+        template<typename Int, std::enable_if_t<std::is_integral_v<Int> && !std::is_same_v<Int, bool>, int> = 0>
+        MessageBuffer& Append(Int v)
+        {
+            char tmp[24];
+            auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+            return Append(std::string_view(tmp, size_t(res.ptr - tmp)));
+        }
+
+        template<typename... Args>
+        MessageBuffer& Format(std::string_view fmt, Args const&... args)
+        {
+            FormatImpl(fmt, args...);
+            return *this;
+        }
+
+        template<typename... Args>
+        MessageBuffer& Format(Msg id, Lang lang, Args const&... args)
+        {
+            return Format(MsgText(id, lang), args...);
+        }
+
+    private:
+        void FormatImpl(std::string_view fmt) { Append(fmt); }
+
+        template<typename Arg, typename... Rest>
+        void FormatImpl(std::string_view fmt, Arg const& arg, Rest const&... rest)
+        {
+            size_t pos = fmt.find("{}");
+            if (pos == std::string_view::npos)
+            {
+                Append(fmt);
+                return;
+            }
+            Append(fmt.substr(0, pos));
+            Append(arg);
+            FormatImpl(fmt.substr(pos + 2), rest...);
+        }
+
+        char   _buf[Capacity];
+        size_t _len = 0;
+    };
+}
+
+#endif // MOD_REAL_ONLINE_MESSAGE_CATALOG_H
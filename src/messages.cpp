@@ -0,0 +1,63 @@
+// modules/mod-real-online/src/messages.cpp
+
+#include "messages.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "WorldSession.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace RealOnline
+{
+    namespace
+    {
+        Lang sDefaultLang = Lang::CS;
+        bool sPerSession  = true;
+    }
+
+    Lang DefaultLang()
+    {
+        return sDefaultLang;
+    }
+
+    void LoadLocaleConfig()
+    {
+        std::string loc = sConfigMgr->GetOption<std::string>("RealOnline.Locale", "cs");
+        std::transform(loc.begin(), loc.end(), loc.begin(), ::tolower);
+        sDefaultLang = (loc == "en" || loc == "english") ? Lang::EN : Lang::CS;
+        sPerSession  = sConfigMgr->GetOption<bool>("RealOnline.Locale.PerSession", true);
+    }
+
+    Lang SessionLang(WorldSession const* session)
+    {
+        if (!sPerSession || !session)
+            return sDefaultLang;
+
+        // čeština klient nemá – enUS používají i čeští hráči, proto config;
+        // ostatní lokalizované klienty dostanou angličtinu
+        switch (session->GetSessionDbcLocale())
+        {
+            case LOCALE_enUS:
+                return sDefaultLang;
+            default:
+                return Lang::EN;
+        }
+    }
+}
+
+class RealOnlineLocaleWS : public WorldScript
+{
+public:
+    RealOnlineLocaleWS()
+        : WorldScript("RealOnlineLocaleWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD }) { }
+
+    void OnAfterConfigLoad(bool /*reload*/) override { RealOnline::LoadLocaleConfig(); }
+};
+
+void AddRealOnlineLocaleScripts()
+{
+    new RealOnlineLocaleWS();
+}
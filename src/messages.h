@@ -0,0 +1,32 @@
+// modules/mod-real-online/src/messages.h
+
+#ifndef MOD_REAL_ONLINE_MESSAGES_H
+#define MOD_REAL_ONLINE_MESSAGES_H
+
+#include "message_catalog.h"
+
+#include "Chat.h"
+
+class WorldSession;
+
+// Katalog a MessageBuffer jsou v message_catalog.h (bez jádra); tady je
+// volba jazyka podle session a odeslání do chatu.
+namespace RealOnline
+{
+    // RealOnline.Locale, načteno při loadu configu (messages.cpp)
+    Lang DefaultLang();
+    void LoadLocaleConfig();
+
+    // jazyk podle klienta session; enUS klient (i český hráč) -> RealOnline.Locale
+    Lang SessionLang(WorldSession const* session);
+
+    template<typename... Args>
+    inline void SendMsg(ChatHandler* handler, Msg id, Args const&... args)
+    {
+        MessageBuffer buf;
+        buf.Format(id, SessionLang(handler->GetSession()), args...);
+        handler->SendSysMessage(buf.View());
+    }
+}
+
+#endif // MOD_REAL_ONLINE_MESSAGES_H
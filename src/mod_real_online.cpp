@@ -1,3 +1,21 @@
+#include "autoupdate.h"
+#include "activity.h"
+#include "bot_accounts.h"
+#include "leaderboard.h"
+#include "load_sim.h"
+#include "query_budget.h"
+#include "replay.h"
+#include "messages.h"
+#include "rate_limit.h"
+#include "reward_grant.h"
+#include "reward_pipeline.h"
+#include "reward_storage.h"
+#include "roster_harness.h"
+#include "roster_view.h"
+#include "storage_ops.h"
+#include "text_parse.h"
+#include "token_wallet.h"
+
 #include "Config.h"
 #include "ScriptMgr.h"
 #include "World.h"
@@ -12,135 +30,53 @@
 #include "WorldSessionMgr.h"
 #include "DatabaseEnv.h"
 #include "Item.h"
-#include <unordered_set>
+#include "ObjectMgr.h"
+#include "Map.h"
 
 #include <vector>
 #include <string>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
-
-// =============================
-// Locale přepínač (CZ/EN) – čte RealOnline.Locale (cs|en)
-// =============================
-enum class Lang { CS, EN };
-static inline Lang LangOpt()
-{
-    std::string loc = sConfigMgr->GetOption<std::string>("RealOnline.Locale", "cs");
-    std::transform(loc.begin(), loc.end(), loc.begin(), ::tolower);
-    return (loc == "en" || loc == "english") ? Lang::EN : Lang::CS;
-}
-static inline char const* T(char const* cs, char const* en)
-{
-    return (LangOpt() == Lang::EN) ? en : cs;
-}
+#include <charconv>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+using RealOnline::Lang;
+using RealOnline::Msg;
+using RealOnline::MessageBuffer;
+using RealOnline::SendMsg;
+using RealOnline::Range;
+using RealOnline::ParseRanges;
+using RealOnline::InRanges;
+using RealOnline::ParseU32;
+using RealOnline::NextWord;
+using RealOnline::EqualsI;
+using RealOnline::Trim;
+using RealOnline::TrimView;
+using RealOnline::ParsePageOrRange;
+using RealOnline::RosterLine;
+using RealOnline::RenderRoster;
+using RealOnline::PlayerView;
+using RealOnline::EligibilityFilter;
+using RealOnline::Eligibility;
+using RealOnline::CheckEligibility;
 
 // =============================
 // Pomocné utility
 // =============================
-static inline std::string Trim(std::string s)
-{
-    auto notSpace = [](int ch){ return !std::isspace(ch); };
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), notSpace));
-    s.erase(std::find_if(s.rbegin(), s.rend(), notSpace).base(), s.end());
-    return s;
-}
-
-static const char* FactionNameFor(Player* p)
+static std::string_view FactionNameFor(Player* p, Lang lang)
 {
     switch (p->GetTeamId())
     {
-        case TEAM_ALLIANCE: return T("Aliance", "Alliance");
-        case TEAM_HORDE:    return T("Horda", "Horde");
-        default:            return T("Neznámá", "Unknown");
+        case TEAM_ALLIANCE: return RealOnline::MsgText(Msg::FactionAlliance, lang);
+        case TEAM_HORDE:    return RealOnline::MsgText(Msg::FactionHorde, lang);
+        default:            return RealOnline::MsgText(Msg::FactionUnknown, lang);
     }
 }
 
-struct Range { uint32 min=0, max=0; };
-
-static std::vector<Range> ParseRanges(std::string const& txt)
-{
-    std::vector<Range> out;
-    std::stringstream ss(txt);
-    std::string seg;
-    while (std::getline(ss, seg, ';'))
-    {
-        seg = Trim(seg);
-        if (seg.empty()) continue;
-        auto dash = seg.find('-');
-        if (dash == std::string::npos) continue;
-        std::string a = Trim(seg.substr(0, dash));
-        std::string b = Trim(seg.substr(dash + 1));
-        if (a.empty() || b.empty()) continue;
-        uint32 mn = uint32(std::stoul(a));
-        uint32 mx = uint32(std::stoul(b));
-        if (mn > mx) std::swap(mn, mx);
-        out.push_back({mn, mx});
-    }
-    return out;
-}
-
-static bool InRanges(uint32 id, std::vector<Range> const& rs)
-{
-    for (auto const& r : rs)
-        if (id >= r.min && id <= r.max)
-            return true;
-    return false;
-}
-
-// stránkování / rozsah A-B; výstup [begin, end) (EXCLUSIVE)
-static bool ParsePageOrRange(char const* args, uint32 total, uint32 pageSize,
-                             uint32& outBeginIndex, uint32& outEndIndex, std::string& err)
-{
-    outBeginIndex = 0; outEndIndex = 0;
-
-    if (!args || !*args)
-    {
-        outBeginIndex = 0;
-        outEndIndex   = std::min(pageSize, total);
-        return true;
-    }
-
-    std::string s = Trim(args);
-    auto dash = s.find('-');
-    if (dash != std::string::npos)
-    {
-        std::string a = Trim(s.substr(0, dash));
-        std::string b = Trim(s.substr(dash + 1));
-        if (a.empty() || b.empty()) { err = T("Rozsah musí být ve tvaru A-B.", "Range must be in the form A-B."); return false; }
-        if (!std::all_of(a.begin(), a.end(), ::isdigit) || !std::all_of(b.begin(), b.end(), ::isdigit))
-        { err = T("Rozsah musí obsahovat pouze čísla.", "Range must contain digits only."); return false; }
-        uint32 A = uint32(std::stoul(a));
-        uint32 B = uint32(std::stoul(b));
-        if (A == 0 || B == 0 || A > B) { err = T("Rozsah musí být A-B, A>=1, B>=A.", "Range must be A-B, A>=1, B>=A."); return false; }
-        if (A > total) { err = T("Začátek rozsahu je mimo počet online hráčů.", "Range start is beyond online player count."); return false; }
-        outBeginIndex = A - 1;
-        outEndIndex   = std::min(B, total);
-        return true;
-    }
-
-    if (!std::all_of(s.begin(), s.end(), ::isdigit))
-    { err = T("Očekávám číslo stránky nebo rozsah A-B.", "Expecting page number or A-B range."); return false; }
-
-    uint32 page = uint32(std::stoul(s));
-    if (page == 0) { err = T("Číslo stránky začíná od 1.", "Page number starts at 1."); return false; }
-
-    uint32 pages = (total + pageSize - 1) / pageSize;
-    if (pages == 0) pages = 1;
-    if (page > pages)
-    {
-        err = (LangOpt()==Lang::EN)
-            ? ("Requested page does not exist. Total pages: " + std::to_string(pages) + ".")
-            : ("Požadovaná stránka neexistuje. Celkem dostupných stránek: " + std::to_string(pages) + ".");
-        return false;
-    }
-
-    outBeginIndex = (page - 1) * pageSize;
-    outEndIndex   = std::min(outBeginIndex + pageSize, total);
-    return true;
-}
-
-
 // =============================
 // Detekce nového vs. starého chat API
 // =============================
@@ -167,8 +103,36 @@ static RealOnlineMode GetMode()
     return RealOnlineMode::AccountId;
 }
 
+// náhrada za Player* pro CheckEligibility (roster_view.h)
+static PlayerView ViewOf(Player* p, WorldSession* sess)
+{
+    PlayerView v;
+    v.account    = sess->GetAccountId();
+    v.level      = uint32(p->GetLevel());
+    v.inWorld    = p->IsInWorld();
+    v.gameMaster = p->IsGameMaster();
+    return v;
+}
+
+// filtr .online / playtime ticku; ignoreRanges a activeSince jen pro tick a hromadný grant
+static EligibilityFilter MakeEligibilityFilter(bool hideGMs, uint32 minLevel,
+                                               std::vector<Range> const* ignoreRanges = nullptr, uint32 activeSince = 0)
+{
+    EligibilityFilter f;
+    f.hideGMs       = hideGMs;
+    f.minLevel      = minLevel;
+    f.activeSince   = activeSince;
+    f.isBot         = &RealOnline::IsBotAccount;
+    f.isActiveSince = &RealOnline::IsActiveSince;
+    if (ignoreRanges)
+        f.ignoreRanges = *ignoreRanges;
+    return f;
+}
+
 static void BuildViaSessions(std::vector<Player*>& out, bool hideGMs, uint32 minLevel)
 {
+    EligibilityFilter const f = MakeEligibilityFilter(hideGMs, minLevel);
+
     auto const& sessions = sWorldSessionMgr->GetAllSessions();
     out.reserve(sessions.size());
 
@@ -176,14 +140,10 @@ static void BuildViaSessions(std::vector<Player*>& out, bool hideGMs, uint32 min
     {
         if (!sess) continue;
         Player* p = sess->GetPlayer();
-        if (!p || !p->IsInWorld()) continue;
-
-        if (hideGMs && p->IsGameMaster())
-            continue;
-        if (minLevel > 0 && p->GetLevel() < minLevel)
-            continue;
+        if (!p) continue;
 
-        out.push_back(p);
+        if (CheckEligibility(f, ViewOf(p, sess)) == Eligibility::Eligible)
+            out.push_back(p);
     }
 }
 
@@ -204,10 +164,12 @@ static void BuildViaAccountId(std::vector<Player*>& out, bool hideGMs, uint32 mi
             continue;
 
         WorldSession* sess = p->GetSession();
-        if (!ignoreAccRanges.empty() && sess)
+        if (sess)
         {
             uint32 accId = sess->GetAccountId();
-            if (InRanges(accId, ignoreAccRanges))
+            if (RealOnline::IsBotAccount(accId))
+                continue;
+            if (!ignoreAccRanges.empty() && InRanges(accId, ignoreAccRanges))
                 continue;
         }
 
@@ -215,6 +177,32 @@ static void BuildViaAccountId(std::vector<Player*>& out, bool hideGMs, uint32 mi
     }
 }
 
+// =============================
+// Config (.online) – načítá se při loadu configu, ne při každém příkazu
+// =============================
+struct OnlineCfg
+{
+    bool   showLevel = true;
+    bool   hideGMs   = false;
+    uint32 pageSize  = 10;
+    uint32 minLevel  = 0;
+    std::vector<Range> ignoreRanges;
+};
+
+static OnlineCfg sOnlineCfg;
+
+static void LoadOnlineCfg()
+{
+    OnlineCfg c;
+    c.showLevel    = sConfigMgr->GetOption<bool>("RealOnline.ShowLevel", true);
+    c.hideGMs      = sConfigMgr->GetOption<bool>("RealOnline.HideGMs", false);
+    c.pageSize     = sConfigMgr->GetOption<uint32>("RealOnline.PageSize", 10u);
+    c.minLevel     = sConfigMgr->GetOption<uint32>("RealOnline.MinLevel", 0u);
+    c.ignoreRanges = ParseRanges(sConfigMgr->GetOption<std::string>("RealOnline.IgnoreAccountIdRanges", ""));
+    if (c.pageSize == 0) c.pageSize = 10;
+    sOnlineCfg = std::move(c);
+}
+
 class RealOnlineCommand : public CommandScript {
 public:
     RealOnlineCommand() : CommandScript("RealOnlineCommand") {}
@@ -236,61 +224,50 @@ public:
 
     static bool HandleOnline(ChatHandler* handler, char const* args)
     {
-        bool   showLevel = sConfigMgr->GetOption<bool>("RealOnline.ShowLevel", true);
-        bool   hideGMs   = sConfigMgr->GetOption<bool>("RealOnline.HideGMs", false);
-        uint32 pageSize  = sConfigMgr->GetOption<uint32>("RealOnline.PageSize", 10u);
-        uint32 minLevel  = sConfigMgr->GetOption<uint32>("RealOnline.MinLevel", 0u);
-
-        if (pageSize == 0) pageSize = 10;
-
-		std::vector<Player*> list;
-		BuildViaSessions(list, hideGMs, minLevel);
-		
-		std::sort(list.begin(), list.end(),
-				[](Player* a, Player* b){ return a->GetName() < b->GetName(); });
-		
-		uint32 total = uint32(list.size());
-		
-		uint32 beginIndex = 0, endIndex = 0;
-		std::string err;
-		if (!ParsePageOrRange(args, total, pageSize, beginIndex, endIndex, err))
-		{
-			handler->SendSysMessage(err.c_str());
-			return true;
-		}
-		
-		uint32 pages = (total + pageSize - 1) / pageSize;
-		if (pages == 0) pages = 1;
-		
-		bool lookedLikeRange = (args && std::string(args).find('-') != std::string::npos);
-		std::ostringstream head;
-		if (!lookedLikeRange)
-		{
-			uint32 page = (pageSize == 0) ? 1 : (beginIndex / pageSize + 1);
-			head << (LangOpt()==Lang::EN ? "Real players online: " : "Skuteční hráči online: ") << total
-				<< (LangOpt()==Lang::EN ? " (page " : " (stránka ") << page << "/" << pages
-				<< (LangOpt()==Lang::EN ? ", " : ", ")
-				<< pageSize << (LangOpt()==Lang::EN ? " per page)" : " na stránku)");
-		}
-		else
-		{
-			head << (LangOpt()==Lang::EN ? "Real players online: " : "Skuteční hráči online: ") << total
-				<< (LangOpt()==Lang::EN ? " (range " : " (rozsah ") << (beginIndex + 1) << "-" << endIndex << ")";
-		}
-		handler->SendSysMessage(head.str().c_str());
-		
-		std::ostringstream out;
-		for (uint32 i = beginIndex; i < endIndex; ++i)
-		{
-			Player* p = list[i];
-			out << p->GetName();
-			if (showLevel)
-				out << " [lvl " << uint32(p->GetLevel()) << "]";
-			out << " - " << FactionNameFor(p) << "\n";
-		}
-		handler->SendSysMessage(out.str().c_str());
-		return true;
-	}
+        if (!RealOnline::CheckCommandRate(handler, RealOnline::RateLimitedCommand::Online))
+            return true;
+
+        OnlineCfg const& cfg = sOnlineCfg;
+        uint32 pageSize = cfg.pageSize;
+        Lang lang = RealOnline::SessionLang(handler->GetSession());
+
+        // roster se přestaví při každém volání, kapacita zůstává
+        static std::vector<Player*> list;
+        list.clear();
+        BuildViaSessions(list, cfg.hideGMs, cfg.minLevel);
+
+        RealOnline::SortRoster(list, [](Player* p) -> std::string const& { return p->GetName(); });
+
+        uint32 total = uint32(list.size());
+
+        std::string_view argv = args ? std::string_view(args) : std::string_view();
+        uint32 beginIndex = 0, endIndex = 0, errArg = 0;
+        Msg err = Msg::PageExpected;
+        if (!ParsePageOrRange(argv, total, pageSize, beginIndex, endIndex, err, errArg))
+        {
+            if (err == Msg::PageNotExist)
+                SendMsg(handler, err, errArg);
+            else
+                SendMsg(handler, err);
+            return true;
+        }
+
+        MessageBuffer head;
+        RealOnline::FormatRosterHead(head, lang, argv, total, pageSize, beginIndex, endIndex);
+        handler->SendSysMessage(head.View());
+
+        static std::vector<RosterLine> lines;
+        lines.clear();
+        for (uint32 i = beginIndex; i < endIndex; ++i)
+        {
+            Player* p = list[i];
+            lines.push_back({ p->GetName(), uint32(p->GetLevel()), FactionNameFor(p, lang) });
+        }
+
+        RenderRoster(lines.data(), lines.size(), cfg.showLevel,
+            [handler](std::string_view chunk){ handler->SendSysMessage(chunk); });
+        return true;
+    }
 };
 
 // =============================
@@ -303,6 +280,8 @@ struct RewardCfg
     uint32 itemId = 0;
     uint32 intervalMs = 60000;
     uint32 minLevel = 0;
+    bool   mapThreadEligibility = true;
+    uint32 afkSeconds = 900; // 0 = odměna i bez aktivity
 };
 
 static inline uint32 ReadIntervalMs()
@@ -322,63 +301,258 @@ static inline uint32 ReadIntervalMs()
     return uint32(total);
 }
 
-static RewardCfg GetRewardCfg()
+static RewardCfg sRewardCfg;
+
+static RewardCfg const& GetRewardCfg()
+{
+    return sRewardCfg;
+}
+
+static void LoadRewardCfg()
 {
-    RewardCfg c;
+    RewardCfg& c = sRewardCfg;
     c.enable     = sConfigMgr->GetOption<bool>("RealOnline.Reward.Enable", false);
     c.itemId     = sConfigMgr->GetOption<uint32>("RealOnline.Reward.ItemId", 0u);
     c.intervalMs = ReadIntervalMs();
     c.minLevel   = sConfigMgr->GetOption<uint32>("RealOnline.Reward.MinLevel", 0u);
-    return c;
+    c.mapThreadEligibility = sConfigMgr->GetOption<bool>("RealOnline.Reward.MapThreadEligibility", true);
+    c.afkSeconds = sConfigMgr->GetOption<uint32>("RealOnline.Reward.AfkMinutes", 15u) * 60;
 }
 
-static void CollectOnlineRealAccountIds(std::vector<uint32>& out, bool hideGMs, uint32 minLevel)
+// aktivní od (RealOnline::Now() sekundy), 0 = bez AFK filtru
+static uint32 RewardActiveSince(RewardCfg const& cfg)
+{
+    if (!cfg.afkSeconds)
+        return 0;
+    uint32 now = uint32(RealOnline::Now());
+    return now > cfg.afkSeconds ? now - cfg.afkSeconds : 0;
+}
+
+// playtime ticky od startu: odměněné účty / přeskočené kvůli AFK
+static uint64 sPlaytimeRewarded  = 0;
+static uint64 sPlaytimeAfkSkipped = 0;
+
+// activeSince != 0 -> AFK účty se vynechají a přičtou do afkSkipped
+static void CollectOnlineRealAccountIds(std::vector<uint32>& out, bool hideGMs, uint32 minLevel,
+                                        uint32 activeSince = 0, uint32* afkSkipped = nullptr)
 {
     out.clear();
 
-    std::vector<Player*> list;
-    BuildViaSessions(list, hideGMs, minLevel);
+    EligibilityFilter const f = MakeEligibilityFilter(hideGMs, minLevel, &sOnlineCfg.ignoreRanges, activeSince);
+
+    // sessions jsou po účtech -> účty se neopakují
+    auto const& sessions = sWorldSessionMgr->GetAllSessions();
+    out.reserve(sessions.size());
+
+    for (auto const& [accId, sess] : sessions)
+    {
+        if (!sess) continue;
+        Player* p = sess->GetPlayer();
+        if (!p) continue;
 
-    std::vector<Range> blockedRanges = ParseRanges(
-        sConfigMgr->GetOption<std::string>("RealOnline.IgnoreAccountIdRanges", "")
-    );
+        switch (CheckEligibility(f, ViewOf(p, sess)))
+        {
+            case Eligibility::Eligible:
+                out.push_back(sess->GetAccountId());
+                break;
+            case Eligibility::Afk:
+                if (afkSkipped)
+                    ++*afkSkipped;
+                break;
+            case Eligibility::Excluded:
+                break;
+        }
+    }
+}
 
-    std::unordered_set<uint32> uniq;
-    uniq.reserve(list.size() * 2 + 8);
 
-    for (Player* p : list)
+// =============================
+// Nárok na playtime odměnu v map threadech
+// =============================
+// Ticker si o seznam účtů řekne jeden world tick předem: každá mapa ve svém
+// updatu (map thread, MapUpdate.Threads) projde své hráče se stejnými filtry
+// jako CollectOnlineRealAccountIds a zapíše účty do bufferu svého threadu.
+// World thread po dokončení update map buffery jen slije.
+//
+// Worldport (přesun mezi mapami) běží ve world threadu, během update map
+// hráč patří právě jedné mapě -> seznamy se nepřekrývají, deduplikace netřeba.
+
+struct EligibilityBuffer
+{
+    uint32 generation = 0;
+    uint32 afkSkipped = 0;
+    std::vector<uint32> accounts;
+};
+
+static std::atomic<uint32> sEligibilityRequest{ 0 }; // generace žádosti, 0 = nic nečeká
+static std::atomic<uint32> sEligibilitySeen{ 0 };    // generace, kterou vyhodnotil aspoň jeden update map
+static EligibilityFilter   sEligibilityFilter;       // mění jen world thread, nikdy během update map
+
+// buffer na map thread; registrace jednou za život threadu
+static std::mutex sEligibilityBuffersLock;
+static std::vector<std::unique_ptr<EligibilityBuffer>> sEligibilityBuffers;
+static thread_local EligibilityBuffer* tEligibilityBuffer = nullptr;
+
+static EligibilityBuffer& ThreadEligibilityBuffer()
+{
+    if (!tEligibilityBuffer)
     {
-        if (!p || !p->IsInWorld())
-            continue;
-        if (hideGMs && p->IsGameMaster())
-            continue;
-        if (minLevel > 0 && p->GetLevel() < minLevel)
-            continue;
+        std::lock_guard<std::mutex> guard(sEligibilityBuffersLock);
+        sEligibilityBuffers.push_back(std::make_unique<EligibilityBuffer>());
+        tEligibilityBuffer = sEligibilityBuffers.back().get();
+    }
+    return *tEligibilityBuffer;
+}
+
+class RealOnlineEligibilityMapScript : public AllMapScript
+{
+public:
+    RealOnlineEligibilityMapScript() : AllMapScript("RealOnlineEligibilityMapScript") {}
+
+    void OnMapUpdate(Map* map, uint32 /*diff*/) override
+    {
+        uint32 gen = sEligibilityRequest.load(std::memory_order_acquire);
+        if (!gen)
+            return;
+        sEligibilitySeen.store(gen, std::memory_order_relaxed);
+
+        if (!map || !map->HavePlayers())
+            return;
 
-        if (WorldSession* s = p->GetSession())
+        EligibilityBuffer& buf = ThreadEligibilityBuffer();
+        if (buf.generation != gen)
         {
-            uint32 acc = s->GetAccountId();
+            buf.generation = gen;
+            buf.afkSkipped = 0;
+            buf.accounts.clear();
+        }
 
-            if (!blockedRanges.empty() && InRanges(acc, blockedRanges))
+        EligibilityFilter const& f = sEligibilityFilter;
+        Map::PlayerList const& players = map->GetPlayers();
+        for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        {
+            Player* p = itr->GetSource();
+            WorldSession* sess = p ? p->GetSession() : nullptr;
+            if (!sess)
                 continue;
 
-            if (uniq.insert(acc).second)
-                out.push_back(acc);
+            switch (CheckEligibility(f, ViewOf(p, sess)))
+            {
+                case Eligibility::Eligible:
+                    buf.accounts.push_back(sess->GetAccountId());
+                    break;
+                case Eligibility::Afk:
+                    ++buf.afkSkipped;
+                    break;
+                case Eligibility::Excluded:
+                    break;
+            }
         }
     }
+};
+
+// world thread, mimo update map
+static uint32 RequestEligibility(bool hideGMs, uint32 minLevel, uint32 activeSince)
+{
+    static uint32 sGeneration = 0;
+    if (++sGeneration == 0)
+        sGeneration = 1;
+
+    sEligibilityFilter = MakeEligibilityFilter(hideGMs, minLevel, &sOnlineCfg.ignoreRanges, activeSince);
+    sEligibilityRequest.store(sGeneration, std::memory_order_release);
+    return sGeneration;
+}
+
+// false = žádný update map od žádosti ještě neproběhl
+static bool CollectEligibility(uint32 gen, std::vector<uint32>& out, uint32& afkSkipped)
+{
+    // update map skončil před WorldScript::OnUpdate (MapMgr čeká na map thready)
+    if (sEligibilitySeen.load(std::memory_order_relaxed) != gen)
+        return false;
+
+    sEligibilityRequest.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> guard(sEligibilityBuffersLock);
+    out.clear();
+    for (auto const& buf : sEligibilityBuffers)
+    {
+        if (buf->generation != gen)
+            continue;
+        out.insert(out.end(), buf->accounts.begin(), buf->accounts.end());
+        afkSkipped += buf->afkSkipped;
+    }
+    return true;
 }
 
+static void CancelEligibility()
+{
+    sEligibilityRequest.store(0, std::memory_order_relaxed);
+}
+
+// Playtime tick nad hotovým seznamem účtů (ticker i driver simulátoru).
+// AFK účty se do seznamu vůbec nedostanou -> žádný zápis entitlementu
+static void GrantPlaytime(std::vector<uint32> const& accounts, uint32 itemId, uint32 afkSkipped)
+{
+    sPlaytimeRewarded   += accounts.size();
+    sPlaytimeAfkSkipped += afkSkipped;
+    if (afkSkipped)
+        LOG_DEBUG("module", "[reward] Playtime tick: {} account(s) rewarded, {} skipped as AFK.", accounts.size(), afkSkipped);
+
+    if (accounts.empty())
+        return;
+
+    RealOnline::QueryBudgetScope budget(RealOnline::BudgetOp::RewardTick);
+    budget.AddUnits(uint32(accounts.size()));
+
+    for (uint32 acc : accounts)
+        RealOnline::Grant<RealOnline::PlaytimeSource>(nullptr, acc, itemId, 1);
+
+    RealOnline::FlushRewardGrants();
+}
 
 class RealOnlineRewardTicker : public WorldScript
 {
 public:
     RealOnlineRewardTicker() : WorldScript("RealOnlineRewardTicker") {}
 
+    // o tolik může odměna čekat na update map, pak se seznam sestaví sériově
+    static constexpr uint32 EligibilityTimeoutMs = 2000;
+
     void OnUpdate(uint32 diff) override
     {
-        RewardCfg cfg = GetRewardCfg();
-        if (!cfg.enable || cfg.itemId == 0)
+        RewardCfg const& cfg = GetRewardCfg();
+        if (!cfg.enable || cfg.itemId == 0 || !RealOnline::IsCustomsSchemaReady())
+        {
+            if (_pending)
+                CancelEligibility();
+            _pending = 0;
             return;
+        }
+
+        uint32 minLevel = std::max(cfg.minLevel, sOnlineCfg.minLevel);
+
+        if (_pending)
+        {
+            std::vector<uint32> accounts;
+            uint32 afkSkipped = 0;
+            if (CollectEligibility(_pending, accounts, afkSkipped))
+            {
+                _pending = 0;
+                GrantPlaytime(accounts, cfg.itemId, afkSkipped);
+                return;
+            }
+
+            _waited += diff;
+            if (_waited < EligibilityTimeoutMs)
+                return;
+
+            CancelEligibility();
+            _pending = 0;
+            LOG_WARN("module", "[reward] No map update within {} ms, collecting eligible accounts on the world thread.", EligibilityTimeoutMs);
+            CollectOnlineRealAccountIds(accounts, sOnlineCfg.hideGMs, minLevel, RewardActiveSince(cfg), &afkSkipped);
+            GrantPlaytime(accounts, cfg.itemId, afkSkipped);
+            return;
+        }
 
         _elapsed += diff;
         if (_elapsed < cfg.intervalMs)
@@ -386,27 +560,23 @@ public:
 
         _elapsed = 0;
 
-        std::vector<uint32> accounts;
-        CollectOnlineRealAccountIds(accounts,
-            sConfigMgr->GetOption<bool>("RealOnline.HideGMs", false),
-            std::max(cfg.minLevel, sConfigMgr->GetOption<uint32>("RealOnline.MinLevel", 0u))
-        );
-
-        if (accounts.empty())
-            return;
-
-        for (uint32 acc : accounts)
+        if (cfg.mapThreadEligibility)
         {
-			std::string q =
-				"INSERT INTO customs.rewards (`account`,`item`,`entitled`,`claimed`,`stored`) "
-				"VALUES (" + std::to_string(acc) + "," + std::to_string(cfg.itemId) + ",1,0,0) "
-				"ON DUPLICATE KEY UPDATE `entitled` = `entitled` + 1, updated_at = NOW()";
-            CharacterDatabase.DirectExecute(q.c_str());
+            _pending = RequestEligibility(sOnlineCfg.hideGMs, minLevel, RewardActiveSince(cfg));
+            _waited  = 0;
+            return;
         }
+
+        std::vector<uint32> accounts;
+        uint32 afkSkipped = 0;
+        CollectOnlineRealAccountIds(accounts, sOnlineCfg.hideGMs, minLevel, RewardActiveSince(cfg), &afkSkipped);
+        GrantPlaytime(accounts, cfg.itemId, afkSkipped);
     }
 
 private:
     uint32 _elapsed = 0;
+    uint32 _pending = 0; // generace žádosti o seznam z map threadů
+    uint32 _waited  = 0;
 };
 
 class RewardCommand : public CommandScript
@@ -419,7 +589,7 @@ public:
     {
         static ChatCommandTable table =
         {
-            { "reward", HandleReward, SEC_PLAYER, Console::No }
+            { "reward", HandleReward, SEC_PLAYER, Console::Yes }
         };
         return table;
     }
@@ -427,113 +597,196 @@ public:
     std::vector<ChatCommand> GetCommands() const override
     {
         static std::vector<ChatCommand> cmds;
-        cmds.push_back({ "reward", SEC_PLAYER, false, &HandleReward, "" });
+        cmds.push_back({ "reward", SEC_PLAYER, true, &HandleReward, "" });
         return cmds;
     }
 #endif
 
     static bool HandleReward(ChatHandler* handler, char const* args)
     {
+        if (!RealOnline::IsCustomsSchemaReady())
+        {
+            SendMsg(handler, Msg::SchemaNotReady);
+            return true;
+        }
+
+        std::string_view rest;
+        std::string_view sub = NextWord(args ? args : "", rest);
+
+        if (EqualsI(sub, "grant"))
+            return HandleGrant(handler, rest);
+
         Player* plr = handler->GetSession() ? handler->GetSession()->GetPlayer() : nullptr;
         if (!plr)
             return true;
 
-        RewardCfg cfg = GetRewardCfg();
+        RewardCfg const& cfg = GetRewardCfg();
         if (!cfg.enable || cfg.itemId == 0)
         {
-            handler->SendSysMessage(T("Reward system je vypnutý.", "Reward system is disabled."));
+            SendMsg(handler, Msg::RewardDisabled);
             return true;
         }
 
-        std::string sub = args ? Trim(args) : "";
-        std::transform(sub.begin(), sub.end(), sub.begin(), ::tolower);
-
-        uint32 acc = handler->GetSession()->GetAccountId();
+        if (!RealOnline::CheckCommandRate(handler, RealOnline::RateLimitedCommand::Reward))
+            return true;
 
-        uint32 entitled = 0, claimed = 0;
+        if (EqualsI(sub, "top") && rest.empty())
         {
-            std::string q =
-                "SELECT entitled, claimed FROM customs.rewards "
-                "WHERE account=" + std::to_string(acc) +
-                " AND item=" + std::to_string(cfg.itemId) + " LIMIT 1";
-            if (QueryResult res = CharacterDatabase.Query(q.c_str()))
-            {
-                Field* f = res->Fetch();
-                entitled = f[0].Get<uint32>();
-                claimed  = f[1].Get<uint32>();
-            }
+            RealOnline::ShowLeaderboard(handler, RealOnline::Leaderboard::Tokens);
+            return true;
         }
 
-        uint32 available = (entitled > claimed) ? (entitled - claimed) : 0;
+        uint32 acc = handler->GetSession()->GetAccountId();
+
+        RealOnline::QueryBudgetScope budget(EqualsI(sub, "claim") ? RealOnline::BudgetOp::RewardClaim : RealOnline::BudgetOp::Reward);
 
-        if (sub.empty())
+        // virtuální tokeny: žádný výběr do tašek, jen zůstatek
+        if (RealOnline::IsVirtualToken(cfg.itemId) && (sub.empty() || (EqualsI(sub, "claim") && rest.empty())))
         {
-            std::ostringstream msg;
-            if (LangOpt()==Lang::EN)
-            {
-                msg << "Total earned: " << entitled
-                    << " | Total claimed: " << claimed
-                    << " | Available: " << available;
-                handler->SendSysMessage(msg.str().c_str());
-                handler->SendSysMessage("Type \".reward claim\" to collect your reward.");
-            }
+            uint32 balance = 0;
+            if (!RealOnline::GetTokenBalance(acc, balance))
+                SendMsg(handler, Msg::TokenWalletError);
             else
-            {
-                msg << "Celkem získáno: " << entitled
-                    << " | Celkem vyzvednuto: " << claimed
-                    << " | K dispozici: " << available;
-                handler->SendSysMessage(msg.str().c_str());
-                handler->SendSysMessage("Napiš \".reward claim\" pro výběr odměny.");
-            }
+                SendMsg(handler, sub.empty() ? Msg::TokenBalance : Msg::TokenVirtualOnly, balance);
             return true;
         }
 
-        if (sub == "claim")
+        if (sub.empty())
         {
-            if (available == 0)
+            RealOnline::RewardStatus st;
+            if (!RealOnline::ReadRewardStatus(RealOnline::Storage(), acc, cfg.itemId, st))
             {
-                handler->SendSysMessage(T("Nemáš nic k výběru.", "You have nothing to claim."));
+                SendMsg(handler, Msg::RewardStoreError);
                 return true;
             }
 
-            uint32 countToGive = available;
+            SendMsg(handler, Msg::RewardStatus, st.entitled, st.claimed, st.available);
+            SendMsg(handler, Msg::RewardClaimHint);
+            return true;
+        }
 
-            ItemPosCountVec dest;
-            InventoryResult canStore = plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, cfg.itemId, countToGive);
-            if (canStore != EQUIP_ERR_OK)
+        if (EqualsI(sub, "claim") && rest.empty())
+        {
+            uint32 mailed = 0, claimed = 0;
+            auto deliver = [&](uint32 count)
             {
-                handler->SendSysMessage(T(
-                    "Nemáš dost místa v taškách (výběr zrušen). Uvolni místo a zkus znovu.",
-                    "Not enough bag space (claim canceled). Free up space and try again."
-                ));
+                // s Overflow = mail se zbytek pošle poštou, jinak celé nebo nic
+                if (!RealOnline::OverflowToMail())
+                {
+                    ItemPosCountVec dest;
+                    if (plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, cfg.itemId, count) != EQUIP_ERR_OK)
+                    {
+                        SendMsg(handler, Msg::RewardClaimNoSpace);
+                        return false;
+                    }
+                }
+
+                if (!RealOnline::StoreRewardItemOrMail(plr, cfg.itemId, count, mailed))
+                {
+                    SendMsg(handler, Msg::RewardStoreError);
+                    return false;
+                }
                 return true;
-            }
+            };
 
-            if (Item* it = plr->StoreNewItem(dest, cfg.itemId, true, Item::GenerateItemRandomPropertyId(cfg.itemId)))
+            switch (RealOnline::ClaimEntitlement(RealOnline::Storage(), acc, cfg.itemId, deliver, claimed))
             {
-                plr->SendNewItem(it, countToGive, true, false);
-
-                std::string up =
-					"INSERT INTO customs.rewards (`account`,`item`,`entitled`,`claimed`,`stored`) "
-					"VALUES (" + std::to_string(acc) + "," + std::to_string(cfg.itemId) + ",0," + std::to_string(countToGive) + ",0) "
-					"ON DUPLICATE KEY UPDATE `claimed` = `claimed` + VALUES(`claimed`), updated_at = NOW()";
-                CharacterDatabase.DirectExecute(up.c_str());
-
-                std::ostringstream ok;
-                ok << (LangOpt()==Lang::EN ? "Claimed: Mystery Token " : "Vybráno: Mystery Token ")
-                   << countToGive << (LangOpt()==Lang::EN ? " pcs" : "ks");
-                handler->SendSysMessage(ok.str().c_str());
+                case RealOnline::LedgerResult::StoreError:
+                    SendMsg(handler, Msg::RewardStoreError);
+                    return true;
+                case RealOnline::LedgerResult::Nothing:
+                    SendMsg(handler, Msg::RewardNothing);
+                    return true;
+                case RealOnline::LedgerResult::NotRecorded:
+                    LOG_ERROR("module", "[reward] Claim of {}x {} by account {} delivered but not recorded ({} storage).",
+                        claimed, cfg.itemId, acc, RealOnline::Storage().Name());
+                    break;
+                case RealOnline::LedgerResult::Ok:
+                    break;
+                default:
+                    return true; // hlášku poslal deliver
             }
+
+            if (mailed)
+                SendMsg(handler, Msg::RewardClaimedMail, claimed, mailed);
             else
+                SendMsg(handler, Msg::RewardClaimed, claimed);
+            return true;
+        }
+
+        SendMsg(handler, Msg::RewardUnknownParam);
+        return true;
+    }
+
+    // .reward grant <item> <count> online|range A-B|all-active [dry] – GM / konzole
+    static bool HandleGrant(ChatHandler* handler, std::string_view args)
+    {
+        WorldSession* session = handler->GetSession();
+        if (session && session->GetSecurity() < SEC_GAMEMASTER)
+        {
+            SendMsg(handler, Msg::RewardUnknownParam);
+            return true;
+        }
+
+        std::string_view rest;
+        std::string_view itemW   = NextWord(args, rest);
+        std::string_view countW  = NextWord(rest, rest);
+        std::string_view targetW = NextWord(rest, rest);
+
+        RealOnline::BulkGrantRequest req;
+        if (!ParseU32(itemW, req.itemId) || !ParseU32(countW, req.count) || req.count == 0)
+        {
+            SendMsg(handler, Msg::GrantUsage);
+            return true;
+        }
+
+        if (!sObjectMgr->GetItemTemplate(req.itemId))
+        {
+            SendMsg(handler, Msg::GrantUnknownItem, req.itemId);
+            return true;
+        }
+
+        if (EqualsI(targetW, "online"))
+            req.target = RealOnline::GrantTarget::Online;
+        else if (EqualsI(targetW, "all-active"))
+            req.target = RealOnline::GrantTarget::AllActive;
+        else if (EqualsI(targetW, "range"))
+        {
+            req.target = RealOnline::GrantTarget::Range;
+            std::string_view rangeW = NextWord(rest, rest);
+            size_t dash = rangeW.find('-');
+            if (dash == std::string_view::npos
+                || !ParseU32(rangeW.substr(0, dash), req.rangeMin)
+                || !ParseU32(rangeW.substr(dash + 1), req.rangeMax)
+                || req.rangeMin > req.rangeMax)
             {
-                handler->SendSysMessage(T("Chyba při ukládání itemu do inventáře.", "Error storing item in inventory."));
+                SendMsg(handler, Msg::GrantUsage);
+                return true;
             }
+        }
+        else
+        {
+            SendMsg(handler, Msg::GrantUsage);
+            return true;
+        }
 
+        std::string_view flag = NextWord(rest, rest);
+        if (!rest.empty() || (!flag.empty() && !EqualsI(flag, "dry")))
+        {
+            SendMsg(handler, Msg::GrantUsage);
             return true;
         }
+        req.dryRun    = !flag.empty();
+        req.requester = session ? session->GetAccountId() : 0;
+
+        // stejné filtry jako playtime ticker (ignore ranges, GM, min level)
+        if (req.target == RealOnline::GrantTarget::Online)
+            CollectOnlineRealAccountIds(req.accounts, sOnlineCfg.hideGMs, sOnlineCfg.minLevel);
+        else
+            for (Range const& r : sOnlineCfg.ignoreRanges)
+                req.ignore.emplace_back(r.min, r.max);
 
-        handler->SendSysMessage(T("Neznámý parametr. Použij \".reward\" nebo \".reward claim\".",
-                                  "Unknown parameter. Use \".reward\" or \".reward claim\"."));
+        RealOnline::StartBulkGrant(std::move(req));
         return true;
     }
 };
@@ -564,181 +817,422 @@ public:
     }
 #endif
 
-    static uint32 ReadStored(uint32 acc, uint32 itemId)
-	{
-		std::string q = "SELECT `stored` FROM customs.rewards WHERE account="
-					+ std::to_string(acc) + " AND item=" + std::to_string(itemId) + " LIMIT 1";
-		if (QueryResult r = CharacterDatabase.Query(q.c_str()))
-			return r->Fetch()[0].Get<uint32>();
-		return 0;
-	}
-
-    static void UpsertAddStored(uint32 acc, uint32 itemId, uint32 add)
-	{
-		std::string up =
-			"INSERT INTO customs.rewards (`account`,`item`,`entitled`,`claimed`,`stored`) VALUES ("
-			+ std::to_string(acc) + "," + std::to_string(itemId) + ",0,0," + std::to_string(add) + ") "
-			"ON DUPLICATE KEY UPDATE `stored` = `stored` + VALUES(`stored`), updated_at = NOW()";
-		CharacterDatabase.DirectExecute(up.c_str());
-	}
-
-
     static bool HandleToken(ChatHandler* handler, char const* args)
     {
         Player* plr = handler->GetSession() ? handler->GetSession()->GetPlayer() : nullptr;
         if (!plr)
             return true;
 
-        RewardCfg cfg = GetRewardCfg();
+        if (!RealOnline::IsCustomsSchemaReady())
+        {
+            SendMsg(handler, Msg::SchemaNotReady);
+            return true;
+        }
+
+        RewardCfg const& cfg = GetRewardCfg();
         if (!cfg.enable || cfg.itemId == 0)
         {
-            handler->SendSysMessage(T("Reward system je vypnutý.", "Reward system is disabled."));
+            SendMsg(handler, Msg::RewardDisabled);
             return true;
         }
 
+        if (!RealOnline::CheckCommandRate(handler, RealOnline::RateLimitedCommand::Token))
+            return true;
+
         uint32 acc = handler->GetSession()->GetAccountId();
-        std::string sub = args ? Trim(args) : "";
-        std::transform(sub.begin(), sub.end(), sub.begin(), ::tolower);
-
-        auto showHelp = [&](){
-			uint32 stored = ReadStored(acc, cfg.itemId);
-		
-			if (LangOpt()==Lang::EN)
-			{
-				std::ostringstream ss;
-				ss << "Stored tokens: " << stored;
-				handler->SendSysMessage(ss.str().c_str());
-			}
-			else
-			{	
-				std::ostringstream ss;
-				ss << "Uskladněné tokeny: " << stored;
-				handler->SendSysMessage(ss.str().c_str());
-			}
-		};
 
+        std::string_view num;
+        std::string_view cmd = NextWord(args ? args : "", num);
 
-        if (sub.empty())
+        RealOnline::QueryBudgetScope budget(EqualsI(cmd, "deposit") ? RealOnline::BudgetOp::TokenDeposit
+                                          : EqualsI(cmd, "withdraw") ? RealOnline::BudgetOp::TokenWithdraw
+                                          : RealOnline::BudgetOp::TokenStatus);
+
+        // virtuální tokeny: stav = celý zůstatek, withdraw nemá kam; deposit
+        // dál převádí zbylé fyzické tokeny na zůstatek
+        if (RealOnline::IsVirtualToken(cfg.itemId) && (cmd.empty() || EqualsI(cmd, "withdraw")))
         {
-            showHelp();
+            uint32 balance = 0;
+            if (!RealOnline::GetTokenBalance(acc, balance))
+                SendMsg(handler, Msg::TokenWalletError);
+            else
+                SendMsg(handler, cmd.empty() ? Msg::TokenBalance : Msg::TokenVirtualOnly, balance);
             return true;
         }
 
-        std::string cmd, num;
+        if (cmd.empty())
         {
-            std::stringstream ss(sub);
-            ss >> cmd;
-            ss >> num;
+            uint32 stored = 0;
+            if (!RealOnline::ReadTokenStored(RealOnline::Storage(), acc, cfg.itemId, stored))
+                SendMsg(handler, Msg::RewardStoreError);
+            else
+                SendMsg(handler, Msg::TokenStored, stored);
+            return true;
         }
 
-        auto parseCount = [&](std::string const& s, uint32& out)->bool{
-            if (s.empty() || !std::all_of(s.begin(), s.end(), ::isdigit))
-                return false;
-            uint64 v = 0;
-            try { v = std::stoull(s); } catch (...) { return false; }
-            if (v == 0 || v > UINT32_MAX) return false;
-            out = static_cast<uint32>(v);
-            return true;
+        auto parseCount = [](std::string_view s, uint32& out)->bool{
+            return ParseU32(s, out) && out != 0;
         };
 
-        if (cmd == "deposit")
+        if (EqualsI(cmd, "deposit"))
         {
             uint32 amount = 0;
             if (!parseCount(num, amount))
             {
-                handler->SendSysMessage(T("Zadej kladný počet: .token deposit <pocet>", "Enter a positive number: .token deposit <count>"));
+                SendMsg(handler, Msg::TokenDepositUsage);
                 return true;
             }
 
-            uint32 have = plr->GetItemCount(cfg.itemId, true);
-            if (have < amount)
+            auto has = [&](uint32 count)
             {
-                std::ostringstream ss;
-                if (LangOpt()==Lang::EN)
-                    ss << "Not enough tokens in your bags. You have " << have << ".";
-                else
-                    ss << "Nemáš dost tokenů v taškách. Máš " << have << ".";
-                handler->SendSysMessage(ss.str().c_str());
-                return true;
+                uint32 have = plr->GetItemCount(cfg.itemId, true);
+                if (have >= count)
+                    return true;
+                SendMsg(handler, Msg::TokenNotEnoughInBags, have);
+                return false;
+            };
+
+            switch (RealOnline::DepositStored(RealOnline::Storage(), acc, cfg.itemId, amount, has))
+            {
+                case RealOnline::LedgerResult::Ok:
+                    break;
+                case RealOnline::LedgerResult::NotDelivered:
+                    return true; // hlášku poslal has
+                default:
+                    SendMsg(handler, Msg::RewardStoreError);
+                    return true;
             }
 
             plr->DestroyItemCount(cfg.itemId, amount, true, false);
+            RealOnline::NoteTokenStored(acc, amount);
 
-            UpsertAddStored(acc, cfg.itemId, amount);
-
-            std::ostringstream ok;
-            if (LangOpt()==Lang::EN)
-                ok << "Deposited " << amount << " token(s) to storage.";
-            else
-                ok << "Uloženo " << amount << " tokenů do úschovy.";
-            handler->SendSysMessage(ok.str().c_str());
+            SendMsg(handler, Msg::TokenDeposited, amount);
             return true;
         }
-        else if (cmd == "withdraw")
+        else if (EqualsI(cmd, "withdraw"))
         {
             uint32 amount = 0;
             if (!parseCount(num, amount))
             {
-                handler->SendSysMessage(T("Zadej kladný počet: .token withdraw <pocet>", "Enter a positive number: .token withdraw <count>"));
+                SendMsg(handler, Msg::TokenWithdrawUsage);
                 return true;
             }
 
-            uint32 stored = ReadStored(acc, cfg.itemId);
-            if (stored < amount)
+            uint32 mailed = 0, stored = 0;
+            auto deliver = [&](uint32 count)
             {
-                std::ostringstream ss;
-                if (LangOpt()==Lang::EN)
-                    ss << "Not enough stored tokens. You have " << stored << ".";
-                else
-                    ss << "Nemáš dost uskladněných tokenů. Máš " << stored << ".";
-                handler->SendSysMessage(ss.str().c_str());
+                if (!RealOnline::OverflowToMail())
+                {
+                    ItemPosCountVec dest;
+                    if (plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, cfg.itemId, count) != EQUIP_ERR_OK)
+                    {
+                        SendMsg(handler, Msg::TokenNoSpace);
+                        return false;
+                    }
+                }
+
+                if (!RealOnline::StoreRewardItemOrMail(plr, cfg.itemId, count, mailed))
+                {
+                    SendMsg(handler, Msg::RewardStoreError);
+                    return false;
+                }
                 return true;
-            }
+            };
 
-            ItemPosCountVec dest;
-            InventoryResult canStore = plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, cfg.itemId, amount);
-            if (canStore != EQUIP_ERR_OK)
+            switch (RealOnline::WithdrawStored(RealOnline::Storage(), acc, cfg.itemId, amount, deliver, stored))
             {
-                handler->SendSysMessage(T(
-                    "Nemáš dost místa v taškách. Uvolni místo a zkus znovu.",
-                    "Not enough bag space. Free up space and try again."
-                ));
-                return true;
+                case RealOnline::LedgerResult::StoreError:
+                    SendMsg(handler, Msg::RewardStoreError);
+                    return true;
+                case RealOnline::LedgerResult::Insufficient:
+                    SendMsg(handler, Msg::TokenNotEnoughStored, stored);
+                    return true;
+                case RealOnline::LedgerResult::NotRecorded:
+                    LOG_ERROR("module", "[reward] Withdraw of {}x {} by account {} delivered but not recorded ({} storage).",
+                        amount, cfg.itemId, acc, RealOnline::Storage().Name());
+                    break;
+                case RealOnline::LedgerResult::Ok:
+                    RealOnline::NoteTokenStored(acc, -int64(amount));
+                    break;
+                default:
+                    return true; // hlášku poslal deliver
             }
 
-            if (Item* it = plr->StoreNewItem(dest, cfg.itemId, true, Item::GenerateItemRandomPropertyId(cfg.itemId)))
+            if (mailed)
+                SendMsg(handler, Msg::TokenWithdrewMail, amount, mailed);
+            else
+                SendMsg(handler, Msg::TokenWithdrew, amount);
+            return true;
+        }
+
+        SendMsg(handler, Msg::TokenUnknownParam);
+        return true;
+    }
+};
+
+// =============================
+// Drivery simulátoru (.realonline simulate)
+// =============================
+// Syntetičtí hráči jsou StandInRoster (roster_harness.h): .online i playtime
+// tick nad nimi běží přes stejný filtr, řazení, stránkování, výpis a grant
+// jako u skutečných hráčů. Neměří se procházení sessions / hráčů map,
+// gettery Player a chat (viz load_sim.h).
+
+// účty simulátoru = SimAccountBase + index, roster roste s počtem online
+static RealOnline::StandInRoster& SimRoster(uint32 online)
+{
+    static RealOnline::StandInRoster roster;
+    if (roster.Size() < online)
+        roster.Reset(online, RealOnline::SimAccountBase);
+    return roster;
+}
+
+static void RegisterOnlineSimDrivers()
+{
+    using RealOnline::SimEvent;
+
+    // jednou za interval, arg = počet online účtů; filtr a grant jako RealOnlineRewardTicker
+    RealOnline::RegisterSimDriver(SimEvent::RewardTick, [](uint32 /*acc*/, uint32 online)
+    {
+        RewardCfg const& cfg = GetRewardCfg();
+        if (!cfg.enable || cfg.itemId == 0 || !RealOnline::IsCustomsSchemaReady())
+            return;
+
+        uint32 minLevel = std::max(cfg.minLevel, sOnlineCfg.minLevel);
+        EligibilityFilter const f = MakeEligibilityFilter(sOnlineCfg.hideGMs, minLevel, &sOnlineCfg.ignoreRanges, RewardActiveSince(cfg));
+
+        static std::vector<uint32> accounts;
+        uint32 afkSkipped = 0;
+        SimRoster(online).CollectEligible(f, online, accounts, afkSkipped);
+        GrantPlaytime(accounts, cfg.itemId, afkSkipped);
+    });
+
+    RealOnline::RegisterSimDriver(SimEvent::Command, [](uint32 acc, uint32 arg)
+    {
+        RewardCfg const& cfg = GetRewardCfg();
+        switch (arg % 3)
+        {
+            case 0: // .reward
             {
-                plr->SendNewItem(it, amount, true, false);
-
-                std::string up = "UPDATE customs.rewards SET `stored` = `stored` - " + std::to_string(amount)
-							   + ", updated_at = NOW() WHERE account=" + std::to_string(acc)
-							   + " AND item=" + std::to_string(cfg.itemId) + " AND `stored` >= " + std::to_string(amount);
-					CharacterDatabase.DirectExecute(up.c_str());
-
-                std::ostringstream ok;
-                if (LangOpt()==Lang::EN)
-                    ok << "Withdrew " << amount << " token(s) from storage.";
-                else
-                    ok << "Vybráno " << amount << " tokenů z úschovy.";
-                handler->SendSysMessage(ok.str().c_str());
+                RealOnline::RewardStatus st;
+                RealOnline::ReadRewardStatus(RealOnline::Storage(), acc, cfg.itemId, st);
+                break;
             }
-            else
+            case 1: // .token
+            {
+                uint32 stored = 0;
+                RealOnline::ReadTokenStored(RealOnline::Storage(), acc, cfg.itemId, stored);
+                break;
+            }
+            default: // .online <stránka>
             {
-                handler->SendSysMessage(T("Chyba při ukládání itemu do inventáře.", "Error storing item in inventory."));
+                uint32 online = RealOnline::SimOnlineCount();
+                uint32 pageSize = sOnlineCfg.pageSize;
+                uint32 pages = std::max(1u, (online + pageSize - 1) / pageSize);
+                std::string page = std::to_string(arg / 3 % pages + 1);
+
+                size_t bytes = 0;
+                Msg err = Msg::PageExpected;
+                SimRoster(online).RenderPage(MakeEligibilityFilter(sOnlineCfg.hideGMs, sOnlineCfg.minLevel), online,
+                                             page, pageSize, sOnlineCfg.showLevel, Lang::EN, bytes, err);
+                break;
             }
+        }
+    });
+}
 
+// =============================
+// ==== .realonline – GM diagnostika ====
+// =============================
+class RealOnlineAdminCommand : public CommandScript
+{
+public:
+    RealOnlineAdminCommand() : CommandScript("RealOnlineAdminCommand") {}
+
+#ifdef AC_HAS_NEW_CHAT_API
+    ChatCommandTable GetCommands() const override
+    {
+        static ChatCommandTable sub =
+        {
+            { "stats",    HandleStats,    SEC_GAMEMASTER,    Console::Yes },
+            { "simulate", HandleSimulate, SEC_ADMINISTRATOR, Console::Yes },
+            { "replay",   HandleReplay,   SEC_ADMINISTRATOR, Console::Yes }
+        };
+        static ChatCommandTable table =
+        {
+            { "realonline", sub }
+        };
+        return table;
+    }
+#else
+    std::vector<ChatCommand> GetCommands() const override
+    {
+        static std::vector<ChatCommand> sub = {
+            { "stats",    SEC_GAMEMASTER,    true, &HandleStats,    "" },
+            { "simulate", SEC_ADMINISTRATOR, true, &HandleSimulate, "" },
+            { "replay",   SEC_ADMINISTRATOR, true, &HandleReplay,   "" }
+        };
+        static std::vector<ChatCommand> cmds = {
+            { "realonline", SEC_GAMEMASTER, true, nullptr, "", sub }
+        };
+        return cmds;
+    }
+#endif
+
+    static bool HandleStats(ChatHandler* handler, char const* /*args*/)
+    {
+        using namespace RealOnline;
+
+        SendMsg(handler, Msg::StatsRateLimit,
+            GetRateLimitRejections(RateLimitedCommand::Online),
+            GetRateLimitRejections(RateLimitedCommand::Reward),
+            GetRateLimitRejections(RateLimitedCommand::Token));
+
+        for (uint8 i = 0; i < uint8(RewardSource::Count); ++i)
+        {
+            RewardSource src = RewardSource(i);
+            RewardStats st = GetRewardStats(src);
+            SendMsg(handler, Msg::StatsRewardSource, RewardSourceName(src),
+                st.grants, st.items, st.inventory, st.entitlement, st.fallback, st.mailed);
+        }
+
+        for (uint8 i = 0; i < uint8(BudgetOp::Count); ++i)
+        {
+            QueryBudgetStats st = GetQueryBudgetStats(BudgetOp(i));
+            if (st.calls)
+                SendMsg(handler, Msg::StatsQueryBudget, QueryBudgets[i].name,
+                    st.calls, st.violations, st.maxBlocking, st.maxQueued);
+        }
+
+        if (uint64 seen = sPlaytimeRewarded + sPlaytimeAfkSkipped)
+            SendMsg(handler, Msg::StatsPlaytimeAfk, sPlaytimeRewarded, sPlaytimeAfkSkipped, sPlaytimeAfkSkipped * 100 / seen);
+
+        if (BotAccountCount())
+            SendMsg(handler, Msg::StatsBotAccounts, BotAccountCount(), BotAccountLastId());
+        return true;
+    }
+
+    // .realonline simulate <lidé> <boti> <sekundy> | stop – jen paměťový backend
+    static bool HandleSimulate(ChatHandler* handler, char const* args)
+    {
+        std::string_view rest;
+        std::string_view first = NextWord(args ? args : "", rest);
+        if (EqualsI(first, "stop") && rest.empty())
+        {
+            RealOnline::StopSimulation(handler);
             return true;
         }
 
-        if (LangOpt()==Lang::EN)
-            handler->SendSysMessage("Unknown parameter. Use \".token\", \".token deposit <count>\", or \".token withdraw <count>\".");
-        else
-            handler->SendSysMessage("Neznámý parametr. Použij \".token\", \".token deposit <pocet>\", nebo \".token withdraw <pocet>\".");
+        uint32 humans = 0, bots = 0, seconds = 0;
+        std::string_view botsW = NextWord(rest, rest);
+        std::string_view secW  = NextWord(rest, rest);
+        if (!ParseU32(first, humans) || !ParseU32(botsW, bots) || !ParseU32(secW, seconds) || !rest.empty()
+            || humans + uint64(bots) == 0 || humans + uint64(bots) > 200000 || seconds == 0 || seconds > 3600)
+        {
+            SendMsg(handler, Msg::SimUsage);
+            return true;
+        }
+
+        WorldSession* session = handler->GetSession();
+        RealOnline::StartSimulation(handler, session ? session->GetAccountId() : 0, humans, bots, seconds);
+        return true;
+    }
+
+    // .realonline replay gen <účty> <dny> [% loginů] [seed] [Klíč=hodnota ...]
+    // .realonline replay file <cesta> [Klíč=hodnota ...]
+    // blokuje world thread, ideálně z konzole
+    static bool HandleReplay(ChatHandler* handler, char const* args)
+    {
+        std::string_view rest;
+        std::string_view mode = NextWord(args ? args : "", rest);
+
+        // přepisy configu jsou vždy na konci
+        auto readOverrides = [](std::string_view tail, RealOnline::ConfigView& view)
+        {
+            while (!TrimView(tail).empty())
+                if (!view.Override(NextWord(tail, tail)))
+                    return false;
+            return true;
+        };
+
+        RealOnline::ConfigView config;
+        if (EqualsI(mode, "file"))
+        {
+            std::string_view path = NextWord(rest, rest);
+            if (path.empty() || !readOverrides(rest, config))
+            {
+                SendMsg(handler, Msg::ReplayUsage);
+                return true;
+            }
+            RealOnline::ReplayFile(handler, std::string(path), config);
+            return true;
+        }
+
+        RealOnline::ReplayGenSpec spec;
+        bool ok = EqualsI(mode, "gen")
+            && ParseU32(NextWord(rest, rest), spec.accounts)
+            && ParseU32(NextWord(rest, rest), spec.days);
+
+        // volitelná čísla před přepisy
+        for (uint32* opt : { &spec.loginPct, &spec.seed })
+        {
+            std::string_view next = rest;
+            std::string_view word = NextWord(next, next);
+            if (!ok || word.empty() || word.find('=') != std::string_view::npos)
+                break;
+            ok = ParseU32(word, *opt);
+            rest = next;
+        }
+
+        if (!ok || !readOverrides(rest, config)
+            || spec.accounts == 0 || spec.accounts > 1000000 || spec.days == 0 || spec.days > 3650
+            || uint64(spec.accounts) * spec.days > 200000000 || spec.loginPct == 0 || spec.loginPct > 100)
+        {
+            SendMsg(handler, Msg::ReplayUsage);
+            return true;
+        }
+
+        RealOnline::ReplayGenerated(handler, spec, config);
         return true;
     }
 };
 
+// =============================
+// Načtení configu (.online, playtime odměny)
+// =============================
+// překročení rozpočtu dotazů jen do logu (počítá query_budget.cpp)
+static void LogQueryBudgetOverrun(RealOnline::QueryBudgetOverrun const& o)
+{
+    RealOnline::QueryBudget const& b = RealOnline::QueryBudgets[size_t(o.op)];
+    LOG_ERROR("module", "[budget] {} used {} blocking + {} queued round trip(s), budget is {} + {} (units {}).",
+        b.name, o.blocking, o.queued, b.blocking, o.maxQueued, o.units);
+}
+
+class RealOnlineConfigWS : public WorldScript
+{
+public:
+    RealOnlineConfigWS()
+        : WorldScript("RealOnlineConfigWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD }) {}
+
+    void OnAfterConfigLoad(bool /*reload*/) override
+    {
+        LoadOnlineCfg();
+        LoadRewardCfg();
+    }
+};
+
 void RegisterRealOnlineCustomsUpdater();
+void AddRealOnlineLocaleScripts();
+void AddRealOnlineRateLimitScripts();
+void AddRealOnlineRewardPipelineScripts();
+void AddRealOnlineRewardGrantScripts();
+void AddRealOnlineLeaderboardScripts();
+void AddRealOnlineRewardsArchiveScripts();
+void AddRealOnlineRewardStorageScripts();
+void AddRealOnlineLoadSimScripts();
+void AddRealOnlineBotAccountsScripts();
+void AddRealOnlineActivityScripts();
+void AddRealOnlineTokenWalletScripts();
 void Addmod_token_level_milestonesScripts();
 void Addmod_token_login_streakScripts();
 
@@ -746,10 +1240,26 @@ void Addmod_real_onlineScripts()
 {
 	RegisterRealOnlineCustomsUpdater();
 	
+    AddRealOnlineLocaleScripts();
+    RealOnline::SetQueryBudgetOverrunHandler(&LogQueryBudgetOverrun);
+    new RealOnlineConfigWS();
     new RealOnlineCommand();
     new RealOnlineRewardTicker();
+    new RealOnlineEligibilityMapScript();
     new RewardCommand();
     new TokenBankCommand();
+    new RealOnlineAdminCommand();
+    AddRealOnlineRateLimitScripts();
+    AddRealOnlineBotAccountsScripts();
+    AddRealOnlineActivityScripts();
+    AddRealOnlineTokenWalletScripts();
+    AddRealOnlineRewardPipelineScripts();
+    AddRealOnlineRewardGrantScripts();
+    AddRealOnlineLeaderboardScripts();
+    AddRealOnlineRewardsArchiveScripts();
+    AddRealOnlineRewardStorageScripts();
+    RegisterOnlineSimDrivers();
+    AddRealOnlineLoadSimScripts();
 
     Addmod_token_level_milestonesScripts();
     Addmod_token_login_streakScripts();
@@ -1,205 +1,262 @@
-#include "Config.h"
+#include "autoupdate.h"
+#include "bot_accounts.h"
+#include "load_sim.h"
+#include "query_budget.h"
+#include "messages.h"
+#include "reward_pipeline.h"
+#include "replay.h"
+#include "reward_storage.h"
+#include "storage_ops.h"
+#include "text_parse.h"
+
 #include "ScriptMgr.h"
 #include "Player.h"
 #include "Chat.h"
-#include "DatabaseEnv.h"
 #include "WorldSession.h"
+#include "WorldSessionMgr.h"
 #include "Log.h"
+#include "ObjectAccessor.h"
+#include "ObjectMgr.h"
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <sstream>
 
-// ==== Locale přepínač (CZ/EN) – čte RealOnline.Locale (cs|en) ====
-enum class Lang { CS, EN };
-static inline Lang LangOpt()
-{
-    std::string loc = sConfigMgr->GetOption<std::string>("RealOnline.Locale", "cs");
-    std::transform(loc.begin(), loc.end(), loc.begin(), ::tolower);
-    return (loc == "en" || loc == "english") ? Lang::EN : Lang::CS;
-}
-static inline char const* T(char const* cs, char const* en)
+using RealOnline::Msg;
+using RealOnline::Range;
+using RealOnline::ParseRanges;
+using RealOnline::InRanges;
+using RealOnline::ParseCSVu32;
+using RealOnline::AccountMilestones;
+using RealOnline::MilestoneReward;
+using RealOnline::MilestoneCheck;
+
+// ==== config ====
+struct LvlCfg
 {
-    return (LangOpt() == Lang::EN) ? en : cs;
-}
+    bool enable = false;
+    std::vector<uint32> milestones;
+    RealOnline::RewardDelivery delivery = RealOnline::RewardDelivery::Inventory;
+    bool announce = true;
+};
 
-// ==== utils ====
-static std::string Trim(std::string s)
+static LvlCfg ReadLvlCfg(RealOnline::ConfigView const& config)
 {
-    auto notSpace = [](int ch){ return !std::isspace(ch); };
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), notSpace));
-    s.erase(std::find_if(s.rbegin(), s.rend(), notSpace).base(), s.end());
-    return s;
+    LvlCfg c;
+    c.enable     = config.Get<bool>("Token.Level.Enable", false);
+    c.milestones = ParseCSVu32(config.Get<std::string>("Token.Level.Milestones", "10,20,30,40,50,60,70,80"));
+    c.delivery   = RealOnline::ParseDelivery(config.Get<std::string>("Token.Level.Delivery", "inventory"),
+                                              RealOnline::MilestoneSource::Prefix, RealOnline::RewardDelivery::Inventory);
+    c.announce   = config.Get<bool>("Token.Level.Announce", true);
+    return c;
 }
 
-static std::vector<uint32> ParseCSVu32(std::string const& s)
+// ==== katalog odměn ====
+// Sestaví se při načtení configu; level-up pak jen indexuje pole podle levelu.
+struct LvlCatalog
 {
-    std::vector<uint32> out;
-    std::stringstream ss(s);
-    std::string seg;
-    while (std::getline(ss, seg, ','))
-    {
-        seg = Trim(seg);
-        if (seg.empty()) continue;
-        try { out.push_back(static_cast<uint32>(std::stoul(seg))); } catch (...) {}
-    }
-    std::sort(out.begin(), out.end());
-    out.erase(std::unique(out.begin(), out.end()), out.end());
-    return out;
-}
+    LvlCfg cfg;
+    std::vector<MilestoneReward> byLevel; // index = level, itemId 0 = není milník
+    std::vector<Range> ignoreRanges;      // RealOnline.IgnoreAccountIdRanges
+};
 
-// ==== range parser pro blokaci účtů (A-B;C-D;...) ====
-struct Range { uint32 min = 0, max = 0; };
+static LvlCatalog sLvlCatalog;
 
-static std::vector<Range> ParseRanges(std::string const& txt)
+static LvlCatalog BuildLvlCatalog(RealOnline::ConfigView const& config)
 {
-    std::vector<Range> out;
-    std::stringstream ss(txt);
-    std::string seg;
-    while (std::getline(ss, seg, ';'))
+    LvlCatalog cat;
+    cat.cfg = ReadLvlCfg(config);
+    cat.ignoreRanges = ParseRanges(config.Get<std::string>("RealOnline.IgnoreAccountIdRanges", ""));
+
+    for (uint32 m : cat.cfg.milestones)
     {
-        seg = Trim(seg);
-        if (seg.empty()) continue;
-        auto dash = seg.find('-');
-        if (dash == std::string::npos) continue;
-        std::string a = Trim(seg.substr(0, dash));
-        std::string b = Trim(seg.substr(dash + 1));
-        if (a.empty() || b.empty()) continue;
-        uint32 mn = 0, mx = 0;
-        try { mn = static_cast<uint32>(std::stoul(a)); mx = static_cast<uint32>(std::stoul(b)); } catch (...) { continue; }
-        if (mn > mx) std::swap(mn, mx);
-        out.push_back({ mn, mx });
+        if (m == 0 || m > 255) // customs.level_milestones.milestone je TINYINT
+        {
+            LOG_ERROR("module", "[milestones] Token.Level.Milestones: level {} is out of range (1-255), skipped.", m);
+            continue;
+        }
+
+        std::string base = "Token.Level." + std::to_string(m) + ".";
+        MilestoneReward r;
+        r.itemId = config.Get<uint32>(base + "ItemId", 0u);
+        r.count  = config.Get<uint32>(base + "Count", 0u);
+        if (r.itemId == 0 || r.count == 0)
+            continue;
+
+        if (!sObjectMgr->GetItemTemplate(r.itemId))
+        {
+            LOG_ERROR("module", "[milestones] {}ItemId = {} does not exist in item_template, milestone disabled.", base, r.itemId);
+            continue;
+        }
+
+        if (cat.byLevel.size() <= m)
+            cat.byLevel.resize(m + 1);
+        cat.byLevel[m] = r;
     }
-    return out;
+
+    return cat;
 }
 
-static bool InRanges(uint32 id, std::vector<Range> const& rs)
+RealOnline::RewardDelivery RealOnline::MilestoneSource::Delivery()
 {
-    for (auto const& r : rs)
-        if (id >= r.min && id <= r.max)
-            return true;
-    return false;
+    return sLvlCatalog.cfg.delivery;
 }
 
-static bool DeliverRewardToPlayerOrEntitlement(Player* plr, uint32 accountId, uint32 itemId, uint32 count, std::string const& deliveryMode)
-{
-    std::string mode = deliveryMode;
-    std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+// ==== stav milníků účtu ====
+// AccountMilestones a rozhodnutí v paměti jsou ve storage_ops.h (test rozpočtu)
+static std::unordered_map<uint32, AccountMilestones> sAccountMilestones;
 
-    if (mode == "inventory")
-    {
-        ItemPosCountVec dest;
-        if (plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, itemId, count) == EQUIP_ERR_OK)
+// ==== handler ====
+// player == nullptr -> syntetická postava simulátoru (odměna do entitlementu, bez hlášky)
+// vrací počet pokusů o zápis milníku (jednotky rozpočtu)
+static uint32 HandleLevelRange(Player* player, uint32 acc, LvlCfg const& cfg, AccountMilestones& st, uint32 oldLevel, uint32 newLevel)
+{
+    return RealOnline::RecordLevelRange(RealOnline::Storage(), acc, st, sLvlCatalog.byLevel, oldLevel, newLevel,
+        [&](uint32 milestone, MilestoneReward const& reward, bool recorded)
         {
-            if (Item* it = plr->StoreNewItem(dest, itemId, true))
+            if (!recorded)
             {
-                plr->SendNewItem(it, count, true, false);
-                return true;
+                LOG_ERROR("module", "[milestone] Cannot record milestone {} of guid {} ({} storage), reward skipped.",
+                    milestone, st.guid, RealOnline::Storage().Name());
+                return;
             }
-        }
-        ChatHandler(plr->GetSession()).SendSysMessage(T(
-            "Inventář je plný, odměna byla připsána na účet. Vyzvedni pomocí \".reward claim\".",
-            "Inventory is full, reward was credited to your account. Use \".reward claim\" to collect."
-        ));
-    }
 
-    std::string up =
-        "INSERT INTO customs.rewards (account,item,entitled,claimed) VALUES (" +
-        std::to_string(accountId) + "," + std::to_string(itemId) + "," + std::to_string(count) + ",0) "
-        "ON DUPLICATE KEY UPDATE entitled = entitled + VALUES(entitled), updated_at = NOW()";
-    CharacterDatabase.DirectExecute(up.c_str());
-    return true;
+            RealOnline::Grant<RealOnline::MilestoneSource>(player, acc, reward.itemId, reward.count);
+
+            if (cfg.announce && player)
+            {
+                RealOnline::MessageBuffer msg;
+                msg.Format(Msg::MilestoneReached, RealOnline::SessionLang(player->GetSession()), milestone, reward.count);
+                ChatHandler(player->GetSession()).SendSysMessage(msg.View());
+                player->GetSession()->SendAreaTriggerMessage(msg.c_str());
+            }
+        });
 }
 
-// ==== config ====
-struct LvlCfg
+static void LoadAccountMilestones(uint32 acc, uint32 guid)
 {
-    bool enable = false;
-    std::vector<uint32> milestones;
-    std::string delivery = "inventory";
-    bool announce = true;
-};
+    RealOnline::QueryBudgetScope budget(RealOnline::BudgetOp::LoginMilestones);
 
-static LvlCfg ReadLvlCfg()
-{
-    LvlCfg c;
-    c.enable     = sConfigMgr->GetOption<bool>("Token.Level.Enable", false);
-    c.milestones = ParseCSVu32(sConfigMgr->GetOption<std::string>("Token.Level.Milestones", "10,20,30,40,50,60,70,80"));
-    c.delivery   = sConfigMgr->GetOption<std::string>("Token.Level.Delivery", "inventory");
-    c.announce   = sConfigMgr->GetOption<bool>("Token.Level.Announce", true);
-    return c;
-}
+    // relog během načítání: starší callback nesmí přepsat nový stav
+    static uint32 sLoadSeq = 0;
+    uint32 seq = ++sLoadSeq;
 
-static bool GetMilestoneReward(uint32 milestone, uint32& outItemId, uint32& outCount)
-{
-    std::string base = "Token.Level." + std::to_string(milestone) + ".";
-    outItemId = sConfigMgr->GetOption<uint32>((base + "ItemId").c_str(), 0u);
-    outCount  = sConfigMgr->GetOption<uint32>((base + "Count").c_str(), 0u);
-    return outItemId != 0 && outCount != 0;
+    AccountMilestones& fresh = sAccountMilestones[acc];
+    fresh = AccountMilestones();
+    fresh.guid    = guid;
+    fresh.loadSeq = seq;
+
+    RealOnline::Storage().LoadMilestones(acc, guid,
+        [acc, seq](bool ok, RealOnline::MilestoneSnapshot&& snap)
+        {
+            auto itr = sAccountMilestones.find(acc);
+            if (itr == sAccountMilestones.end() || itr->second.loadSeq != seq)
+                return;
+
+            if (!ok)
+            {
+                // bez stavu nelze bezpečně rozhodnout -> načte se znovu při dalším level-upu
+                LOG_ERROR("module", "[milestone] Cannot load milestones of account {} ({} storage).", acc, RealOnline::Storage().Name());
+                sAccountMilestones.erase(itr);
+                return;
+            }
+
+            AccountMilestones& st = itr->second;
+            RealOnline::ApplyMilestoneSnapshot(st, snap);
+
+            if (st.deferred.empty())
+                return;
+
+            auto deferred = std::move(st.deferred);
+            st.deferred.clear();
+
+            // stav patří k tomuto loginu (loadSeq), bez session jde o simulaci
+            WorldSession* sess = sWorldSessionMgr->FindSession(acc);
+            Player* plr = sess ? sess->GetPlayer() : nullptr;
+            LvlCfg const& cfg = sLvlCatalog.cfg;
+            if (!cfg.enable)
+                return;
+
+            RealOnline::QueryBudgetScope budget(RealOnline::BudgetOp::LevelUp);
+            for (auto const& [oldLevel, newLevel] : deferred)
+                budget.AddUnits(HandleLevelRange(plr, acc, cfg, st, oldLevel, newLevel));
+        });
 }
 
-// ==== handler ====
-static void HandleLevelMilestone(Player* player)
+// jen world thread (DrainLevelUps, simulátor)
+static void ProcessLevelUp(Player* player, uint32 acc, uint32 guid, uint8 oldLevel, uint8 newLevel)
 {
-    LvlCfg cfg = ReadLvlCfg();
-    if (!cfg.enable || !player || !player->GetSession())
+    LvlCfg const& cfg = sLvlCatalog.cfg;
+    if (!cfg.enable || !RealOnline::IsCustomsSchemaReady() || newLevel <= oldLevel)
         return;
 
-    uint32 level = player->GetLevel();
-    if (level < 10 || level > 80 || (level % 10) != 0)
+    if (!sLvlCatalog.ignoreRanges.empty() && InRanges(acc, sLvlCatalog.ignoreRanges))
         return;
-
-    uint32 itemId = 0, count = 0;
-    if (!GetMilestoneReward(level, itemId, count))
+    if (RealOnline::IsBotAccount(acc))
         return;
 
-    uint32 acc  = player->GetSession()->GetAccountId();
-    uint32 guid = player->GetGUID().GetCounter();
+    RealOnline::QueryBudgetScope budget(RealOnline::BudgetOp::LevelUp);
 
+    auto itr = sAccountMilestones.find(acc);
+    if (itr == sAccountMilestones.end())
     {
-        std::vector<Range> blocked = ParseRanges(sConfigMgr->GetOption<std::string>("RealOnline.IgnoreAccountIdRanges", ""));
-        if (!blocked.empty() && InRanges(acc, blocked))
-            return;
+        // modul zapnut až za běhu – načti a vyhodnoť po dokončení
+        LoadAccountMilestones(acc, guid);
+        itr = sAccountMilestones.find(acc);
     }
 
-    std::string q1 =
-        "SELECT 1 FROM customs.level_milestones "
-        "WHERE account=" + std::to_string(acc) +
-        " AND guid=" + std::to_string(guid) +
-        " AND milestone=" + std::to_string(level) +
-        " LIMIT 1";
-    if (QueryResult r = CharacterDatabase.Query(q1.c_str()))
+    AccountMilestones& st = itr->second;
+    if (!st.loaded)
+    {
+        st.deferred.emplace_back(oldLevel, newLevel);
         return;
+    }
 
-    std::string q2 =
-        "SELECT COUNT(*) FROM customs.level_milestones "
-        "WHERE account=" + std::to_string(acc) +
-        " AND milestone=" + std::to_string(level);
-    uint32 totalForAcc = 0;
-    if (QueryResult r2 = CharacterDatabase.Query(q2.c_str()))
-        totalForAcc = r2->Fetch()[0].Get<uint32>();
-    if (totalForAcc >= 10)
-        return;
+    budget.AddUnits(HandleLevelRange(player, acc, cfg, st, oldLevel, newLevel));
+}
 
-    std::string ins =
-        "INSERT INTO customs.level_milestones (account,guid,milestone) VALUES (" +
-        std::to_string(acc) + "," + std::to_string(guid) + "," + std::to_string(level) + ")";
-    CharacterDatabase.DirectExecute(ins.c_str());
+// ==== fronta level-upů ====
+// OnPlayerLevelChanged běží i v map threadech (kill creature). Stav účtů,
+// načítání i zápis milníků patří world threadu -> level-up se jen zařadí
+// a zpracuje v OnUpdate. Postava se dohledá podle guid (mezitím mohla odejít,
+// pak odměna jde do entitlementu bez hlášky).
+struct PendingLevelUp
+{
+    uint32 acc  = 0;
+    uint32 guid = 0;
+    uint8  oldLevel = 0;
+    uint8  newLevel = 0;
+};
 
-    DeliverRewardToPlayerOrEntitlement(player, acc, itemId, count, cfg.delivery);
+static std::mutex sLevelUpLock;
+static std::vector<PendingLevelUp> sLevelUpQueue;
 
-    if (cfg.announce)
-    {
-        std::ostringstream ss;
-        if (LangOpt()==Lang::EN)
-            ss << "Grats! You reached level " << level << " and receive " << count << "x Mystery Token.";
-        else
-            ss << "Gratuluji! Dosáhl jsi " << level << ". levelu a získáváš " << count << "x Mystery Token.";
-        ChatHandler(player->GetSession()).SendSysMessage(ss.str().c_str());
-    }
+static void QueueLevelUp(uint32 acc, uint32 guid, uint8 oldLevel, uint8 newLevel)
+{
+    std::lock_guard<std::mutex> guard(sLevelUpLock);
+    sLevelUpQueue.push_back({ acc, guid, oldLevel, newLevel });
 }
 
+static void DrainLevelUps()
+{
+    std::vector<PendingLevelUp> batch;
+    {
+        std::lock_guard<std::mutex> guard(sLevelUpLock);
+        if (sLevelUpQueue.empty())
+            return;
+        batch.swap(sLevelUpQueue);
+    }
 
+    for (PendingLevelUp const& lu : batch)
+    {
+        Player* plr = ObjectAccessor::FindPlayerByLowGUID(lu.guid);
+        ProcessLevelUp(plr, lu.acc, lu.guid, lu.oldLevel, lu.newLevel);
+    }
+}
 
 // ==== script ====
 class TokenLevelMilestones : public PlayerScript
@@ -207,82 +264,133 @@ class TokenLevelMilestones : public PlayerScript
 public:
     TokenLevelMilestones() : PlayerScript("TokenLevelMilestones") { }
 
-    void OnPlayerLevelChanged(Player* player, uint8 oldLevel) override
+    void OnPlayerLogin(Player* player) override
     {
-        LvlCfg cfg = ReadLvlCfg();
-        if (!cfg.enable || !player || !player->GetSession())
+        if (!player || !player->GetSession())
+            return;
+        if (!sLvlCatalog.cfg.enable || !RealOnline::IsCustomsSchemaReady())
             return;
+        if (RealOnline::IsBotAccount(player->GetSession()->GetAccountId()))
+            return;
+
+        LoadAccountMilestones(player->GetSession()->GetAccountId(), player->GetGUID().GetCounter());
+    }
 
-        uint32 newLevel = player->GetLevel();
-        if (newLevel <= oldLevel)
+    void OnPlayerLogout(Player* player) override
+    {
+        if (player && player->GetSession())
+            sAccountMilestones.erase(player->GetSession()->GetAccountId());
+    }
+
+    void OnPlayerLevelChanged(Player* player, uint8 oldLevel) override
+    {
+        if (!player || !player->GetSession())
             return;
 
-        uint32 acc = player->GetSession()->GetAccountId();
-        uint32 guidLow = player->GetGUID().GetCounter();
+        if (!sLvlCatalog.cfg.enable || uint8(player->GetLevel()) <= oldLevel)
+            return;
 
-        std::vector<Range> blocked = ParseRanges(sConfigMgr->GetOption<std::string>("RealOnline.IgnoreAccountIdRanges", ""));
-        bool isBlocked = (!blocked.empty() && InRanges(acc, blocked));
+        QueueLevelUp(player->GetSession()->GetAccountId(), player->GetGUID().GetCounter(),
+            oldLevel, uint8(player->GetLevel()));
+    }
+};
 
-        uint32 start = oldLevel + 1;
-        uint32 end   = newLevel;
-        uint32 firstMilestone = ((start + 9) / 10) * 10;
+class TokenLevelMilestonesConfig : public WorldScript
+{
+public:
+    TokenLevelMilestonesConfig()
+        : WorldScript("TokenLevelMilestonesConfig", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP, WORLDHOOK_ON_UPDATE }) { }
 
-        auto ms = cfg.milestones;
+    // při prvním načtení ještě nejsou item_template -> katalog staví až OnStartup
+    void OnAfterConfigLoad(bool reload) override
+    {
+        if (reload)
+            sLvlCatalog = BuildLvlCatalog(RealOnline::ConfigView());
+    }
 
-        for (uint32 m = firstMilestone; m <= end && m <= 80; m += 10)
-        {
-            if (!std::binary_search(ms.begin(), ms.end(), m))
-                continue;
+    void OnStartup() override { sLvlCatalog = BuildLvlCatalog(RealOnline::ConfigView()); }
 
-            uint32 itemId = 0, count = 0;
-            if (!GetMilestoneReward(m, itemId, count))
-                continue;
+    void OnUpdate(uint32 /*diff*/) override { DrainLevelUps(); }
+};
 
-            if (isBlocked)
-                continue;
+// ==== replay (.realonline replay) ====
+// Stejné rozhodnutí jako level-up (bit postavy + limit účtu), stav všech
+// postav účtu drží replay v paměti – odpovídá customs.level_milestones.
+class MilestoneReplaySink : public RealOnline::ReplaySink
+{
+public:
+    explicit MilestoneReplaySink(LvlCatalog&& cat)
+        : _cat(std::move(cat)), _rewardsByMilestone(_cat.byLevel.size()), _cappedByMilestone(_cat.byLevel.size()) { }
 
-            uint32 totalForAcc = 0;
-            {
-                std::string q = "SELECT COUNT(*) FROM customs.level_milestones WHERE account="
-                              + std::to_string(acc) + " AND milestone=" + std::to_string(m);
-                if (QueryResult r = CharacterDatabase.Query(q.c_str()))
-                    totalForAcc = r->Fetch()[0].Get<uint32>();
-            }
-            if (totalForAcc >= 10)
-                continue;
+    void OnEvent(RealOnline::ReplayEvent const& ev) override
+    {
+        if (ev.type != RealOnline::ReplayEventType::LevelUp)
+            return;
+        ++_levelUps;
 
-            std::string ins = "INSERT IGNORE INTO customs.level_milestones (account,guid,milestone) VALUES ("
-                            + std::to_string(acc) + "," + std::to_string(guidLow) + "," + std::to_string(m) + ")";
-            CharacterDatabase.DirectExecute(ins.c_str());
+        AccountMilestones& st = _accounts[ev.account];
+        st.guid = ev.guid;
 
-            uint32 nowCount = 0;
-            {
-                std::string q2 = "SELECT COUNT(*) FROM customs.level_milestones WHERE account="
-                               + std::to_string(acc) + " AND guid=" + std::to_string(guidLow)
-                               + " AND milestone=" + std::to_string(m);
-                if (QueryResult r2 = CharacterDatabase.Query(q2.c_str()))
-                    nowCount = r2->Fetch()[0].Get<uint32>();
-            }
-            if (nowCount == 0)
+        auto const& byLevel = _cat.byLevel;
+        for (uint32 lvl = ev.oldLevel + 1u; lvl <= ev.newLevel && lvl < byLevel.size(); ++lvl)
+        {
+            if (!byLevel[lvl].itemId)
                 continue;
 
-            DeliverRewardToPlayerOrEntitlement(player, acc, itemId, count, cfg.delivery);
-
-            if (cfg.announce)
+            switch (ReachMilestone(st, lvl))
             {
-                std::ostringstream ss;
-                if (LangOpt()==Lang::EN)
-                    ss << "Grats! You reached level " << m << " and receive " << count << "x Mystery Token.";
-                else
-                    ss << "Gratuluji! Dosáhl jsi " << m << ". levelu a získáváš " << count << "x Mystery Token.";
-                ChatHandler(player->GetSession()).SendSysMessage(ss.str().c_str());
-                player->GetSession()->SendAreaTriggerMessage(ss.str().c_str());
+                case MilestoneCheck::Reached:
+                    ++_rewards;
+                    ++_rewardsByMilestone[lvl];
+                    _items += byLevel[lvl].count;
+                    break;
+                case MilestoneCheck::AccountCap:
+                    ++_capped;
+                    ++_cappedByMilestone[lvl];
+                    break;
+                case MilestoneCheck::AlreadyReached:
+                    break;
             }
         }
     }
+
+    void Report(ChatHandler* handler) override
+    {
+        RealOnline::SendMsg(handler, Msg::ReplayMilestoneTotals, _rewards, _levelUps, _items, _capped, uint64(_accounts.size()));
+        RealOnline::SendReplayHistogram(handler, "milestone.rewards", _rewardsByMilestone);
+        RealOnline::SendReplayHistogram(handler, "milestone.capped", _cappedByMilestone);
+    }
+
+private:
+    LvlCatalog _cat;
+    std::unordered_map<uint32, AccountMilestones> _accounts;
+    std::vector<uint64> _rewardsByMilestone;
+    std::vector<uint64> _cappedByMilestone;
+    uint64 _levelUps = 0, _rewards = 0, _items = 0, _capped = 0;
 };
 
 void Addmod_token_level_milestonesScripts()
 {
     new TokenLevelMilestones();
+    new TokenLevelMilestonesConfig();
+    RealOnline::RegisterReplaySink([](RealOnline::ConfigView const& config) -> std::unique_ptr<RealOnline::ReplaySink>
+    {
+        LvlCatalog cat = BuildLvlCatalog(config);
+        if (cat.byLevel.empty())
+            return nullptr;
+        return std::make_unique<MilestoneReplaySink>(std::move(cat));
+    });
+
+    // simulátor: guid postavy = ID účtu
+    using RealOnline::SimEvent;
+    RealOnline::RegisterSimDriver(SimEvent::Login, [](uint32 acc, uint32 /*arg*/)
+    {
+        if (sLvlCatalog.cfg.enable && RealOnline::IsCustomsSchemaReady())
+            LoadAccountMilestones(acc, acc);
+    });
+    RealOnline::RegisterSimDriver(SimEvent::Logout, [](uint32 acc, uint32 /*arg*/){ sAccountMilestones.erase(acc); });
+    RealOnline::RegisterSimDriver(SimEvent::LevelUp, [](uint32 acc, uint32 oldLevel)
+    {
+        ProcessLevelUp(nullptr, acc, acc, uint8(oldLevel), uint8(oldLevel + 1));
+    });
 }
@@ -1,351 +1,551 @@
-#include "Config.h"
+#include "autoupdate.h"
+#include "bot_accounts.h"
+#include "leaderboard.h"
+#include "load_sim.h"
+#include "query_budget.h"
+#include "messages.h"
+#include "reward_pipeline.h"
+#include "replay.h"
+#include "reward_storage.h"
+#include "storage_ops.h"
+#include "streak_logic.h"
+#include "text_parse.h"
+
 #include "ScriptMgr.h"
 #include "Player.h"
 #include "Chat.h"
-#include "DatabaseEnv.h"
 #include "WorldSession.h"
-#include "GameTime.h"
+#include "Log.h"
+#include "ObjectMgr.h"
+#include "WorldSessionMgr.h"
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <vector>
-#include <sstream>
 
-// ==== Locale přepínač (CZ/EN) – čte RealOnline.Locale (cs|en) ====
-enum class Lang { CS, EN };
-static inline Lang LangOpt()
+using RealOnline::Msg;
+using RealOnline::Range;
+using RealOnline::ParseRanges;
+using RealOnline::InRanges;
+using RealOnline::SpecialReward;
+using RealOnline::StreakState;
+using RealOnline::StreakGrant;
+
+// nové vs. staré chat API (stejná detekce jako v mod_real_online.cpp)
+#if __has_include("Chat/ChatCommands/ChatCommand.h")
+  #define AC_HAS_NEW_CHAT_API 1
+  #include "Chat/ChatCommands/ChatCommand.h"
+  using namespace Acore::ChatCommands;
+#endif
+
+// ==== config ====
+struct StreakCfg
 {
-    std::string loc = sConfigMgr->GetOption<std::string>("RealOnline.Locale", "cs");
-    std::transform(loc.begin(), loc.end(), loc.begin(), ::tolower);
-    return (loc == "en" || loc == "english") ? Lang::EN : Lang::CS;
-}
-static inline char const* T(char const* cs, char const* en)
+    bool enable = false;
+    uint32 baseItem = 0;
+    uint32 baseCount = 0;
+    uint32 cycleLen = 28;
+    std::vector<uint32> specialDays;
+    uint32 dayBoundaryHour = 4;
+    bool resetOnMiss = true;
+    RealOnline::RewardDelivery delivery = RealOnline::RewardDelivery::Inventory;
+    bool announce = true;
+    bool sweepEnable = true;
+    uint32 sweepPerTick = 25; // doručení sweepu za tick
+};
+
+static StreakCfg ReadStreakCfg(RealOnline::ConfigView const& config)
 {
-    return (LangOpt() == Lang::EN) ? en : cs;
+    StreakCfg c;
+    c.enable          = config.Get<bool>("Token.Streak.Enable", false);
+    c.baseItem        = config.Get<uint32>("Token.Streak.Base.ItemId", 0u);
+    c.baseCount       = config.Get<uint32>("Token.Streak.Base.Count", 0u);
+    c.cycleLen        = std::max(1u, config.Get<uint32>("Token.Streak.CycleLength", 28u));
+    c.specialDays     = RealOnline::ParseCSVu32(config.Get<std::string>("Token.Streak.SpecialDays", "7,14,21,28"));
+    c.dayBoundaryHour = config.Get<uint32>("Token.Streak.DayBoundaryHour", 4u);
+    c.resetOnMiss     = config.Get<bool>("Token.Streak.ResetOnMiss", true);
+    c.delivery        = RealOnline::ParseDelivery(config.Get<std::string>("Token.Streak.Delivery", "inventory"),
+                                                   RealOnline::StreakSource::Prefix, RealOnline::RewardDelivery::Inventory);
+    c.announce        = config.Get<bool>("Token.Streak.Announce", true);
+    c.sweepEnable     = config.Get<bool>("Token.Streak.Sweep.Enable", true);
+    c.sweepPerTick    = std::max(1u, config.Get<uint32>("Token.Streak.Sweep.DeliveriesPerTick", 25u));
+    return c;
 }
 
-// ==== utils ====
-static std::string Trim2(std::string s)
+// čas z RealOnline::Now() – replay ho podvrhne
+static inline uint32 TodaySerial(uint32 boundaryHour)
 {
-    auto notSpace = [](int ch){ return !std::isspace(ch); };
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), notSpace));
-    s.erase(std::find_if(s.rbegin(), s.rend(), notSpace).base(), s.end());
-    return s;
+    return RealOnline::StreakDaySerial(RealOnline::Now(), boundaryHour);
 }
 
-static std::vector<uint32> ParseCSVu32b(std::string const& s)
+// ==== katalog odměn ====
+// Sestaví se při načtení configu; den cyklu pak jen indexuje pole.
+struct StreakCatalog
 {
-    std::vector<uint32> out;
-    std::stringstream ss(s);
-    std::string seg;
-    while (std::getline(ss, seg, ','))
-    {
-        seg = Trim2(seg);
-        if (seg.empty()) continue;
-        try { out.push_back(static_cast<uint32>(std::stoul(seg))); } catch (...) {}
-    }
-    std::sort(out.begin(), out.end());
-    out.erase(std::unique(out.begin(), out.end()), out.end());
-    return out;
-}
+    StreakCfg cfg;
+    std::vector<SpecialReward> byDay; // index = den cyklu (1..cycleLen)
+    std::vector<Range> ignoreRanges;  // RealOnline.IgnoreAccountIdRanges
+};
 
-// ==== blocklist rozsahů účtů (A-B;C-D;...) ====
-struct Range { uint32 min=0, max=0; };
+static StreakCatalog sStreakCatalog;
 
-static std::vector<Range> ParseRanges(std::string const& txt)
+static StreakCatalog BuildStreakCatalog(RealOnline::ConfigView const& config)
 {
-    std::vector<Range> out;
-    std::stringstream ss(txt);
-    std::string seg;
-    while (std::getline(ss, seg, ';'))
+    StreakCatalog cat;
+    cat.cfg = ReadStreakCfg(config);
+    cat.ignoreRanges = ParseRanges(config.Get<std::string>("RealOnline.IgnoreAccountIdRanges", ""));
+    cat.byDay.resize(cat.cfg.cycleLen + 1);
+
+    if (cat.cfg.baseItem && !sObjectMgr->GetItemTemplate(cat.cfg.baseItem))
     {
-        seg = Trim2(seg);
-        if (seg.empty()) continue;
-        auto dash = seg.find('-');
-        if (dash == std::string::npos) continue;
-        std::string a = Trim2(seg.substr(0, dash));
-        std::string b = Trim2(seg.substr(dash + 1));
-        if (a.empty() || b.empty()) continue;
-        uint32 mn = 0, mx = 0;
-        try { mn = static_cast<uint32>(std::stoul(a)); mx = static_cast<uint32>(std::stoul(b)); }
-        catch (...) { continue; }
-        if (mn > mx) std::swap(mn, mx);
-        out.push_back({mn, mx});
+        LOG_ERROR("module", "[streak] Token.Streak.Base.ItemId = {} does not exist in item_template, streak disabled.", cat.cfg.baseItem);
+        cat.cfg.enable = false;
     }
-    return out;
-}
 
-static bool InRanges(uint32 id, std::vector<Range> const& rs)
-{
-    for (auto const& r : rs)
-        if (id >= r.min && id <= r.max)
-            return true;
-    return false;
-}
+    for (uint32 day : cat.cfg.specialDays)
+    {
+        if (day == 0 || day > cat.cfg.cycleLen)
+        {
+            LOG_ERROR("module", "[streak] Token.Streak.SpecialDays: day {} is outside the cycle (1-{}), skipped.", day, cat.cfg.cycleLen);
+            continue;
+        }
 
-static bool DeliverEntitlementOrInventory(Player* plr, uint32 accountId, uint32 itemId, uint32 count, std::string const& deliveryMode)
-{
-    std::string mode = deliveryMode;
-    std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+        std::string base = "Token.Streak.Special." + std::to_string(day) + ".";
+        SpecialReward r;
+        r.itemId = config.Get<uint32>(base + "ItemId", 0u);
+        r.count  = config.Get<uint32>(base + "Count", 0u);
 
-    if (mode == "inventory")
-    {
-        ItemPosCountVec dest;
-        if (plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, itemId, count) == EQUIP_ERR_OK)
+        if (r.itemId && !sObjectMgr->GetItemTemplate(r.itemId))
         {
-            if (Item* it = plr->StoreNewItem(dest, itemId, true))
-            {
-                plr->SendNewItem(it, count, true, false);
-                return true;
-            }
+            LOG_ERROR("module", "[streak] {}ItemId = {} does not exist in item_template, bonus skipped.", base, r.itemId);
+            continue;
         }
-        ChatHandler(plr->GetSession()).SendSysMessage(T(
-            "Inventář je plný, odměna byla připsána na účet. Vyzvedni pomocí \".reward claim\".",
-            "Inventory is full, reward was credited to your account. Use \".reward claim\" to collect."
-        ));
+
+        cat.byDay[day] = r;
     }
 
-    std::string up =
-        "INSERT INTO customs.rewards (account,item,entitled,claimed) VALUES (" +
-        std::to_string(accountId) + "," + std::to_string(itemId) + "," + std::to_string(count) + ",0) "
-        "ON DUPLICATE KEY UPDATE entitled = entitled + VALUES(entitled), updated_at = NOW()";
-    CharacterDatabase.DirectExecute(up.c_str());
-    return true;
+    return cat;
 }
 
-// ==== config ====
-struct StreakCfg
-{
-    bool enable = false;
-    uint32 baseItem = 0;
-    uint32 baseCount = 0;
-    uint32 cycleLen = 28;
-    std::vector<uint32> specialDays;
-    uint32 dayBoundaryHour = 4;
-    bool resetOnMiss = true;
-    std::string delivery = "inventory";
-    bool announce = true;
-};
-
-static StreakCfg ReadStreakCfg()
+RealOnline::RewardDelivery RealOnline::StreakSource::Delivery()
 {
-    StreakCfg c;
-    c.enable          = sConfigMgr->GetOption<bool>("Token.Streak.Enable", false);
-    c.baseItem        = sConfigMgr->GetOption<uint32>("Token.Streak.Base.ItemId", 0u);
-    c.baseCount       = sConfigMgr->GetOption<uint32>("Token.Streak.Base.Count", 0u);
-    c.cycleLen        = std::max(1u, sConfigMgr->GetOption<uint32>("Token.Streak.CycleLength", 28u));
-    c.specialDays     = ParseCSVu32b(sConfigMgr->GetOption<std::string>("Token.Streak.SpecialDays", "7,14,21,28"));
-    c.dayBoundaryHour = sConfigMgr->GetOption<uint32>("Token.Streak.DayBoundaryHour", 4u);
-    c.resetOnMiss     = sConfigMgr->GetOption<bool>("Token.Streak.ResetOnMiss", true);
-    c.delivery        = sConfigMgr->GetOption<std::string>("Token.Streak.Delivery", "inventory");
-    c.announce        = sConfigMgr->GetOption<bool>("Token.Streak.Announce", true);
-    return c;
+    return sStreakCatalog.cfg.delivery;
 }
 
-static inline uint32 TodaySerial(uint32 boundaryHour)
+// plr může být nullptr (hráč mezitím odešel) -> vše jde do entitlementu
+static void DeliverStreakGrant(Player* plr, uint32 acc, StreakCfg const& cfg, StreakGrant const& g)
 {
-    time_t now = static_cast<time_t>(GameTime::GetGameTime().count());
-    int64 shifted = static_cast<int64>(now) - static_cast<int64>(boundaryHour) * 3600;
-    if (shifted < 0) shifted = 0;
-    return static_cast<uint32>(shifted / 86400);
+    using namespace RealOnline;
+    if (g.separateBonus)
+    {
+        Grant<StreakSource>(plr, acc, cfg.baseItem, cfg.baseCount);
+        Grant<StreakSource>(plr, acc, g.spItem, g.spCnt);
+    }
+    else
+    {
+        Grant<StreakSource>(plr, acc, cfg.baseItem, g.totalCount);
+    }
 }
 
-static bool IsSpecialDay(uint32 day, std::vector<uint32> const& specials)
+static void AnnounceStreak(Player* player, StreakCfg const& cfg, StreakGrant const& g)
 {
-    return std::binary_search(specials.begin(), specials.end(), day);
+    ChatHandler handler(player->GetSession());
+    if (g.separateBonus)
+        RealOnline::SendMsg(&handler, Msg::StreakSeparate, g.streakDay, cfg.cycleLen, cfg.baseCount, g.spCnt);
+    else if (g.totalCount != cfg.baseCount)
+        RealOnline::SendMsg(&handler, Msg::StreakBonus, g.streakDay, cfg.cycleLen, g.totalCount, g.totalCount - cfg.baseCount);
+    else
+        RealOnline::SendMsg(&handler, Msg::StreakBase, g.streakDay, cfg.cycleLen, cfg.baseCount);
 }
 
-static void ReadSpecialReward(uint32 day, uint32& itemId, uint32& count)
+// účty, které řeší probíhající/poslední sweep pro den sSweepSerial – login je přeskočí
+static uint32 sSweepSerial = 0;
+static std::unordered_set<uint32> sSweepAccounts;
+
+// Opačný směr: účty, jejichž den sLoginSerial už zapsal login. Zápis loginu
+// jde do fronty a async LoadStreaks sweepu ho může předběhnout (víc async
+// workerů CharacterDatabase) -> sweep by den udělil podruhé.
+static uint32 sLoginSerial = 0;
+static std::unordered_set<uint32> sLoginAccounts;
+
+static void NoteLoginHandled(uint32 acc, uint32 today)
 {
-    std::string base = "Token.Streak.Special." + std::to_string(day) + ".";
-    itemId = sConfigMgr->GetOption<uint32>((base + "ItemId").c_str(), 0u);
-    count  = sConfigMgr->GetOption<uint32>((base + "Count").c_str(), 0u);
+    if (sLoginSerial != today)
+    {
+        sLoginSerial = today;
+        sLoginAccounts.clear();
+    }
+    sLoginAccounts.insert(acc);
 }
 
 // ==== handler ====
-static void HandleLoginStreak(Player* player)
+// player == nullptr -> syntetický login simulátoru (odměna jde do entitlementu)
+static void ProcessLoginStreak(uint32 acc, Player* player)
 {
-    StreakCfg cfg = ReadStreakCfg();
-    if (!cfg.enable || !player || !player->GetSession())
+    StreakCfg const& cfg = sStreakCatalog.cfg;
+    if (!cfg.enable || !RealOnline::IsCustomsSchemaReady())
         return;
     if (cfg.baseItem == 0 || cfg.baseCount == 0)
         return;
 
-    uint32 acc = player->GetSession()->GetAccountId();
     uint32 today = TodaySerial(cfg.dayBoundaryHour);
 
-{
-    std::vector<Range> blocked = ParseRanges(sConfigMgr->GetOption<std::string>("RealOnline.IgnoreAccountIdRanges", ""));
-    if (!blocked.empty() && InRanges(acc, blocked))
+    if (!sStreakCatalog.ignoreRanges.empty() && InRanges(acc, sStreakCatalog.ignoreRanges))
+        return;
+    if (RealOnline::IsBotAccount(acc))
         return;
+
+    if (sSweepSerial == today && sSweepAccounts.count(acc))
+        return;
+
+    RealOnline::QueryBudgetScope budget(RealOnline::BudgetOp::LoginStreak);
+
+    StreakState st;
+    switch (RealOnline::AdvanceLoginStreak(RealOnline::Storage(), acc, today, cfg.cycleLen, cfg.resetOnMiss, st))
+    {
+        case RealOnline::StreakStep::Advanced:
+            break;
+        case RealOnline::StreakStep::AlreadyRewarded:
+            return;
+        case RealOnline::StreakStep::ReadError:
+            LOG_ERROR("module", "[streak] Cannot read streak of account {} ({} storage), skipped.", acc, RealOnline::Storage().Name());
+            return;
+        case RealOnline::StreakStep::WriteError:
+            LOG_ERROR("module", "[streak] Cannot write streak of account {} ({} storage), skipped.", acc, RealOnline::Storage().Name());
+            return;
+    }
+
+    StreakGrant g = RealOnline::ResolveStreakGrant(cfg.baseCount, sStreakCatalog.byDay, st.streakDay);
+    NoteLoginHandled(acc, today);
+    RealOnline::OfferLeaderboardScore(RealOnline::Leaderboard::Streak, acc, st.consecutiveDays,
+        player ? std::string_view(player->GetName()) : std::string_view());
+
+    DeliverStreakGrant(player, acc, cfg, g);
+
+    if (cfg.announce && player)
+        AnnounceStreak(player, cfg, g);
 }
 
+static void HandleLoginStreak(Player* player)
+{
+    if (player && player->GetSession())
+        ProcessLoginStreak(player->GetSession()->GetAccountId(), player);
+}
 
-    uint32 lastSerial = 0, lastRewardSerial = 0, streakDay = 0;
+// ==== sweep na hranici dne ====
+// Hráči online přes Token.Streak.DayBoundaryHour dostanou odměnu bez relogu:
+// jeden hromadný SELECT, jeden hromadný upsert, doručení rozložené do ticků.
+class TokenLoginStreakSweep : public WorldScript
+{
+public:
+    TokenLoginStreakSweep() : WorldScript("TokenLoginStreakSweep", std::vector<uint16>{ WORLDHOOK_ON_UPDATE }) { }
 
+    void OnUpdate(uint32 diff) override
     {
-        std::string q =
-            "SELECT last_serial, last_reward_serial, streak_day FROM customs.login_streak WHERE account=" +
-            std::to_string(acc) + " LIMIT 1";
-        if (QueryResult r = CharacterDatabase.Query(q.c_str()))
+        DeliverPending();
+
+        _checkTimer += diff;
+        if (_checkTimer < 1000)
+            return;
+        _checkTimer = 0;
+
+        StreakCfg const& cfg = sStreakCatalog.cfg;
+        if (!cfg.enable || !cfg.sweepEnable || cfg.baseItem == 0 || cfg.baseCount == 0 || !RealOnline::IsCustomsSchemaReady())
+            return;
+
+        uint32 today = TodaySerial(cfg.dayBoundaryHour);
+        if (_lastSerial == 0)
         {
-            Field* f = r->Fetch();
-            lastSerial       = f[0].Get<uint32>();
-            lastRewardSerial = f[1].Get<uint32>();
-            streakDay        = f[2].Get<uint32>();
+            // první tick po startu – o dnešek se postará login
+            _lastSerial = today;
+            return;
         }
-        else
+        if (today == _lastSerial)
+            return;
+
+        _lastSerial = today;
+        StartSweep(cfg, today);
+    }
+
+private:
+    struct PendingGrant
+    {
+        uint32      account;
+        StreakGrant grant;
+    };
+
+    // sweep selhal -> účty zpět loginu (jinak by je přeskakoval celý den)
+    static void ReleaseSweepAccounts(uint32 today, std::vector<uint32> const& accounts)
+    {
+        if (sSweepSerial != today)
+            return;
+        for (uint32 acc : accounts)
+            sSweepAccounts.erase(acc);
+    }
+
+    void StartSweep(StreakCfg const& cfg, uint32 today)
+    {
+        std::vector<Range> const& blocked = sStreakCatalog.ignoreRanges;
+
+        std::vector<uint32> accounts;
+        for (auto const& [accId, sess] : sWorldSessionMgr->GetAllSessions())
         {
-            streakDay = 1;
+            if (!sess) continue;
+            Player* p = sess->GetPlayer();
+            if (!p || !p->IsInWorld()) continue;
+
+            uint32 acc = sess->GetAccountId();
+            if (!blocked.empty() && InRanges(acc, blocked))
+                continue;
+            if (RealOnline::IsBotAccount(acc))
+                continue;
+            if (sLoginSerial == today && sLoginAccounts.count(acc))
+                continue;
+            accounts.push_back(acc);
+        }
+
+        sSweepSerial = today;
+        sSweepAccounts.clear();
+        sSweepAccounts.insert(accounts.begin(), accounts.end());
+
+        if (accounts.empty())
+            return;
 
-            uint32 totalCount = cfg.baseCount;
-            bool separateBonus = false;
-            uint32 spItem = 0, spCnt = 0;
+        LOG_INFO("module", "[streak] Day boundary (serial {}): sweeping {} online account(s).", today, accounts.size());
 
-            if (IsSpecialDay(streakDay, cfg.specialDays))
+        RealOnline::Storage().LoadStreaks(accounts,
+            [this, cfg, today, accounts](bool ok, RealOnline::StreakMap&& records)
             {
-                ReadSpecialReward(streakDay, spItem, spCnt);
-                if (spItem && spCnt)
+                if (!ok)
                 {
-                    separateBonus = true;
+                    LOG_ERROR("module", "[streak] Day boundary (serial {}): cannot load streaks ({} storage), sweep skipped.",
+                        today, RealOnline::Storage().Name());
+                    ReleaseSweepAccounts(today, accounts);
+                    return;
                 }
-                else
-                {
-                    totalCount += spCnt; // bonus stejného itemu
-                }
-            }
+                OnSweepLoaded(cfg, today, accounts, records);
+            });
+    }
 
-            if (separateBonus)
-            {
-                DeliverEntitlementOrInventory(player, acc, cfg.baseItem, cfg.baseCount, cfg.delivery);
-                DeliverEntitlementOrInventory(player, acc, spItem, spCnt, cfg.delivery);
-            }
-            else
-            {
-                DeliverEntitlementOrInventory(player, acc, cfg.baseItem, totalCount, cfg.delivery);
-            }
+    void OnSweepLoaded(StreakCfg const& cfg, uint32 today, std::vector<uint32> const& accounts, RealOnline::StreakMap const& records)
+    {
+        std::vector<std::pair<uint32, RealOnline::StreakRecord>> rows;
+        std::vector<PendingGrant> grants;
 
-            std::string ins =
-                "INSERT INTO customs.login_streak (account,last_serial,last_reward_serial,streak_day) VALUES (" +
-                std::to_string(acc) + "," + std::to_string(today) + "," + std::to_string(today) + "," + std::to_string(streakDay) + ") "
-                "ON DUPLICATE KEY UPDATE last_serial=VALUES(last_serial), last_reward_serial=VALUES(last_reward_serial), streak_day=VALUES(streak_day)";
-            CharacterDatabase.Execute(ins.c_str());
+        for (uint32 acc : accounts)
+        {
+            auto itr = records.find(acc);
+            StreakState st = itr != records.end() ? RealOnline::StreakFromRecord(itr->second) : StreakState();
+            if (!RealOnline::AdvanceStreak(st, today, cfg.cycleLen, cfg.resetOnMiss))
+                continue;
 
-            if (cfg.announce)
-            {
-                std::ostringstream ss;
-                if (LangOpt()==Lang::EN)
-                {
-                    ss << "Congrats! Day " << streakDay << " in a row out of " << cfg.cycleLen << ". ";
-                    if (separateBonus)
-                        ss << "You receive " << cfg.baseCount << "× Mystery Token and additionally " << spCnt << "× Mystery Token.";
-                    else if (totalCount != cfg.baseCount)
-                        ss << "You receive " << totalCount << "× Mystery Token (including bonus " << (totalCount - cfg.baseCount) << "×).";
-                    else
-                        ss << "You receive " << cfg.baseCount << "× Mystery Token.";
-                }
-                else
-                {
-                    ss << "Gratulace! " << streakDay << ". den v řadě z " << cfg.cycleLen << ". ";
-                    if (separateBonus)
-                        ss << "Získáváš " << cfg.baseCount << "× Mystery Token a navíc " << spCnt << "× Mystery Token.";
-                    else if (totalCount != cfg.baseCount)
-                        ss << "Získáváš " << totalCount << "× Mystery Token (včetně bonusu " << (totalCount - cfg.baseCount) << "×).";
-                    else
-                        ss << "Získáváš " << cfg.baseCount << "× Mystery Token.";
-                }
-                ChatHandler(player->GetSession()).SendSysMessage(ss.str().c_str());
-            }
+            rows.emplace_back(acc, RealOnline::StreakToRecord(st));
+            grants.push_back({ acc, RealOnline::ResolveStreakGrant(cfg.baseCount, sStreakCatalog.byDay, st.streakDay) });
+        }
+
+        if (rows.empty())
+            return;
+
+        if (!RealOnline::Storage().WriteStreaks(rows))
+        {
+            LOG_ERROR("module", "[streak] Day boundary (serial {}): cannot write {} streak(s) ({} storage), sweep skipped.",
+                today, rows.size(), RealOnline::Storage().Name());
+            ReleaseSweepAccounts(today, accounts);
             return;
         }
-    }
 
-    int64 delta = static_cast<int64>(today) - static_cast<int64>(lastSerial);
+        for (auto const& [acc, rec] : rows)
+            RealOnline::OfferLeaderboardScore(RealOnline::Leaderboard::Streak, acc, rec.consecutiveDays);
+        _pending.insert(_pending.end(), grants.begin(), grants.end());
+
+        _deliveryCfg = cfg;
+        LOG_INFO("module", "[streak] Day boundary (serial {}): {} grant(s) queued.", today, rows.size());
+    }
 
-    if (delta <= 0)
+    void DeliverPending()
     {
-        if (lastRewardSerial == today)
+        if (_pending.empty())
             return;
+
+        for (uint32 i = 0; i < _deliveryCfg.sweepPerTick && !_pending.empty(); ++i)
+        {
+            PendingGrant pg = _pending.front();
+            _pending.pop_front();
+
+            Player* plr = nullptr;
+            if (WorldSession* s = sWorldSessionMgr->FindSession(pg.account))
+                if (Player* p = s->GetPlayer())
+                    if (p->IsInWorld())
+                        plr = p;
+
+            DeliverStreakGrant(plr, pg.account, _deliveryCfg, pg.grant);
+
+            if (plr && _deliveryCfg.announce)
+                AnnounceStreak(plr, _deliveryCfg, pg.grant);
+        }
     }
-    else if (delta == 1)
+
+    std::deque<PendingGrant> _pending;
+    StreakCfg                _deliveryCfg;
+    uint32                   _checkTimer = 0;
+    uint32                   _lastSerial = 0;
+};
+
+// ==== .streak top ====
+class TokenLoginStreakCommand : public CommandScript
+{
+public:
+    TokenLoginStreakCommand() : CommandScript("TokenLoginStreakCommand") { }
+
+#ifdef AC_HAS_NEW_CHAT_API
+    ChatCommandTable GetCommands() const override
     {
-        streakDay = (streakDay % cfg.cycleLen) + 1;
+        static ChatCommandTable table =
+        {
+            { "streak", HandleStreak, SEC_PLAYER, Console::Yes }
+        };
+        return table;
     }
-    else
+#else
+    std::vector<ChatCommand> GetCommands() const override
     {
-        if (cfg.resetOnMiss)
-            streakDay = 1;
-        else
-            streakDay = (streakDay % cfg.cycleLen) + 1;
+        static std::vector<ChatCommand> cmds;
+        cmds.push_back({ "streak", SEC_PLAYER, true, &HandleStreak, "" });
+        return cmds;
     }
+#endif
 
-    uint32 totalCount = cfg.baseCount;
-    bool separateBonus = false;
-    uint32 spItem = 0, spCnt = 0;
-
-    if (IsSpecialDay(streakDay, cfg.specialDays))
+    static bool HandleStreak(ChatHandler* handler, char const* args)
     {
-        ReadSpecialReward(streakDay, spItem, spCnt);
-        if (spItem && spCnt)
-            separateBonus = true;
+        std::string sub = RealOnline::Trim(args ? args : "");
+        std::transform(sub.begin(), sub.end(), sub.begin(), ::tolower);
+
+        if (sub.empty() || sub == "top")
+            RealOnline::ShowLeaderboard(handler, RealOnline::Leaderboard::Streak);
         else
-            totalCount += spCnt;
+            RealOnline::SendMsg(handler, Msg::StreakUsage);
+        return true;
     }
+};
 
-    {
-        std::string up =
-            "UPDATE customs.login_streak SET last_serial=" + std::to_string(today) +
-            ", last_reward_serial=" + std::to_string(today) +
-            ", streak_day=" + std::to_string(streakDay) +
-            " WHERE account=" + std::to_string(acc);
-        CharacterDatabase.Execute(up.c_str());
-    }
+// ==== script ====
+class TokenLoginStreak : public PlayerScript
+{
+public:
+    TokenLoginStreak() : PlayerScript("TokenLoginStreak") { }
+    void OnPlayerLogin(Player* player) override { HandleLoginStreak(player); }
+};
+
+class TokenLoginStreakConfig : public WorldScript
+{
+public:
+    TokenLoginStreakConfig()
+        : WorldScript("TokenLoginStreakConfig", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP }) { }
 
-    if (separateBonus)
+    // při prvním načtení ještě nejsou item_template -> katalog staví až OnStartup
+    void OnAfterConfigLoad(bool reload) override
     {
-        DeliverEntitlementOrInventory(player, acc, cfg.baseItem, cfg.baseCount, cfg.delivery);
-        DeliverEntitlementOrInventory(player, acc, spItem, spCnt, cfg.delivery);
+        if (reload)
+            sStreakCatalog = BuildStreakCatalog(RealOnline::ConfigView());
     }
-    else
+
+    void OnStartup() override { sStreakCatalog = BuildStreakCatalog(RealOnline::ConfigView()); }
+};
+
+// ==== replay (.realonline replay) ====
+// Stejný posun série a výpočet odměny jako login, stav jen v paměti replaye.
+// Sweep na hranici dne se nepřehrává – log obsahuje jen loginy.
+class StreakReplaySink : public RealOnline::ReplaySink
+{
+public:
+    explicit StreakReplaySink(StreakCatalog&& cat) : _cat(std::move(cat)), _byStreakDay(_cat.cfg.cycleLen + 1) { }
+
+    void OnEvent(RealOnline::ReplayEvent const& ev) override
     {
-        DeliverEntitlementOrInventory(player, acc, cfg.baseItem, totalCount, cfg.delivery);
+        if (ev.type != RealOnline::ReplayEventType::Login)
+            return;
+        ++_logins;
+
+        StreakCfg const& cfg = _cat.cfg;
+        uint32 today = TodaySerial(cfg.dayBoundaryHour);
+
+        Account& a = _accounts[ev.account];
+        bool continues = a.state.exists && today == a.state.lastSerial + 1;
+        bool missed    = a.state.exists && today > a.state.lastSerial + 1;
+        if (!RealOnline::AdvanceStreak(a.state, today, cfg.cycleLen, cfg.resetOnMiss))
+            return;
+
+        if (missed && cfg.resetOnMiss)
+            ++_resets;
+        a.run = continues ? a.run + 1 : 1;
+        _longestRun = std::max(_longestRun, a.run);
+
+        StreakGrant g = RealOnline::ResolveStreakGrant(cfg.baseCount, _cat.byDay, a.state.streakDay);
+        ++_rewards;
+        ++_byStreakDay[g.streakDay];
+        _baseItems += cfg.baseCount;
+        if (g.separateBonus)
+            _separateItems += g.spCnt;
+        else
+            _bonusItems += g.totalCount - cfg.baseCount;
+
+        ++a.rewards;
+        a.items += g.separateBonus ? cfg.baseCount + g.spCnt : g.totalCount;
     }
 
-    if (cfg.announce)
+    void Report(ChatHandler* handler) override
     {
-        std::ostringstream ss;
-        if (LangOpt()==Lang::EN)
-        {
-            ss << "Congrats! Day " << streakDay << " in a row out of " << cfg.cycleLen << ". ";
-            if (separateBonus)
-                ss << "You receive " << cfg.baseCount << "× Mystery Token and additionally " << spCnt << "× Mystery Token.";
-            else if (totalCount != cfg.baseCount)
-                ss << "You receive " << totalCount << "× Mystery Token (including bonus " << (totalCount - cfg.baseCount) << "×).";
-            else
-                ss << "You receive " << cfg.baseCount << "× Mystery Token.";
-        }
-        else
+        RealOnline::SendMsg(handler, Msg::ReplayStreakTotals, _rewards, _logins, _resets,
+            _baseItems + _bonusItems + _separateItems, _baseItems, _bonusItems, _separateItems);
+
+        std::vector<uint64> rewards, items;
+        rewards.reserve(_accounts.size());
+        items.reserve(_accounts.size());
+        for (auto const& [acc, a] : _accounts)
         {
-            ss << "Gratulace! " << streakDay << ". den v řadě z " << cfg.cycleLen << ". ";
-            if (separateBonus)
-                ss << "Získáváš " << cfg.baseCount << "× Mystery Token a navíc " << spCnt << "× Mystery Token.";
-            else if (totalCount != cfg.baseCount)
-                ss << "Získáváš " << totalCount << "× Mystery Token (včetně bonusu " << (totalCount - cfg.baseCount) << "×).";
-            else
-                ss << "Získáváš " << cfg.baseCount << "× Mystery Token.";
+            rewards.push_back(a.rewards);
+            items.push_back(a.items);
         }
-        ChatHandler(player->GetSession()).SendSysMessage(ss.str().c_str());
+        uint64 maxItems = items.empty() ? 0 : *std::max_element(items.begin(), items.end());
+        RealOnline::SendMsg(handler, Msg::ReplayStreakSpread, uint64(_accounts.size()),
+            RealOnline::ReplayPercentile(rewards, 50), RealOnline::ReplayPercentile(rewards, 90),
+            RealOnline::ReplayPercentile(items, 50), RealOnline::ReplayPercentile(items, 90), maxItems, _longestRun);
+
+        RealOnline::SendReplayHistogram(handler, "streak.day", _byStreakDay);
     }
-}
 
-// ==== script ====
-class TokenLoginStreak : public PlayerScript
-{
-public:
-    TokenLoginStreak() : PlayerScript("TokenLoginStreak") { }
-    void OnPlayerLogin(Player* player) override { HandleLoginStreak(player); }
+private:
+    struct Account
+    {
+        StreakState state;
+        uint32 run     = 0; // navazující dny bez ohledu na cyklus
+        uint32 rewards = 0;
+        uint64 items   = 0;
+    };
+
+    StreakCatalog _cat;
+    std::unordered_map<uint32, Account> _accounts;
+    std::vector<uint64> _byStreakDay;
+    uint64 _logins = 0, _rewards = 0, _resets = 0;
+    uint64 _baseItems = 0, _bonusItems = 0, _separateItems = 0;
+    uint32 _longestRun = 0;
 };
 
 void Addmod_token_login_streakScripts()
 {
+    RealOnline::RegisterReplaySink([](RealOnline::ConfigView const& config) -> std::unique_ptr<RealOnline::ReplaySink>
+    {
+        StreakCatalog cat = BuildStreakCatalog(config);
+        if (cat.cfg.baseItem == 0 || cat.cfg.baseCount == 0)
+            return nullptr;
+        return std::make_unique<StreakReplaySink>(std::move(cat));
+    });
+    RealOnline::RegisterSimDriver(RealOnline::SimEvent::Login, [](uint32 acc, uint32 /*arg*/){ ProcessLoginStreak(acc, nullptr); });
+    new TokenLoginStreakConfig();
     new TokenLoginStreak();
+    new TokenLoginStreakSweep();
+    new TokenLoginStreakCommand();
 }
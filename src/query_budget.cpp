@@ -0,0 +1,66 @@
+// modules/mod-real-online/src/query_budget.cpp
+
+#include "query_budget.h"
+
+#include <atomic>
+
+namespace RealOnline
+{
+    namespace
+    {
+        struct AtomicBudgetStats
+        {
+            std::atomic<uint64> calls{0}, violations{0}, maxBlocking{0}, maxQueued{0};
+        };
+
+        std::array<AtomicBudgetStats, size_t(BudgetOp::Count)> sStats;
+        std::atomic<QueryBudgetOverrunFn> sOverrun{ nullptr };
+
+        void RaiseMax(std::atomic<uint64>& slot, uint64 v)
+        {
+            uint64 cur = slot.load(std::memory_order_relaxed);
+            while (v > cur && !slot.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+        }
+    }
+
+    QueryBudgetScope::QueryBudgetScope(BudgetOp op) : _op(op), _start(ThreadStorageCounters()) {}
+
+    QueryBudgetScope::~QueryBudgetScope()
+    {
+        StorageCounters now = ThreadStorageCounters();
+        uint64 blocking = now.blocking - _start.blocking;
+        uint64 queued   = now.queued - _start.queued;
+
+        QueryBudget const& b = QueryBudgets[size_t(_op)];
+        uint64 steps    = (uint64(_units) + b.unitsPerStep - 1) / b.unitsPerStep;
+        uint64 maxQueue = b.queuedBase + b.queuedPerStep * steps;
+
+        AtomicBudgetStats& st = sStats[size_t(_op)];
+        ++st.calls;
+        RaiseMax(st.maxBlocking, blocking);
+        RaiseMax(st.maxQueued, queued);
+
+        if (blocking <= b.blocking && queued <= maxQueue)
+            return;
+
+        ++st.violations;
+        if (QueryBudgetOverrunFn fn = sOverrun.load())
+            fn(QueryBudgetOverrun{ _op, blocking, queued, maxQueue, _units });
+    }
+
+    void SetQueryBudgetOverrunHandler(QueryBudgetOverrunFn fn)
+    {
+        sOverrun = fn;
+    }
+
+    QueryBudgetStats GetQueryBudgetStats(BudgetOp op)
+    {
+        AtomicBudgetStats const& st = sStats[size_t(op)];
+        QueryBudgetStats out;
+        out.calls       = st.calls;
+        out.violations  = st.violations;
+        out.maxBlocking = st.maxBlocking;
+        out.maxQueued   = st.maxQueued;
+        return out;
+    }
+}
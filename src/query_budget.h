@@ -0,0 +1,101 @@
+// modules/mod-real-online/src/query_budget.h
+
+#ifndef MOD_REAL_ONLINE_QUERY_BUDGET_H
+#define MOD_REAL_ONLINE_QUERY_BUDGET_H
+
+#include "core_types.h"
+#include "reward_storage.h"
+
+#include <array>
+
+// =============================
+// Rozpočet DB round tripů na operaci
+// =============================
+// Každý příkaz / hook na horké cestě běží v QueryBudgetScope. Scope porovná
+// round tripy úložiště vyvolané ve svém threadu s limitem z QueryBudgets;
+// překročení se počítá (.realonline stats) a předá handleru – server ho
+// loguje, test rozpočtu (tests/query_budget_test.cpp) na něm selže.
+// Přidání round tripu do horké cesty tak vyžaduje změnu téhle tabulky.
+namespace RealOnline
+{
+    enum class BudgetOp : uint8
+    {
+        Reward,           // .reward
+        RewardClaim,      // .reward claim
+        TokenStatus,      // .token
+        TokenDeposit,     // .token deposit
+        TokenWithdraw,    // .token withdraw
+        LoginStreak,      // login: streak
+        LoginMilestones,  // login: načtení milníků
+        LevelUp,          // level-up, jednotka = zapsaný milník
+        RewardTick,       // playtime tick, jednotka = účet
+        TokenSpend,       // nákup u obchodníka s tokeny
+        Count
+    };
+
+    // queued <= queuedBase + queuedPerStep * ceil(units / unitsPerStep)
+    struct QueryBudget
+    {
+        char const* name;
+        uint32 blocking;
+        uint32 queuedBase;
+        uint32 queuedPerStep;
+        uint32 unitsPerStep;
+    };
+
+    inline constexpr std::array<QueryBudget, size_t(BudgetOp::Count)> QueryBudgets =
+    {{
+        { "reward",           1, 0, 0, 1   }, // ReadBalance
+        { "reward.claim",     2, 0, 0, 1   }, // ReadBalance + AddClaimed
+        { "token",            1, 0, 0, 1   }, // ReadStored
+        { "token.deposit",    2, 0, 0, 1   }, // ReadStored + AddStored
+        { "token.withdraw",   2, 0, 0, 1   }, // ReadStored + TakeStored
+        { "login.streak",     1, 1, 0, 1   }, // ReadStreak + WriteStreaks
+        { "login.milestones", 0, 1, 0, 1   }, // LoadMilestones
+        { "levelup",          0, 1, 2, 1   }, // (LoadMilestones) + 2 statementy na milník v jedné transakci
+        { "reward.tick",      0, 1, 1, 500 }, // AddEntitled po UpsertRowsPerStatement řádcích (+ flush čekajících zdrojů)
+        { "token.spend",      4, 0, 0, 1   }, // (ReadBalance) + AddClaimed + TakeStored (+ AddStored při chybě)
+    }};
+
+    class QueryBudgetScope
+    {
+    public:
+        explicit QueryBudgetScope(BudgetOp op);
+        ~QueryBudgetScope();
+
+        QueryBudgetScope(QueryBudgetScope const&) = delete;
+        QueryBudgetScope& operator=(QueryBudgetScope const&) = delete;
+
+        void AddUnits(uint32 n) { _units += n; }
+
+    private:
+        BudgetOp        _op;
+        StorageCounters _start;
+        uint32          _units = 0;
+    };
+
+    struct QueryBudgetStats
+    {
+        uint64 calls       = 0;
+        uint64 violations  = 0;
+        uint64 maxBlocking = 0;
+        uint64 maxQueued   = 0;
+    };
+
+    struct QueryBudgetOverrun
+    {
+        BudgetOp op;
+        uint64   blocking;
+        uint64   queued;
+        uint64   maxQueued; // limit pro dané jednotky
+        uint32   units;
+    };
+
+    // volá se ve threadu scope; nullptr = jen počítat
+    using QueryBudgetOverrunFn = void (*)(QueryBudgetOverrun const&);
+    void SetQueryBudgetOverrunHandler(QueryBudgetOverrunFn fn);
+
+    QueryBudgetStats GetQueryBudgetStats(BudgetOp op);
+}
+
+#endif // MOD_REAL_ONLINE_QUERY_BUDGET_H
@@ -0,0 +1,241 @@
+// modules/mod-real-online/src/rate_limit.cpp
+
+#include "rate_limit.h"
+#include "messages.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "Chat.h"
+#include "WorldSession.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        struct BucketCfg
+        {
+            uint32 burst    = 5;    // max tokenů v bucketu
+            uint32 refillMs = 2000; // jeden token za refillMs
+        };
+
+        struct RateLimitCfg
+        {
+            bool enable    = true;
+            bool exemptGMs = true;
+            std::array<BucketCfg, size_t(RateLimitedCommand::Count)> buckets;
+        };
+
+        RateLimitCfg sCfg;
+
+        // tokeny drží v tisícinách, ať doplnění nepotřebuje float
+        struct Bucket
+        {
+            uint64 key      = 0; // 0 = prázdný slot
+            uint32 milli    = 0;
+            uint32 lastMs   = 0;
+        };
+
+        // Open addressing, lineární probing, kapacita mocnina dvou.
+        class BucketMap
+        {
+        public:
+            BucketMap() { _slots.resize(256); }
+
+            Bucket& FindOrInsert(uint64 key, bool& inserted)
+            {
+                if ((_size + 1) * 4 > _slots.size() * 3)
+                    Rehash(_slots.size() * 2);
+
+                size_t mask = _slots.size() - 1;
+                for (size_t i = Hash(key) & mask; ; i = (i + 1) & mask)
+                {
+                    Bucket& b = _slots[i];
+                    if (b.key == key)
+                    {
+                        inserted = false;
+                        return b;
+                    }
+                    if (b.key == 0)
+                    {
+                        b.key = key;
+                        ++_size;
+                        inserted = true;
+                        return b;
+                    }
+                }
+            }
+
+            // zahodí buckety, které jsou znovu plné (nečinné účty)
+            template<class IsFull>
+            void Compact(IsFull isFull)
+            {
+                std::vector<Bucket> old;
+                old.swap(_slots);
+                _slots.assign(old.size(), Bucket());
+                _size = 0;
+                for (Bucket const& b : old)
+                    if (b.key && !isFull(b))
+                        Reinsert(b);
+            }
+
+            size_t Size() const { return _size; }
+
+        private:
+            static size_t Hash(uint64 key)
+            {
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdULL;
+                key ^= key >> 33;
+                return size_t(key);
+            }
+
+            void Reinsert(Bucket const& b)
+            {
+                size_t mask = _slots.size() - 1;
+                size_t i = Hash(b.key) & mask;
+                while (_slots[i].key)
+                    i = (i + 1) & mask;
+                _slots[i] = b;
+                ++_size;
+            }
+
+            void Rehash(size_t capacity)
+            {
+                std::vector<Bucket> old;
+                old.swap(_slots);
+                _slots.assign(capacity, Bucket());
+                _size = 0;
+                for (Bucket const& b : old)
+                    if (b.key)
+                        Reinsert(b);
+            }
+
+            std::vector<Bucket> _slots;
+            size_t _size = 0;
+        };
+
+        BucketMap sBuckets;
+        uint32 sNowMs = 0; // posouvá se v OnUpdate
+        std::array<uint64, size_t(RateLimitedCommand::Count)> sRejected{};
+
+        char const* const CommandNames[] = { "online", "reward", "token" };
+        static_assert(std::size(CommandNames) == size_t(RateLimitedCommand::Count));
+
+        // segment klíče v configu (RealOnline.RateLimit.<Name>.Burst)
+        char const* const ConfigNames[] = { "Online", "Reward", "Token" };
+        static_assert(std::size(ConfigNames) == size_t(RateLimitedCommand::Count));
+
+        void Refill(Bucket& b, BucketCfg const& c)
+        {
+            uint32 cap     = c.burst * 1000;
+            uint32 elapsed = sNowMs - b.lastMs;
+            b.lastMs = sNowMs;
+            if (b.milli >= cap)
+                return;
+
+            uint64 add = c.refillMs ? uint64(elapsed) * 1000 / c.refillMs : cap;
+            b.milli = uint32(std::min<uint64>(cap, b.milli + add));
+        }
+
+        void LoadRateLimitConfig()
+        {
+            RateLimitCfg c;
+            c.enable    = sConfigMgr->GetOption<bool>("RealOnline.RateLimit.Enable", true);
+            c.exemptGMs = sConfigMgr->GetOption<bool>("RealOnline.RateLimit.ExemptGMs", true);
+
+            BucketCfg const defaults[] = { { 5, 2000 }, { 3, 3000 }, { 5, 2000 } };
+            for (size_t i = 0; i < c.buckets.size(); ++i)
+            {
+                std::string base = std::string("RealOnline.RateLimit.") + ConfigNames[i] + ".";
+                c.buckets[i].burst    = std::max(1u, sConfigMgr->GetOption<uint32>(base + "Burst", defaults[i].burst));
+                c.buckets[i].refillMs = sConfigMgr->GetOption<uint32>(base + "RefillMs", defaults[i].refillMs);
+            }
+            sCfg = c;
+        }
+    }
+
+    bool CheckCommandRate(ChatHandler* handler, RateLimitedCommand cmd)
+    {
+        WorldSession* session = handler->GetSession();
+        if (!sCfg.enable || !session)
+            return true;
+        if (sCfg.exemptGMs && session->GetSecurity() >= SEC_GAMEMASTER)
+            return true;
+
+        BucketCfg const& c = sCfg.buckets[size_t(cmd)];
+        uint64 key = (uint64(session->GetAccountId()) << 8) | (uint64(cmd) + 1);
+
+        bool inserted = false;
+        Bucket& b = sBuckets.FindOrInsert(key, inserted);
+        if (inserted)
+        {
+            b.milli  = c.burst * 1000;
+            b.lastMs = sNowMs;
+        }
+        else
+            Refill(b, c);
+
+        if (b.milli < 1000)
+        {
+            ++sRejected[size_t(cmd)];
+            SendMsg(handler, Msg::RateLimited);
+            return false;
+        }
+
+        b.milli -= 1000;
+        return true;
+    }
+
+    uint64 GetRateLimitRejections(RateLimitedCommand cmd)
+    {
+        return sRejected[size_t(cmd)];
+    }
+
+    char const* RateLimitedCommandName(RateLimitedCommand cmd)
+    {
+        return CommandNames[size_t(cmd)];
+    }
+}
+
+class RealOnlineRateLimitWS : public WorldScript
+{
+public:
+    RealOnlineRateLimitWS()
+        : WorldScript("RealOnlineRateLimitWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_UPDATE }) {}
+
+    void OnAfterConfigLoad(bool /*reload*/) override { RealOnline::LoadRateLimitConfig(); }
+
+    void OnUpdate(uint32 diff) override
+    {
+        using namespace RealOnline;
+        sNowMs += diff;
+
+        _compactTimer += diff;
+        if (_compactTimer < 60000)
+            return;
+        _compactTimer = 0;
+
+        sBuckets.Compact([](Bucket const& b)
+        {
+            BucketCfg const& c = sCfg.buckets[size_t((b.key & 0xFF) - 1)];
+            Bucket tmp = b;
+            Refill(tmp, c);
+            return tmp.milli >= c.burst * 1000;
+        });
+    }
+
+private:
+    uint32 _compactTimer = 0;
+};
+
+void AddRealOnlineRateLimitScripts()
+{
+    new RealOnlineRateLimitWS();
+}
@@ -0,0 +1,32 @@
+// modules/mod-real-online/src/rate_limit.h
+
+#ifndef MOD_REAL_ONLINE_RATE_LIMIT_H
+#define MOD_REAL_ONLINE_RATE_LIMIT_H
+
+#include "Define.h"
+
+class ChatHandler;
+
+// =============================
+// Token bucket per (účet, příkaz)
+// =============================
+// Kontroluje se na začátku příkazu, před jakoukoli prací s DB nebo rosterem.
+// Buckety žijí v kompaktní flat hash mapě; doplnění je líné podle času ticku.
+namespace RealOnline
+{
+    enum class RateLimitedCommand : uint8
+    {
+        Online,
+        Reward,
+        Token,
+        Count
+    };
+
+    // false = limit překročen (hráč dostal hlášku, příkaz se nemá vykonat)
+    bool CheckCommandRate(ChatHandler* handler, RateLimitedCommand cmd);
+
+    uint64 GetRateLimitRejections(RateLimitedCommand cmd);
+    char const* RateLimitedCommandName(RateLimitedCommand cmd);
+}
+
+#endif // MOD_REAL_ONLINE_RATE_LIMIT_H
@@ -0,0 +1,270 @@
+// modules/mod-real-online/src/replay.cpp
+
+#include "replay.h"
+#include "messages.h"
+
+#include "Chat.h"
+#include "GameTime.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <random>
+
+namespace RealOnline
+{
+    namespace
+    {
+        thread_local ClockSource tClockSource = nullptr;
+
+        // čas právě přehrávané události (zdroj pro Now() v replay threadu)
+        thread_local time_t tReplayNow = 0;
+
+        time_t ReplayClock() { return tReplayNow; }
+
+        std::vector<ReplaySinkFactory>& SinkFactories()
+        {
+            static std::vector<ReplaySinkFactory> factories;
+            return factories;
+        }
+
+        using ReplayClockT = std::chrono::steady_clock;
+
+        struct ReplayRun
+        {
+            std::vector<std::unique_ptr<ReplaySink>> sinks;
+            ClockSource previous = nullptr;
+            ReplayClockT::time_point started;
+            uint64 logins   = 0;
+            uint64 levelUps = 0;
+            uint64 skipped  = 0;
+
+            explicit ReplayRun(ConfigView const& config)
+            {
+                for (ReplaySinkFactory const& f : SinkFactories())
+                    if (std::unique_ptr<ReplaySink> sink = f(config))
+                        sinks.push_back(std::move(sink));
+
+                previous = SetClockSource(&ReplayClock);
+                started  = ReplayClockT::now();
+            }
+
+            ~ReplayRun() { SetClockSource(previous); }
+
+            void Feed(ReplayEvent const& ev)
+            {
+                tReplayNow = ev.time;
+                for (auto const& sink : sinks)
+                    sink->OnEvent(ev);
+                ++(ev.type == ReplayEventType::Login ? logins : levelUps);
+            }
+
+            void Report(ChatHandler* handler)
+            {
+                auto us = std::chrono::duration_cast<std::chrono::microseconds>(ReplayClockT::now() - started).count();
+                uint64 events = logins + levelUps;
+                uint64 perSec = us > 0 ? events * 1000000 / uint64(us) : 0;
+
+                SendMsg(handler, Msg::ReplayDone, events, logins, levelUps, skipped, uint64(us / 1000), perSec);
+                LOG_INFO("module", "[replay] {} event(s) ({} logins, {} level-ups, {} skipped) in {} ms, {} events/s.",
+                    events, logins, levelUps, skipped, us / 1000, perSec);
+
+                for (auto const& sink : sinks)
+                    sink->Report(handler);
+            }
+        };
+
+        // další číslo z řádku, posune p za něj
+        template<typename T>
+        bool NextNumber(char const*& p, char const* end, T& out)
+        {
+            while (p < end && (*p == ' ' || *p == '\t'))
+                ++p;
+            auto res = std::from_chars(p, end, out);
+            if (res.ec != std::errc())
+                return false;
+            p = res.ptr;
+            return true;
+        }
+
+        bool NextWord(char const*& p, char const* end, std::string_view& out)
+        {
+            while (p < end && (*p == ' ' || *p == '\t'))
+                ++p;
+            char const* start = p;
+            while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+                ++p;
+            out = std::string_view(start, size_t(p - start));
+            return !out.empty();
+        }
+
+        bool ParseEventLine(std::string_view line, ReplayEvent& ev)
+        {
+            char const* p   = line.data();
+            char const* end = p + line.size();
+
+            int64 time = 0;
+            std::string_view kind;
+            if (!NextNumber(p, end, time) || !NextWord(p, end, kind) || !NextNumber(p, end, ev.account))
+                return false;
+            ev.time = time_t(time);
+
+            if (kind == "login")
+            {
+                ev.type = ReplayEventType::Login;
+                ev.guid = 0;
+                return true;
+            }
+
+            uint32 oldLevel = 0, newLevel = 0;
+            if (kind != "levelup" || !NextNumber(p, end, ev.guid) || !NextNumber(p, end, oldLevel) || !NextNumber(p, end, newLevel)
+                || newLevel > 255 || oldLevel >= newLevel)
+                return false;
+
+            ev.type     = ReplayEventType::LevelUp;
+            ev.oldLevel = uint8(oldLevel);
+            ev.newLevel = uint8(newLevel);
+            return true;
+        }
+
+        // ---------- generátor ----------
+        // Účet má 3 postavy, ~80 % loginů jde na hlavní. Přihlášená postava pod
+        // max. levelem získá 0–3 levely (rychlost podle indexu účtu: od
+        // casual po hráče, který dosáhne max. levelu za pár týdnů).
+        constexpr uint32 GenCharsPerAccount = 3;
+        constexpr uint8  GenMaxLevel        = 80;
+        constexpr time_t GenStartTime       = 1704067200; // 2024-01-01 00:00 UTC
+    }
+
+    time_t Now()
+    {
+        return tClockSource ? tClockSource() : static_cast<time_t>(GameTime::GetGameTime().count());
+    }
+
+    ClockSource SetClockSource(ClockSource source)
+    {
+        ClockSource previous = tClockSource;
+        tClockSource = source;
+        return previous;
+    }
+
+    bool ConfigView::Override(std::string_view assignment)
+    {
+        size_t eq = assignment.find('=');
+        if (eq == std::string_view::npos || eq == 0)
+            return false;
+        _overrides[std::string(assignment.substr(0, eq))] = std::string(assignment.substr(eq + 1));
+        return true;
+    }
+
+    void RegisterReplaySink(ReplaySinkFactory factory)
+    {
+        SinkFactories().push_back(std::move(factory));
+    }
+
+    void ReplayGenerated(ChatHandler* handler, ReplayGenSpec const& spec, ConfigView const& config)
+    {
+        ReplayRun run(config);
+
+        std::mt19937 rng(spec.seed);
+        std::vector<uint8> level(size_t(spec.accounts) * GenCharsPerAccount, 1);
+
+        ReplayEvent ev;
+        for (uint32 day = 0; day < spec.days; ++day)
+        {
+            time_t dayStart = GenStartTime + time_t(day) * 86400;
+            for (uint32 a = 0; a < spec.accounts; ++a)
+            {
+                uint32 roll = rng();
+                if (roll % 100 >= spec.loginPct)
+                    continue;
+
+                uint32 acc  = a + 1;
+                uint32 slot = (roll >> 8) % 10 < 8 ? 0 : (roll >> 12) % GenCharsPerAccount;
+
+                // čas dne z vlastního čísla – (roll >> 16) má jen 16 bitů (do 18:12)
+                ev.time    = dayStart + time_t(rng() % 86400);
+                ev.account = acc;
+                ev.guid    = 0;
+                ev.type    = ReplayEventType::Login;
+                run.Feed(ev);
+
+                uint8& lvl = level[size_t(a) * GenCharsPerAccount + slot];
+                uint32 gain = std::min<uint32>((rng() % 4) * (1 + a % 3) / 2, GenMaxLevel - lvl);
+                if (!gain)
+                    continue;
+
+                ev.time    += 1800;
+                ev.guid     = a * GenCharsPerAccount + slot + 1;
+                ev.type     = ReplayEventType::LevelUp;
+                ev.oldLevel = lvl;
+                ev.newLevel = uint8(lvl + gain);
+                run.Feed(ev);
+                lvl = ev.newLevel;
+            }
+        }
+
+        run.Report(handler);
+    }
+
+    void ReplayFile(ChatHandler* handler, std::string const& path, ConfigView const& config)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            SendMsg(handler, Msg::ReplayFileError, path);
+            return;
+        }
+
+        ReplayRun run(config);
+
+        std::string line;
+        ReplayEvent ev;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#' || line == "\r")
+                continue;
+            if (ParseEventLine(line, ev))
+                run.Feed(ev);
+            else
+                ++run.skipped;
+        }
+
+        run.Report(handler);
+    }
+
+    void SendReplayHistogram(ChatHandler* handler, std::string_view title, std::vector<uint64> const& byKey)
+    {
+        constexpr uint32 PerLine = 12;
+
+        MessageBuffer buf;
+        uint32 onLine = 0;
+        for (size_t k = 0; k < byKey.size(); ++k)
+        {
+            if (!byKey[k])
+                continue;
+            if (onLine == 0)
+                buf.Append(title).Append(":");
+            buf.Append(" ").Append(k).Append("=").Append(byKey[k]);
+            if (++onLine == PerLine)
+            {
+                handler->SendSysMessage(buf.View());
+                buf.Clear();
+                onLine = 0;
+            }
+        }
+        if (onLine)
+            handler->SendSysMessage(buf.View());
+    }
+
+    uint64 ReplayPercentile(std::vector<uint64>& values, uint32 pct)
+    {
+        if (values.empty())
+            return 0;
+        size_t idx = std::min(values.size() - 1, values.size() * pct / 100);
+        std::nth_element(values.begin(), values.begin() + idx, values.end());
+        return values[idx];
+    }
+}
@@ -0,0 +1,134 @@
+// modules/mod-real-online/src/replay.h
+
+#ifndef MOD_REAL_ONLINE_REPLAY_H
+#define MOD_REAL_ONLINE_REPLAY_H
+
+#include "Define.h"
+#include "Config.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+class ChatHandler;
+
+// =============================
+// Zdroj času pro logiku odměn
+// =============================
+// Streak počítá den ze RealOnline::Now() místo přímo z GameTime. Zdroj se
+// přepíná per thread (replay ho nastaví na čas události, ostatní thready
+// dál vidí GameTime).
+namespace RealOnline
+{
+    using ClockSource = time_t (*)();
+
+    time_t Now();
+
+    // vrací předchozí zdroj, nullptr = GameTime
+    ClockSource SetClockSource(ClockSource source);
+
+    // =============================
+    // Config s přepsanými klíči
+    // =============================
+    // Katalogy streaku a milníků se staví přes ConfigView: živý server bez
+    // přepisů, replay s hodnotami z příkazu (Token.Streak.CycleLength=14 ...),
+    // takže změnu configu jde vyzkoušet bez .reload config.
+    class ConfigView
+    {
+    public:
+        // "Klíč=hodnota", false = chybí '='
+        bool Override(std::string_view assignment);
+        bool HasOverrides() const { return !_overrides.empty(); }
+
+        template<typename T>
+        T Get(std::string const& name, T const& def) const
+        {
+            auto itr = _overrides.find(name);
+            if (itr == _overrides.end())
+                return sConfigMgr->GetOption<T>(name, def);
+
+            std::string const& v = itr->second;
+            if constexpr (std::is_same_v<T, bool>)
+                return v == "1" || v == "true" || v == "True";
+            else if constexpr (std::is_same_v<T, std::string>)
+                return v;
+            else
+            {
+                char* end = nullptr;
+                unsigned long long n = std::strtoull(v.c_str(), &end, 10);
+                return end == v.c_str() ? def : T(n);
+            }
+        }
+
+    private:
+        std::unordered_map<std::string, std::string> _overrides;
+    };
+
+    // =============================
+    // Replay loginů a level-upů (.realonline replay)
+    // =============================
+    // Vygenerovaný nebo nahraný log událostí se prožene čistou logikou streaku
+    // a milníků (stejné AdvanceStreak / ResolveStreakGrant / limity účtu) nad
+    // stavem jen v paměti replaye – bez úložiště, doručení a hlášek hráčům.
+    // Každý soubor si registruje sink, který si stav i katalog postaví z
+    // ConfigView a na konci vypíše součty a rozložení.
+    //
+    // Formát souboru (seřazený podle času, # = komentář):
+    //   <unix čas> login <účet>
+    //   <unix čas> levelup <účet> <guid> <starý level> <nový level>
+    enum class ReplayEventType : uint8
+    {
+        Login,
+        LevelUp
+    };
+
+    struct ReplayEvent
+    {
+        time_t          time     = 0;
+        uint32          account  = 0;
+        uint32          guid     = 0;
+        ReplayEventType type     = ReplayEventType::Login;
+        uint8           oldLevel = 0;
+        uint8           newLevel = 0;
+    };
+
+    class ReplaySink
+    {
+    public:
+        virtual ~ReplaySink() = default;
+
+        // Now() během volání vrací ev.time
+        virtual void OnEvent(ReplayEvent const& ev) = 0;
+        virtual void Report(ChatHandler* handler) = 0;
+    };
+
+    using ReplaySinkFactory = std::function<std::unique_ptr<ReplaySink>(ConfigView const& config)>;
+
+    void RegisterReplaySink(ReplaySinkFactory factory);
+
+    struct ReplayGenSpec
+    {
+        uint32 accounts  = 1000;
+        uint32 days      = 90;
+        uint32 loginPct  = 70;  // šance loginu účtu za den
+        uint32 seed      = 1;
+    };
+
+    // běží synchronně ve world threadu, ideálně z konzole
+    void ReplayGenerated(ChatHandler* handler, ReplayGenSpec const& spec, ConfigView const& config);
+    void ReplayFile(ChatHandler* handler, std::string const& path, ConfigView const& config);
+
+    // histogram "klíč=počet" po řádcích, nuly se vynechají
+    void SendReplayHistogram(ChatHandler* handler, std::string_view title, std::vector<uint64> const& byKey);
+
+    // percentil z neseřazených hodnot (pořadí se mění)
+    uint64 ReplayPercentile(std::vector<uint64>& values, uint32 pct);
+}
+
+#endif // MOD_REAL_ONLINE_REPLAY_H
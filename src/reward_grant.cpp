@@ -0,0 +1,234 @@
+// modules/mod-real-online/src/reward_grant.cpp
+
+#include "reward_grant.h"
+#include "autoupdate.h"
+#include "bot_accounts.h"
+#include "messages.h"
+#include "reward_pipeline.h"
+#include "reward_storage.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "Chat.h"
+#include "DatabaseEnv.h"
+#include "QueryCallback.h"
+#include "AsyncCallbackProcessor.h"
+#include "WorldSession.h"
+#include "WorldSessionMgr.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        struct GrantCfg
+        {
+            uint32 activeDays  = 30;   // all-active = last_login za posledních N dní
+            uint32 rowsPerTick = 2000; // kolik účtů zapsat za jeden world tick
+        };
+
+        GrantCfg sGrantCfg;
+
+        struct GrantJob
+        {
+            uint32 id        = 0;
+            uint32 itemId    = 0;
+            uint32 count     = 0;
+            uint32 requester = 0;
+            std::vector<uint32> accounts;
+            size_t done      = 0;
+            uint32 reportedPct = 0;
+        };
+
+        std::deque<GrantJob> sJobs;
+        uint32 sNextJobId = 1;
+
+        // dotazy na auth.account (range / all-active), zpracují se v OnUpdate
+        QueryCallbackProcessor sQueries;
+
+        // GM online -> hláška do chatu v jeho jazyce, jinak (konzole/odhlášen) do logu
+        template<typename... Args>
+        void Report(uint32 requester, Msg id, Args const&... args)
+        {
+            WorldSession* session = requester ? sWorldSessionMgr->FindSession(requester) : nullptr;
+
+            MessageBuffer buf;
+            buf.Format(id, session ? SessionLang(session) : DefaultLang(), args...);
+
+            if (session)
+            {
+                ChatHandler handler(session);
+                handler.SendSysMessage(buf.View());
+            }
+            else
+                LOG_INFO("module", "[reward] {}", buf.View());
+        }
+
+        // WHERE část pro auth.account; vyloučené rozsahy se řeší přímo v SQL
+        std::string BuildTargetWhere(BulkGrantRequest const& req)
+        {
+            std::string where;
+            if (req.target == GrantTarget::Range)
+                where = "id BETWEEN " + std::to_string(req.rangeMin) + " AND " + std::to_string(req.rangeMax);
+            else
+                where = "last_login >= NOW() - INTERVAL " + std::to_string(sGrantCfg.activeDays) + " DAY";
+
+            for (auto const& [mn, mx] : req.ignore)
+                where += " AND id NOT BETWEEN " + std::to_string(mn) + " AND " + std::to_string(mx);
+            return where;
+        }
+
+        void EnqueueJob(BulkGrantRequest const& req, std::vector<uint32>&& accounts)
+        {
+            if (accounts.empty())
+            {
+                Report(req.requester, Msg::GrantNoTargets);
+                return;
+            }
+
+            GrantJob job;
+            job.id        = sNextJobId++;
+            job.itemId    = req.itemId;
+            job.count     = req.count;
+            job.requester = req.requester;
+            job.accounts  = std::move(accounts);
+
+            LOG_INFO("module", "[reward] Bulk grant #{} by account {}: item {} x{} to {} account(s).",
+                job.id, job.requester, job.itemId, job.count, job.accounts.size());
+            Report(job.requester, Msg::GrantQueued, job.id, job.accounts.size(), job.itemId, job.count);
+
+            sJobs.push_back(std::move(job));
+        }
+
+        // zapíše accounts[done, done + rows) a posune done
+        void WriteGrantChunk(GrantJob& job, size_t rows)
+        {
+            size_t end = std::min(job.accounts.size(), job.done + rows);
+            if (end <= job.done)
+                return;
+
+            std::vector<LedgerDelta> deltas;
+            deltas.reserve(end - job.done);
+            for (size_t i = job.done; i < end; ++i)
+                deltas.push_back({ job.accounts[i], job.itemId, job.count });
+
+            // chunk se zopakuje v dalším ticku
+            if (!Storage().AddEntitled(deltas))
+            {
+                LOG_WARN("module", "[reward] Bulk grant #{}: chunk of {} row(s) failed ({} storage), retrying.", job.id, deltas.size(), Storage().Name());
+                return;
+            }
+
+            NoteEntitledRows(deltas);
+            job.done = end;
+        }
+    }
+
+    void StartBulkGrant(BulkGrantRequest&& req)
+    {
+        if (req.target == GrantTarget::Online)
+        {
+            if (req.dryRun)
+            {
+                Report(req.requester, Msg::GrantDryRun, req.accounts.size(), req.itemId, req.count);
+                return;
+            }
+
+            std::vector<uint32> accounts = std::move(req.accounts);
+            EnqueueJob(req, std::move(accounts));
+            return;
+        }
+
+        // dry run bere stejná ID jako ostrý běh – bot účty filtruje až IsBotAccount,
+        // takže samotný COUNT(*) by hlásil víc účtů, než jich grant dostane
+        std::string q = "SELECT id FROM account WHERE " + BuildTargetWhere(req);
+
+        sQueries.AddCallback(LoginDatabase.AsyncQuery(q).WithCallback([req = std::move(req)](QueryResult res)
+        {
+            std::vector<uint32> accounts;
+            if (res)
+            {
+                accounts.reserve(size_t(res->GetRowCount()));
+                do
+                {
+                    uint32 acc = res->Fetch()[0].Get<uint32>();
+                    if (!IsBotAccount(acc))
+                        accounts.push_back(acc);
+                } while (res->NextRow());
+            }
+
+            if (req.dryRun)
+            {
+                Report(req.requester, Msg::GrantDryRun, accounts.size(), req.itemId, req.count);
+                return;
+            }
+            EnqueueJob(req, std::move(accounts));
+        }));
+    }
+}
+
+class RealOnlineRewardGrantWS : public WorldScript
+{
+public:
+    RealOnlineRewardGrantWS()
+        : WorldScript("RealOnlineRewardGrantWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_UPDATE, WORLDHOOK_ON_SHUTDOWN }) {}
+
+    void OnAfterConfigLoad(bool /*reload*/) override
+    {
+        using namespace RealOnline;
+        GrantCfg c;
+        c.activeDays  = sConfigMgr->GetOption<uint32>("RealOnline.Grant.ActiveDays", 30u);
+        c.rowsPerTick = std::max(1u, sConfigMgr->GetOption<uint32>("RealOnline.Grant.RowsPerTick", 2000u));
+        sGrantCfg = c;
+    }
+
+    void OnUpdate(uint32 /*diff*/) override
+    {
+        using namespace RealOnline;
+        sQueries.ProcessReadyCallbacks();
+
+        if (sJobs.empty() || !IsCustomsSchemaReady())
+            return;
+
+        GrantJob& job = sJobs.front();
+        WriteGrantChunk(job, sGrantCfg.rowsPerTick);
+
+        if (job.done >= job.accounts.size())
+        {
+            LOG_INFO("module", "[reward] Bulk grant #{} finished: {} account(s).", job.id, job.accounts.size());
+            Report(job.requester, Msg::GrantDone, job.id, job.accounts.size());
+            sJobs.pop_front();
+            return;
+        }
+
+        // průběh po 10 % – jen u grantů, které se nevejdou do jednoho ticku
+        uint32 pct = uint32(job.done * 100 / job.accounts.size());
+        if (pct / 10 > job.reportedPct / 10)
+        {
+            job.reportedPct = pct;
+            Report(job.requester, Msg::GrantProgress, job.id, job.done, job.accounts.size());
+        }
+    }
+
+    // rozpracované granty se dopíšou celé, ať se po restartu nic neztratí
+    void OnShutdown() override
+    {
+        using namespace RealOnline;
+        for (GrantJob& job : sJobs)
+        {
+            WriteGrantChunk(job, job.accounts.size());
+            LOG_INFO("module", "[reward] Bulk grant #{} flushed on shutdown: {} account(s).", job.id, job.accounts.size());
+        }
+        sJobs.clear();
+    }
+};
+
+void AddRealOnlineRewardGrantScripts()
+{
+    new RealOnlineRewardGrantWS();
+}
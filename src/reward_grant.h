@@ -0,0 +1,44 @@
+// modules/mod-real-online/src/reward_grant.h
+
+#ifndef MOD_REAL_ONLINE_REWARD_GRANT_H
+#define MOD_REAL_ONLINE_REWARD_GRANT_H
+
+#include "Define.h"
+
+#include <utility>
+#include <vector>
+
+// =============================
+// Hromadný GM grant (.reward grant)
+// =============================
+// Cíle se vyhodnotí jednou (online roster nebo jeden SELECT nad auth.account),
+// zápis jde po chuncích multi-row upsertem do customs.rewards, rozložený do
+// více ticků. Dry run jen spočítá zasažené účty.
+namespace RealOnline
+{
+    enum class GrantTarget : uint8
+    {
+        Online,    // accounts už vyfiltrované z online rosteru
+        Range,     // rangeMin..rangeMax z auth.account
+        AllActive  // auth.account s last_login v posledních RealOnline.Grant.ActiveDays dnech
+    };
+
+    struct BulkGrantRequest
+    {
+        GrantTarget target = GrantTarget::Online;
+        uint32 itemId   = 0;
+        uint32 count    = 0;
+        uint32 rangeMin = 0;
+        uint32 rangeMax = 0;
+        bool   dryRun   = false;
+        uint32 requester = 0; // účet GM pro hlášení průběhu, 0 = konzole (jen log)
+
+        std::vector<uint32> accounts;                    // GrantTarget::Online
+        std::vector<std::pair<uint32, uint32>> ignore;   // Range/AllActive – vyloučené rozsahy účtů
+    };
+
+    // Výsledek i průběh se hlásí asynchronně (session GM nebo log).
+    void StartBulkGrant(BulkGrantRequest&& req);
+}
+
+#endif // MOD_REAL_ONLINE_REWARD_GRANT_H
@@ -0,0 +1,326 @@
+// modules/mod-real-online/src/reward_pipeline.cpp
+
+#include "reward_pipeline.h"
+#include "autoupdate.h"
+#include "leaderboard.h"
+#include "messages.h"
+#include "reward_storage.h"
+#include "storage_ops.h"
+#include "token_wallet.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "Player.h"
+#include "Chat.h"
+#include "DatabaseEnv.h"
+#include "WorldSession.h"
+#include "Item.h"
+#include "Log.h"
+#include "Mail.h"
+#include "ObjectAccessor.h"
+#include "ObjectMgr.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        struct AtomicStats
+        {
+            std::atomic<uint64> grants{0}, items{0}, inventory{0}, entitlement{0}, fallback{0}, mailed{0};
+        };
+
+        std::array<AtomicStats, size_t(RewardSource::Count)> sStats;
+
+        // level-up běží i v map threadech -> fronty pod zámkem
+        EntitlementQueue sEntitlements;
+        std::mutex sPendingLock;
+
+        struct PendingMailItem
+        {
+            uint32 itemId;
+            uint32 count;
+        };
+        std::unordered_map<uint32, std::vector<PendingMailItem>> sPendingMail; // guid -> itemy
+
+        bool sOverflowToMail = true;
+    }
+
+    RewardDelivery ParseDelivery(std::string mode, char const* prefix, RewardDelivery def)
+    {
+        std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+
+        if (mode == "inventory")
+            return RewardDelivery::Inventory;
+        if (mode == "entitlement")
+            return RewardDelivery::Entitlement;
+
+        LOG_ERROR("module", "[reward] {}.Delivery = '{}' is unknown, using default.", prefix, mode);
+        return def;
+    }
+
+    static void FlushRewardMail();
+
+    void LoadRewardPipelineConfig()
+    {
+        std::string mode = sConfigMgr->GetOption<std::string>("RealOnline.Reward.Overflow", "mail");
+        std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+        sOverflowToMail = (mode != "entitlement");
+    }
+
+    bool OverflowToMail()
+    {
+        return sOverflowToMail;
+    }
+
+    uint32 StoreRewardItemPartial(Player* plr, uint32 itemId, uint32 count)
+    {
+        uint32 noSpace = 0;
+        ItemPosCountVec dest;
+        if (plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, itemId, count, &noSpace) != EQUIP_ERR_OK)
+            count = noSpace < count ? count - noSpace : 0;
+
+        if (count == 0 || dest.empty())
+            return 0;
+
+        Item* it = plr->StoreNewItem(dest, itemId, true, Item::GenerateItemRandomPropertyId(itemId));
+        if (!it)
+            return 0;
+
+        plr->SendNewItem(it, count, true, false);
+        return count;
+    }
+
+    void QueueRewardMail(Player* plr, uint32 itemId, uint32 count)
+    {
+        std::lock_guard<std::mutex> guard(sPendingLock);
+        sPendingMail[plr->GetGUID().GetCounter()].push_back({ itemId, count });
+    }
+
+    bool StoreRewardItemOrMail(Player* plr, uint32 itemId, uint32 count, uint32& mailed)
+    {
+        mailed = 0;
+        if (!sOverflowToMail)
+            return StoreRewardItem(plr, itemId, count);
+
+        uint32 stored = StoreRewardItemPartial(plr, itemId, count);
+        if (stored < count)
+        {
+            mailed = count - stored;
+            QueueRewardMail(plr, itemId, mailed);
+            // příkaz běží ve world threadu -> mail hned, ať claim/withdraw nečeká na tick
+            FlushRewardMail();
+        }
+        return true;
+    }
+
+    bool StoreRewardItem(Player* plr, uint32 itemId, uint32 count)
+    {
+        ItemPosCountVec dest;
+        if (plr->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, itemId, count) != EQUIP_ERR_OK)
+            return false;
+
+        Item* it = plr->StoreNewItem(dest, itemId, true, Item::GenerateItemRandomPropertyId(itemId));
+        if (!it)
+            return false;
+
+        plr->SendNewItem(it, count, true, false);
+        return true;
+    }
+
+    void DeliverReward(RewardSource source, RewardDelivery delivery, Player* plr, uint32 account, uint32 itemId, uint32 count)
+    {
+        AtomicStats& st = sStats[size_t(source)];
+        ++st.grants;
+        st.items += count;
+
+        // virtuální token se do tašek nedává, jde rovnou na zůstatek
+        if (delivery == RewardDelivery::Inventory && !IsVirtualToken(itemId))
+        {
+            if (plr)
+            {
+                uint32 stored = StoreRewardItemPartial(plr, itemId, count);
+                if (stored == count)
+                {
+                    ++st.inventory;
+                    return;
+                }
+
+                count -= stored;
+                ChatHandler handler(plr->GetSession());
+
+                if (sOverflowToMail)
+                {
+                    ++st.mailed;
+                    QueueRewardMail(plr, itemId, count);
+                    SendMsg(&handler, Msg::RewardInventoryFullMail, count);
+                    return;
+                }
+
+                SendMsg(&handler, Msg::RewardInventoryFull);
+            }
+            ++st.fallback;
+        }
+
+        ++st.entitlement;
+        sEntitlements.Add(account, itemId, count);
+    }
+
+    // Všechny maily ticku v jedné transakci; itemy hráče se sloučí podle
+    // entry, rozdělí na stacky a naskládají po MAX_MAIL_ITEMS do co nejméně mailů.
+    static void FlushRewardMail()
+    {
+        std::unordered_map<uint32, std::vector<PendingMailItem>> batch;
+        {
+            std::lock_guard<std::mutex> guard(sPendingLock);
+            if (sPendingMail.empty())
+                return;
+            batch.swap(sPendingMail);
+        }
+
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+        uint32 mails = 0;
+
+        for (auto& [guid, items] : batch)
+        {
+            std::sort(items.begin(), items.end(),
+                [](PendingMailItem const& a, PendingMailItem const& b){ return a.itemId < b.itemId; });
+
+            Player* receiver = ObjectAccessor::FindPlayerByLowGUID(guid);
+            Lang lang = receiver ? SessionLang(receiver->GetSession()) : DefaultLang();
+
+            std::optional<MailDraft> draft;
+            uint32 inDraft = 0;
+            auto send = [&]()
+            {
+                if (receiver)
+                    draft->SendMailTo(trans, MailReceiver(receiver, guid), MailSender(MAIL_NORMAL, 0, MAIL_STATIONERY_GM));
+                else
+                    draft->SendMailTo(trans, MailReceiver(guid), MailSender(MAIL_NORMAL, 0, MAIL_STATIONERY_GM));
+                draft.reset();
+                inDraft = 0;
+                ++mails;
+            };
+
+            for (size_t i = 0; i < items.size(); )
+            {
+                uint32 itemId = items[i].itemId;
+                uint64 total  = 0;
+                for (; i < items.size() && items[i].itemId == itemId; ++i)
+                    total += items[i].count;
+
+                ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemId);
+                if (!proto)
+                {
+                    LOG_ERROR("module", "[reward] Cannot mail unknown item {} to guid {}.", itemId, guid);
+                    continue;
+                }
+                uint32 maxStack = std::max<uint32>(1, proto->GetMaxStackSize());
+
+                while (total)
+                {
+                    uint32 n = uint32(std::min<uint64>(total, maxStack));
+                    Item* item = Item::CreateItem(itemId, n, nullptr);
+                    if (!item)
+                        break;
+
+                    if (!draft)
+                        draft.emplace(std::string(MsgText(Msg::RewardMailSubject, lang)), std::string(MsgText(Msg::RewardMailBody, lang)));
+
+                    item->SaveToDB(trans);
+                    draft->AddItem(item);
+                    total -= n;
+
+                    if (++inDraft == MAX_MAIL_ITEMS)
+                        send();
+                }
+            }
+
+            if (draft)
+                send();
+        }
+
+        CharacterDatabase.CommitTransaction(trans);
+        LOG_DEBUG("module", "[reward] Sent {} overflow mail(s) to {} player(s).", mails, batch.size());
+    }
+
+    void FlushRewardGrants()
+    {
+        FlushRewardMail();
+
+        // do doběhnutí updateru zůstávají entitlementy ve frontě
+        if (!IsCustomsSchemaReady())
+            return;
+
+        std::vector<LedgerDelta> rows;
+        if (!sEntitlements.Flush(Storage(), rows))
+        {
+            LOG_WARN("module", "[reward] Entitlement flush of {} row(s) failed ({} storage), retrying next tick.", rows.size(), Storage().Name());
+            return;
+        }
+
+        NoteEntitledRows(rows);
+
+        if (!rows.empty())
+            LOG_DEBUG("module", "[reward] Flushed {} entitlement row(s).", rows.size());
+    }
+
+    void NoteEntitledRows(std::vector<LedgerDelta> const& rows)
+    {
+        for (LedgerDelta const& d : rows)
+        {
+            NoteEntitlementDelta(d.account, d.itemId, d.count);
+            NoteTokenEntitled(d.account, d.itemId, d.count);
+        }
+    }
+
+    RewardStats GetRewardStats(RewardSource source)
+    {
+        AtomicStats const& st = sStats[size_t(source)];
+        RewardStats out;
+        out.grants      = st.grants;
+        out.items       = st.items;
+        out.inventory   = st.inventory;
+        out.entitlement = st.entitlement;
+        out.fallback    = st.fallback;
+        out.mailed      = st.mailed;
+        return out;
+    }
+
+    char const* RewardSourceName(RewardSource source)
+    {
+        switch (source)
+        {
+            case RewardSource::Playtime:  return "playtime";
+            case RewardSource::Streak:    return "streak";
+            case RewardSource::Milestone: return "milestone";
+            default:                      return "unknown";
+        }
+    }
+}
+
+// Zapisuje nasbírané entitlementy jednou za tick.
+class RealOnlineRewardPipelineWS : public WorldScript
+{
+public:
+    RealOnlineRewardPipelineWS()
+        : WorldScript("RealOnlineRewardPipelineWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_UPDATE, WORLDHOOK_ON_SHUTDOWN }) { }
+
+    void OnAfterConfigLoad(bool /*reload*/) override { RealOnline::LoadRewardPipelineConfig(); }
+
+    void OnUpdate(uint32 /*diff*/) override { RealOnline::FlushRewardGrants(); }
+    void OnShutdown() override { RealOnline::FlushRewardGrants(); }
+};
+
+void AddRealOnlineRewardPipelineScripts()
+{
+    new RealOnlineRewardPipelineWS();
+}
@@ -0,0 +1,106 @@
+// modules/mod-real-online/src/reward_pipeline.h
+
+#ifndef MOD_REAL_ONLINE_REWARD_PIPELINE_H
+#define MOD_REAL_ONLINE_REWARD_PIPELINE_H
+
+#include "Define.h"
+
+#include <string>
+#include <vector>
+
+class Player;
+
+// =============================
+// Společná doručovací pipeline odměn
+// =============================
+// Každý zdroj odměn (playtime, streak, milníky, ...) je policy struktura:
+//   Id        – RewardSource pro statistiky
+//   Prefix    – prefix config klíčů ("Token.Level" -> Token.Level.Delivery)
+//   Delivery()– režim doručení z katalogu zdroje (načtený při loadu configu)
+// Grant<Source>() se rozbalí při kompilaci, bez virtuálních volání na grant.
+namespace RealOnline
+{
+    struct LedgerDelta;
+
+    enum class RewardDelivery : uint8
+    {
+        Inventory,   // do tašek, co se nevejde -> mail (nebo entitlement, viz RealOnline.Reward.Overflow)
+        Entitlement  // rovnou do customs.rewards (vyzvedne se přes .reward claim)
+    };
+
+    enum class RewardSource : uint8
+    {
+        Playtime,
+        Streak,
+        Milestone,
+        Count
+    };
+
+    struct RewardStats
+    {
+        uint64 grants      = 0;
+        uint64 items       = 0;
+        uint64 inventory   = 0; // doručeno do tašek
+        uint64 entitlement = 0; // zapsáno jako entitlement
+        uint64 fallback    = 0; // inventory -> entitlement (plné tašky / hráč offline)
+        uint64 mailed      = 0; // inventory -> mail (plné tašky)
+    };
+
+    // "inventory" | "entitlement" (case-insensitive), hodnotu klíče <prefix>.Delivery
+    // načte volající (ConfigView – replay ji může přepsat), tady se jen převede
+    RewardDelivery ParseDelivery(std::string mode, char const* prefix, RewardDelivery def);
+
+    // Doručovací stage: inventory hned (hráč je platný jen teď), přebytek do
+    // fronty mailů, entitlementy se slučují podle (účet, item). Obojí se
+    // zapisuje hromadně ve FlushRewardGrants() jednou za tick.
+    void DeliverReward(RewardSource source, RewardDelivery delivery, Player* plr, uint32 account, uint32 itemId, uint32 count);
+    void FlushRewardGrants();
+
+    // Po každém zapsaném AddEntitled (flush pipeline, hromadný grant):
+    // přičte řádky do leaderboardu a do peněženek virtuálních tokenů.
+    void NoteEntitledRows(std::vector<LedgerDelta> const& rows);
+
+    void LoadRewardPipelineConfig();
+    bool OverflowToMail();
+
+    // Uloží item do tašek hráče; false = nevejde se / chyba.
+    bool StoreRewardItem(Player* plr, uint32 itemId, uint32 count);
+
+    // Uloží co se vejde, zbytek pošle poštou (mailed). S Overflow = entitlement
+    // se chová jako StoreRewardItem.
+    bool StoreRewardItemOrMail(Player* plr, uint32 itemId, uint32 count, uint32& mailed);
+
+    RewardStats GetRewardStats(RewardSource source);
+    char const* RewardSourceName(RewardSource source);
+
+    template<class Source>
+    inline void Grant(Player* plr, uint32 account, uint32 itemId, uint32 count)
+    {
+        if (itemId && count)
+            DeliverReward(Source::Id, Source::Delivery(), plr, account, itemId, count);
+    }
+
+    // ==== zdroje ====
+    struct PlaytimeSource
+    {
+        static constexpr RewardSource Id = RewardSource::Playtime;
+        static constexpr char const* Prefix = "RealOnline.Reward";
+        static constexpr RewardDelivery Delivery() { return RewardDelivery::Entitlement; }
+    };
+
+    struct StreakSource
+    {
+        static constexpr RewardSource Id = RewardSource::Streak;
+        static constexpr char const* Prefix = "Token.Streak";
+        static RewardDelivery Delivery(); // mod_token_login_streak.cpp
+    };
+
+    struct MilestoneSource
+    {
+        static constexpr RewardSource Id = RewardSource::Milestone;
+        static constexpr char const* Prefix = "Token.Level";
+        static RewardDelivery Delivery(); // mod_token_level_milestones.cpp
+    };
+}
+
+#endif // MOD_REAL_ONLINE_REWARD_PIPELINE_H
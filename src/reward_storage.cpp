@@ -0,0 +1,372 @@
+// modules/mod-real-online/src/reward_storage.cpp
+
+#include "reward_storage.h"
+#include "reward_storage_memory.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "DatabaseEnv.h"
+#include "QueryCallback.h"
+#include "AsyncCallbackProcessor.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace RealOnline
+{
+    namespace
+    {
+        std::string Key(uint32 account, uint32 itemId)
+        {
+            return "account=" + std::to_string(account) + " AND item=" + std::to_string(itemId);
+        }
+
+        // ==== MySQL ====
+        // Stejné dotazy, jaké dřív ležely přímo v handlerech.
+        class MySqlRewardStorage final : public RewardStorage
+        {
+        public:
+            StorageBackend Backend() const override { return StorageBackend::MySql; }
+            char const* Name() const override { return "mysql"; }
+
+            bool ReadBalance(uint32 account, uint32 itemId, LedgerBalance& out) override
+            {
+                CountBlocking();
+                // live řádek + případný archiv (vyrovnané řádky přesunuté archivačním jobem)
+                std::string key = "WHERE " + Key(account, itemId);
+                std::string q =
+                    "SELECT CAST(IFNULL(SUM(entitled),0) AS UNSIGNED), CAST(IFNULL(SUM(claimed),0) AS UNSIGNED),"
+                    " CAST(IFNULL(SUM(`stored`),0) AS UNSIGNED) FROM ("
+                    "SELECT entitled, claimed, `stored` FROM customs.rewards " + key +
+                    " UNION ALL SELECT entitled, claimed, 0 FROM customs.rewards_archive " + key + ") t";
+
+                out = LedgerBalance();
+                if (QueryResult res = CharacterDatabase.Query(q.c_str()))
+                {
+                    Field* f = res->Fetch();
+                    out.entitled = uint32(f[0].Get<uint64>());
+                    out.claimed  = uint32(f[1].Get<uint64>());
+                    out.stored   = uint32(f[2].Get<uint64>());
+                }
+                return true;
+            }
+
+            bool ReadStored(uint32 account, uint32 itemId, uint32& out) override
+            {
+                CountBlocking();
+                std::string q = "SELECT `stored` FROM customs.rewards WHERE " + Key(account, itemId) + " LIMIT 1";
+                out = 0;
+                if (QueryResult r = CharacterDatabase.Query(q.c_str()))
+                    out = r->Fetch()[0].Get<uint32>();
+                return true;
+            }
+
+            bool AddEntitled(std::vector<LedgerDelta> const& rows) override
+            {
+                CountQueued((rows.size() + UpsertRowsPerStatement - 1) / UpsertRowsPerStatement);
+                if (rows.empty())
+                    return true;
+
+                CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+                std::string up;
+                size_t inStmt = 0;
+                for (size_t i = 0; i < rows.size(); ++i)
+                {
+                    if (inStmt == 0)
+                        up = "INSERT INTO customs.rewards (`account`,`item`,`entitled`,`claimed`,`stored`) VALUES ";
+                    else
+                        up += ",";
+
+                    up += "(" + std::to_string(rows[i].account) + "," + std::to_string(rows[i].itemId) + ","
+                        + std::to_string(rows[i].count) + ",0,0)";
+
+                    if (++inStmt == UpsertRowsPerStatement || i + 1 == rows.size())
+                    {
+                        up += " ON DUPLICATE KEY UPDATE `entitled` = `entitled` + VALUES(`entitled`), updated_at = NOW()";
+                        trans->Append(up);
+                        inStmt = 0;
+                    }
+                }
+
+                CharacterDatabase.CommitTransaction(trans);
+                return true;
+            }
+
+            bool AddClaimed(uint32 account, uint32 itemId, uint32 count) override
+            {
+                CountBlocking();
+                std::string up =
+                    "INSERT INTO customs.rewards (`account`,`item`,`entitled`,`claimed`,`stored`) "
+                    "VALUES (" + std::to_string(account) + "," + std::to_string(itemId) + ",0," + std::to_string(count) + ",0) "
+                    "ON DUPLICATE KEY UPDATE `claimed` = `claimed` + VALUES(`claimed`), updated_at = NOW()";
+                CharacterDatabase.DirectExecute(up.c_str());
+                return true;
+            }
+
+            bool AddStored(uint32 account, uint32 itemId, uint32 count) override
+            {
+                CountBlocking();
+                std::string up =
+                    "INSERT INTO customs.rewards (`account`,`item`,`entitled`,`claimed`,`stored`) VALUES ("
+                    + std::to_string(account) + "," + std::to_string(itemId) + ",0,0," + std::to_string(count) + ") "
+                    "ON DUPLICATE KEY UPDATE `stored` = `stored` + VALUES(`stored`), updated_at = NOW()";
+                CharacterDatabase.DirectExecute(up.c_str());
+                return true;
+            }
+
+            bool TakeStored(uint32 account, uint32 itemId, uint32 count) override
+            {
+                CountBlocking();
+                std::string up = "UPDATE customs.rewards SET `stored` = `stored` - " + std::to_string(count)
+                               + ", updated_at = NOW() WHERE " + Key(account, itemId)
+                               + " AND `stored` >= " + std::to_string(count);
+                CharacterDatabase.DirectExecute(up.c_str());
+                return true;
+            }
+
+            bool ReadStreak(uint32 account, std::optional<StreakRecord>& out) override
+            {
+                CountBlocking();
+                std::string q =
+                    "SELECT last_serial, last_reward_serial, streak_day, consecutive_days FROM customs.login_streak WHERE account=" +
+                    std::to_string(account) + " LIMIT 1";
+                out.reset();
+                if (QueryResult r = CharacterDatabase.Query(q.c_str()))
+                {
+                    Field* f = r->Fetch();
+                    out.emplace();
+                    out->lastSerial       = f[0].Get<uint32>();
+                    out->lastRewardSerial = f[1].Get<uint32>();
+                    out->streakDay        = f[2].Get<uint32>();
+                    out->consecutiveDays  = f[3].Get<uint32>();
+                }
+                return true;
+            }
+
+            void LoadStreaks(std::vector<uint32> const& accounts, StreakLoadedFn&& done) override
+            {
+                CountQueued(accounts.empty() ? 0 : 1);
+                if (accounts.empty())
+                {
+                    done(true, StreakMap());
+                    return;
+                }
+
+                std::string q = "SELECT account, last_serial, last_reward_serial, streak_day, consecutive_days FROM customs.login_streak WHERE account IN (";
+                for (size_t i = 0; i < accounts.size(); ++i)
+                {
+                    if (i) q += ",";
+                    q += std::to_string(accounts[i]);
+                }
+                q += ")";
+
+                AddQuery(CharacterDatabase.AsyncQuery(q).WithCallback([done = std::move(done)](QueryResult result)
+                {
+                    StreakMap records;
+                    if (result)
+                    {
+                        records.reserve(size_t(result->GetRowCount()));
+                        do
+                        {
+                            Field* f = result->Fetch();
+                            StreakRecord& r    = records[f[0].Get<uint32>()];
+                            r.lastSerial       = f[1].Get<uint32>();
+                            r.lastRewardSerial = f[2].Get<uint32>();
+                            r.streakDay        = f[3].Get<uint32>();
+                            r.consecutiveDays  = f[4].Get<uint32>();
+                        } while (result->NextRow());
+                    }
+                    done(true, std::move(records));
+                }));
+            }
+
+            bool WriteStreaks(std::vector<std::pair<uint32, StreakRecord>> const& rows) override
+            {
+                CountQueued(rows.empty() ? 0 : 1);
+                if (rows.empty())
+                    return true;
+
+                std::string up = "INSERT INTO customs.login_streak (account,last_serial,last_reward_serial,streak_day,consecutive_days) VALUES ";
+                for (size_t i = 0; i < rows.size(); ++i)
+                {
+                    StreakRecord const& r = rows[i].second;
+                    if (i) up += ",";
+                    up += "(" + std::to_string(rows[i].first) + "," + std::to_string(r.lastSerial) + ","
+                        + std::to_string(r.lastRewardSerial) + "," + std::to_string(r.streakDay) + ","
+                        + std::to_string(r.consecutiveDays) + ")";
+                }
+                up += " ON DUPLICATE KEY UPDATE last_serial=VALUES(last_serial),"
+                      " last_reward_serial=VALUES(last_reward_serial), streak_day=VALUES(streak_day),"
+                      " consecutive_days=VALUES(consecutive_days)";
+                CharacterDatabase.Execute(up.c_str());
+                return true;
+            }
+
+            void LoadMilestones(uint32 account, uint32 guid, MilestoneLoadedFn&& done) override
+            {
+                CountQueued();
+                // kind 0 = čítač účtu (PK lookup), kind 1 = milníky postavy
+                std::string q =
+                    "SELECT 0, milestone, cnt FROM customs.level_milestone_counts WHERE account=" + std::to_string(account) +
+                    " UNION ALL "
+                    "SELECT 1, milestone, 1 FROM customs.level_milestones WHERE account=" + std::to_string(account) +
+                    " AND guid=" + std::to_string(guid);
+
+                AddQuery(CharacterDatabase.AsyncQuery(q).WithCallback([done = std::move(done)](QueryResult result)
+                {
+                    MilestoneSnapshot snap;
+                    if (result)
+                    {
+                        do
+                        {
+                            Field* f = result->Fetch();
+                            uint8  m = f[1].Get<uint8>();
+                            if (f[0].Get<uint64>() == 0)
+                                snap.counts.emplace_back(m, uint32(f[2].Get<uint64>()));
+                            else
+                                snap.reached.push_back(m);
+                        } while (result->NextRow());
+                    }
+                    done(true, std::move(snap));
+                }));
+            }
+
+            bool RecordMilestone(uint32 account, uint32 guid, uint8 milestone) override
+            {
+                CountQueued(2);
+                // záznam i čítač v jedné transakci – duplicitní INSERT shodí obojí
+                CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+                trans->Append("INSERT INTO customs.level_milestones (account,guid,milestone) VALUES ({},{},{})",
+                              account, guid, milestone);
+                trans->Append("INSERT INTO customs.level_milestone_counts (account,milestone,cnt) VALUES ({},{},1) "
+                              "ON DUPLICATE KEY UPDATE cnt = cnt + 1", account, milestone);
+                CharacterDatabase.CommitTransaction(trans);
+                return true;
+            }
+
+            // callbacky jen ve world threadu; zámek drží jen přesun, ne zpracování
+            // (callback smí rovnou spustit další načtení)
+            void Update() override
+            {
+                std::vector<QueryCallback> incoming;
+                {
+                    std::lock_guard<std::mutex> guard(_incomingLock);
+                    incoming.swap(_incoming);
+                }
+                for (QueryCallback& cb : incoming)
+                    _queries.AddCallback(std::move(cb));
+                _queries.ProcessReadyCallbacks();
+            }
+
+        private:
+            // načtení smí začít z libovolného threadu (QueryCallbackProcessor sám zamčený není)
+            void AddQuery(QueryCallback&& cb)
+            {
+                std::lock_guard<std::mutex> guard(_incomingLock);
+                _incoming.push_back(std::move(cb));
+            }
+
+            std::mutex                 _incomingLock;
+            std::vector<QueryCallback> _incoming;
+            QueryCallbackProcessor     _queries; // jen world thread (Update)
+        };
+
+        std::unique_ptr<RewardStorage> sStorage;
+        MemoryRewardStorage* sMemory = nullptr;
+        std::string sSnapshot; // RealOnline.Storage.Memory.Snapshot při startu
+
+        MemoryTuning ReadMemoryTuning()
+        {
+            MemoryTuning t;
+            t.latencyUs = sConfigMgr->GetOption<uint32>("RealOnline.Storage.Memory.LatencyUs", 0u);
+            t.faultRate = std::clamp(sConfigMgr->GetOption<float>("RealOnline.Storage.Memory.FaultRate", 0.0f), 0.0f, 1.0f);
+            t.faultSeed = sConfigMgr->GetOption<uint32>("RealOnline.Storage.Memory.FaultSeed", 1u);
+            return t;
+        }
+
+        StorageBackend ReadBackend()
+        {
+            std::string name = sConfigMgr->GetOption<std::string>("RealOnline.Storage.Backend", "mysql");
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            if (name == "memory")
+                return StorageBackend::Memory;
+            if (name != "mysql")
+                LOG_ERROR("module", "[storage] RealOnline.Storage.Backend = '{}' is not valid (mysql|memory), using mysql.", name);
+            return StorageBackend::MySql;
+        }
+    }
+
+    RewardStorage& Storage()
+    {
+        if (!sStorage)
+        {
+            if (ReadBackend() == StorageBackend::Memory)
+            {
+                auto mem = std::make_unique<MemoryRewardStorage>();
+                sSnapshot = sConfigMgr->GetOption<std::string>("RealOnline.Storage.Memory.Snapshot", "");
+                if (!sSnapshot.empty())
+                {
+                    SnapshotLoad load = mem->LoadSnapshot(sSnapshot);
+                    if (!load.found)
+                        LOG_INFO("module", "[storage] Snapshot {} not found, starting empty.", sSnapshot);
+                    else
+                        LOG_INFO("module", "[storage] Loaded {} row(s) from snapshot {}.", load.rows, sSnapshot);
+                    if (load.bad)
+                        LOG_WARN("module", "[storage] Snapshot {}: {} malformed line(s) skipped.", sSnapshot, load.bad);
+                }
+                mem->Configure(ReadMemoryTuning());
+                sMemory = mem.get();
+                sStorage = std::move(mem);
+                LOG_WARN("module", "[storage] Using the in-memory reward storage – data is NOT written to the database.");
+            }
+            else
+                sStorage = std::make_unique<MySqlRewardStorage>();
+        }
+        return *sStorage;
+    }
+}
+
+class RealOnlineRewardStorageWS : public WorldScript
+{
+public:
+    RealOnlineRewardStorageWS()
+        : WorldScript("RealOnlineRewardStorageWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_UPDATE, WORLDHOOK_ON_SHUTDOWN }) {}
+
+    void OnAfterConfigLoad(bool reload) override
+    {
+        using namespace RealOnline;
+        RewardStorage& storage = Storage();
+
+        // backend se mění jen restartem, latence a chyby i reloadem
+        if (reload && ReadBackend() != storage.Backend())
+            LOG_WARN("module", "[storage] RealOnline.Storage.Backend change needs a restart (still using {}).", storage.Name());
+        if (sMemory)
+            sMemory->Configure(ReadMemoryTuning());
+    }
+
+    void OnUpdate(uint32 /*diff*/) override { RealOnline::Storage().Update(); }
+
+    void OnShutdown() override
+    {
+        using namespace RealOnline;
+        Storage().Shutdown();
+
+        std::string error;
+        if (sMemory && !sSnapshot.empty())
+        {
+            if (sMemory->SaveSnapshot(sSnapshot, error))
+                LOG_INFO("module", "[storage] Snapshot saved to {}.", sSnapshot);
+            else
+                LOG_ERROR("module", "[storage] Cannot save snapshot: {}", error);
+        }
+    }
+};
+
+void AddRealOnlineRewardStorageScripts()
+{
+    new RealOnlineRewardStorageWS();
+}
@@ -0,0 +1,127 @@
+// modules/mod-real-online/src/reward_storage.h
+
+#ifndef MOD_REAL_ONLINE_REWARD_STORAGE_H
+#define MOD_REAL_ONLINE_REWARD_STORAGE_H
+
+#include "core_types.h"
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// =============================
+// Úložiště odměn (ledger, streak, milníky)
+// =============================
+// Úzké rozhraní nad customs.rewards, customs.login_streak a
+// customs.level_milestones*. Výchozí backend je MySQL (stejné SQL jako
+// dřív), "memory" drží vše v paměti – pro testy, benchmarky a simulace,
+// volitelně se snapshotem do souboru, umělou latencí a chybami.
+//
+// Synchronní metody volá world thread, vrací false při chybě backendu
+// (u MySQL jen u čtení). Asynchronní načtení doručí callback ve world
+// threadu z Update(). Žebříčky a archivace zůstávají čistě SQL.
+namespace RealOnline
+{
+    enum class StorageBackend : uint8
+    {
+        MySql,
+        Memory
+    };
+
+    struct LedgerBalance
+    {
+        uint32 entitled = 0; // live + archiv
+        uint32 claimed  = 0; // live + archiv
+        uint32 stored   = 0;
+    };
+
+    struct LedgerDelta
+    {
+        uint32 account = 0;
+        uint32 itemId  = 0;
+        uint32 count   = 0;
+    };
+
+    struct StreakRecord
+    {
+        uint32 lastSerial       = 0;
+        uint32 lastRewardSerial = 0;
+        uint32 streakDay        = 0;
+        uint32 consecutiveDays  = 0;
+    };
+
+    struct MilestoneSnapshot
+    {
+        std::vector<std::pair<uint8, uint32>> counts; // milník -> počet postav účtu
+        std::vector<uint8> reached;                   // milníky dané postavy
+    };
+
+    // round tripy do DB, u paměťového backendu stejná klasifikace jako u MySQL:
+    // blocking = world thread čeká (Query/DirectExecute), queued = async/Execute/transakce
+    struct StorageCounters
+    {
+        uint64 blocking = 0;
+        uint64 queued   = 0;
+    };
+
+    // řádků na jeden multi-row upsert AddEntitled (= jeden round trip)
+    inline constexpr size_t UpsertRowsPerStatement = 500;
+
+    using StreakMap         = std::unordered_map<uint32, StreakRecord>;
+    using StreakLoadedFn    = std::function<void(bool ok, StreakMap&& records)>;
+    using MilestoneLoadedFn = std::function<void(bool ok, MilestoneSnapshot&& snapshot)>;
+
+    class RewardStorage
+    {
+    public:
+        virtual ~RewardStorage() = default;
+
+        virtual StorageBackend Backend() const = 0;
+        virtual char const* Name() const = 0;
+
+        // ---- ledger ----
+        virtual bool ReadBalance(uint32 account, uint32 itemId, LedgerBalance& out) = 0;
+        virtual bool ReadStored(uint32 account, uint32 itemId, uint32& out) = 0;
+        // celá dávka jednou transakcí (multi-row upsert)
+        virtual bool AddEntitled(std::vector<LedgerDelta> const& rows) = 0;
+        virtual bool AddClaimed(uint32 account, uint32 itemId, uint32 count) = 0;
+        virtual bool AddStored(uint32 account, uint32 itemId, uint32 count) = 0;
+        // jen pokud stored >= count
+        virtual bool TakeStored(uint32 account, uint32 itemId, uint32 count) = 0;
+
+        // ---- streak ----
+        virtual bool ReadStreak(uint32 account, std::optional<StreakRecord>& out) = 0;
+        virtual void LoadStreaks(std::vector<uint32> const& accounts, StreakLoadedFn&& done) = 0;
+        virtual bool WriteStreaks(std::vector<std::pair<uint32, StreakRecord>> const& rows) = 0;
+
+        // ---- milníky ----
+        virtual void LoadMilestones(uint32 account, uint32 guid, MilestoneLoadedFn&& done) = 0;
+        // záznam postavy + čítač účtu atomicky
+        virtual bool RecordMilestone(uint32 account, uint32 guid, uint8 milestone) = 0;
+
+        // doručení asynchronních načtení (world thread, jednou za tick)
+        virtual void Update() = 0;
+        virtual void Shutdown() {}
+
+        StorageCounters Counters() const { return { _blocking.load(), _queued.load() }; }
+
+    protected:
+        void CountBlocking();
+        void CountQueued(uint64 n = 1);
+
+    private:
+        std::atomic<uint64> _blocking{ 0 };
+        std::atomic<uint64> _queued{ 0 };
+    };
+
+    // backend zvolený při prvním načtení configu (RealOnline.Storage.Backend)
+    RewardStorage& Storage();
+
+    // round tripy vyvolané z aktuálního threadu (pro QueryBudgetScope)
+    StorageCounters ThreadStorageCounters();
+}
+
+#endif // MOD_REAL_ONLINE_REWARD_STORAGE_H
@@ -0,0 +1,346 @@
+// modules/mod-real-online/src/reward_storage_memory.cpp
+
+#include "reward_storage_memory.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace RealOnline
+{
+    // ==== čítače round tripů (společné všem backendům) ====
+    namespace
+    {
+        thread_local StorageCounters tThreadCounters;
+    }
+
+    void RewardStorage::CountBlocking()
+    {
+        ++_blocking;
+        ++tThreadCounters.blocking;
+    }
+
+    void RewardStorage::CountQueued(uint64 n)
+    {
+        _queued += n;
+        tThreadCounters.queued += n;
+    }
+
+    StorageCounters ThreadStorageCounters()
+    {
+        return tThreadCounters;
+    }
+
+    // ==== paměť ====
+    void MemoryRewardStorage::Configure(MemoryTuning const& t)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _tuning = t;
+        _latencyUs = t.latencyUs;
+        _rng.seed(t.faultSeed);
+    }
+
+    bool MemoryRewardStorage::ReadBalance(uint32 account, uint32 itemId, LedgerBalance& out)
+    {
+        CountBlocking();
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        auto itr = _ledger.find(LedgerKey(account, itemId));
+        out = itr != _ledger.end() ? itr->second : LedgerBalance();
+        return true;
+    }
+
+    bool MemoryRewardStorage::ReadStored(uint32 account, uint32 itemId, uint32& out)
+    {
+        LedgerBalance b;
+        if (!ReadBalance(account, itemId, b))
+            return false;
+        out = b.stored;
+        return true;
+    }
+
+    bool MemoryRewardStorage::AddEntitled(std::vector<LedgerDelta> const& rows)
+    {
+        CountQueued((rows.size() + UpsertRowsPerStatement - 1) / UpsertRowsPerStatement);
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        for (LedgerDelta const& d : rows)
+            _ledger[LedgerKey(d.account, d.itemId)].entitled += d.count;
+        return true;
+    }
+
+    bool MemoryRewardStorage::AddClaimed(uint32 account, uint32 itemId, uint32 count)
+    {
+        CountBlocking();
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        _ledger[LedgerKey(account, itemId)].claimed += count;
+        return true;
+    }
+
+    bool MemoryRewardStorage::AddStored(uint32 account, uint32 itemId, uint32 count)
+    {
+        CountBlocking();
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        _ledger[LedgerKey(account, itemId)].stored += count;
+        return true;
+    }
+
+    bool MemoryRewardStorage::TakeStored(uint32 account, uint32 itemId, uint32 count)
+    {
+        CountBlocking();
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        auto itr = _ledger.find(LedgerKey(account, itemId));
+        if (itr == _ledger.end() || itr->second.stored < count)
+            return false;
+        itr->second.stored -= count;
+        return true;
+    }
+
+    bool MemoryRewardStorage::ReadStreak(uint32 account, std::optional<StreakRecord>& out)
+    {
+        CountBlocking();
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        out.reset();
+        auto itr = _streaks.find(account);
+        if (itr != _streaks.end())
+            out = itr->second;
+        return true;
+    }
+
+    void MemoryRewardStorage::LoadStreaks(std::vector<uint32> const& accounts, StreakLoadedFn&& done)
+    {
+        CountQueued(accounts.empty() ? 0 : 1);
+        Defer([this, accounts, done = std::move(done)]()
+        {
+            StreakMap records;
+            bool ok;
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                ok = !Fault();
+                if (ok)
+                    for (uint32 acc : accounts)
+                        if (auto itr = _streaks.find(acc); itr != _streaks.end())
+                            records.emplace(acc, itr->second);
+            }
+            done(ok, std::move(records));
+        });
+    }
+
+    bool MemoryRewardStorage::WriteStreaks(std::vector<std::pair<uint32, StreakRecord>> const& rows)
+    {
+        CountQueued(rows.empty() ? 0 : 1);
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        for (auto const& [acc, r] : rows)
+            _streaks[acc] = r;
+        return true;
+    }
+
+    void MemoryRewardStorage::LoadMilestones(uint32 account, uint32 guid, MilestoneLoadedFn&& done)
+    {
+        CountQueued();
+        Defer([this, account, guid, done = std::move(done)]()
+        {
+            MilestoneSnapshot snap;
+            bool ok;
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                ok = !Fault();
+                if (ok)
+                {
+                    if (auto itr = _milestoneCounts.find(account); itr != _milestoneCounts.end())
+                        for (size_t m = 1; m < itr->second.size(); ++m)
+                            if (itr->second[m])
+                                snap.counts.emplace_back(uint8(m), itr->second[m]);
+
+                    if (auto itr = _milestones.find(CharKey(account, guid)); itr != _milestones.end())
+                        for (size_t m = 1; m < itr->second.size(); ++m)
+                            if (itr->second.test(m))
+                                snap.reached.push_back(uint8(m));
+                }
+            }
+            done(ok, std::move(snap));
+        });
+    }
+
+    bool MemoryRewardStorage::RecordMilestone(uint32 account, uint32 guid, uint8 milestone)
+    {
+        CountQueued(2);
+        Delay();
+        std::lock_guard<std::mutex> guard(_lock);
+        if (Fault())
+            return false;
+
+        std::bitset<256>& bits = _milestones[CharKey(account, guid)];
+        if (bits.test(milestone))
+            return false; // jako duplicitní PK v MySQL
+        bits.set(milestone);
+        ++_milestoneCounts[account][milestone];
+        return true;
+    }
+
+    void MemoryRewardStorage::Update()
+    {
+        auto now = std::chrono::steady_clock::now();
+        for (;;)
+        {
+            std::function<void()> fn;
+            {
+                std::lock_guard<std::mutex> guard(_deferLock);
+                if (_deferred.empty() || _deferred.front().first > now)
+                    return;
+                fn = std::move(_deferred.front().second);
+                _deferred.pop_front();
+            }
+            fn();
+        }
+    }
+
+    void MemoryRewardStorage::Shutdown()
+    {
+        // rozpracovaná načtení už nikdo nečeká
+        std::lock_guard<std::mutex> guard(_deferLock);
+        _deferred.clear();
+    }
+
+    void MemoryRewardStorage::Delay() const
+    {
+        if (uint32 us = _latencyUs)
+            std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+
+    bool MemoryRewardStorage::Fault()
+    {
+        if (_tuning.faultRate <= 0.0f)
+            return false;
+        return std::uniform_real_distribution<float>(0.0f, 1.0f)(_rng) < _tuning.faultRate;
+    }
+
+    // načtení může začít z libovolného threadu, doručení jen v Update
+    void MemoryRewardStorage::Defer(std::function<void()>&& fn)
+    {
+        auto due = std::chrono::steady_clock::now() + std::chrono::microseconds(_latencyUs.load());
+        std::lock_guard<std::mutex> guard(_deferLock);
+        _deferred.emplace_back(due, std::move(fn));
+    }
+
+    // ==== snapshot ====
+    SnapshotLoad MemoryRewardStorage::LoadSnapshot(std::string const& path)
+    {
+        SnapshotLoad res;
+        std::ifstream in(path);
+        if (!in)
+            return res;
+        res.found = true;
+
+        std::lock_guard<std::mutex> guard(_lock);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream ss(line);
+            char kind = 0;
+            uint32 a = 0, b = 0, c = 0, d = 0, e = 0;
+            ss >> kind;
+            bool ok = true;
+            switch (kind)
+            {
+                case 'L':
+                    ok = bool(ss >> a >> b >> c >> d >> e);
+                    if (ok) _ledger[LedgerKey(a, b)] = LedgerBalance{ c, d, e };
+                    break;
+                case 'S':
+                    // consecutive_days chybí ve starších snapshotech -> den cyklu
+                    ok = bool(ss >> a >> b >> c >> d);
+                    if (ok && !(ss >> e))
+                        e = d;
+                    if (ok) _streaks[a] = StreakRecord{ b, c, d, e };
+                    break;
+                case 'M':
+                    ok = bool(ss >> a >> b >> c) && c < 256;
+                    if (ok) _milestones[CharKey(a, b)].set(c);
+                    break;
+                case 'C':
+                    ok = bool(ss >> a >> b >> c) && b < 256;
+                    if (ok) _milestoneCounts[a][b] = c;
+                    break;
+                default:
+                    ok = false;
+                    break;
+            }
+            ok ? ++res.rows : ++res.bad;
+        }
+        return res;
+    }
+
+    bool MemoryRewardStorage::SaveSnapshot(std::string const& path, std::string& error)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        fs::path file = path;
+        fs::path tmp = file; tmp += ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::out | std::ios::trunc);
+            if (!out)
+            {
+                error = "cannot write " + tmp.string();
+                return false;
+            }
+
+            out << "# mod-real-online storage snapshot\n";
+            for (auto const& [key, b] : _ledger)
+                out << "L " << uint32(key >> 32) << ' ' << uint32(key) << ' '
+                    << b.entitled << ' ' << b.claimed << ' ' << b.stored << '\n';
+            for (auto const& [acc, r] : _streaks)
+                out << "S " << acc << ' ' << r.lastSerial << ' ' << r.lastRewardSerial << ' ' << r.streakDay
+                    << ' ' << r.consecutiveDays << '\n';
+            for (auto const& [key, bits] : _milestones)
+                for (size_t m = 0; m < bits.size(); ++m)
+                    if (bits.test(m))
+                        out << "M " << uint32(key >> 32) << ' ' << uint32(key) << ' ' << m << '\n';
+            for (auto const& [acc, counts] : _milestoneCounts)
+                for (size_t m = 0; m < counts.size(); ++m)
+                    if (counts[m])
+                        out << "C " << acc << ' ' << m << ' ' << counts[m] << '\n';
+        }
+
+        std::error_code ec;
+        fs::rename(tmp, file, ec);
+        if (ec)
+        {
+            error = "cannot replace " + file.string() + ": " + ec.message();
+            return false;
+        }
+        return true;
+    }
+}
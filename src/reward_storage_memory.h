@@ -0,0 +1,97 @@
+// modules/mod-real-online/src/reward_storage_memory.h
+
+#ifndef MOD_REAL_ONLINE_REWARD_STORAGE_MEMORY_H
+#define MOD_REAL_ONLINE_REWARD_STORAGE_MEMORY_H
+
+#include "reward_storage.h"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+
+// =============================
+// Paměťový backend úložiště ("memory")
+// =============================
+// Bez jádra – stejnou třídu používá server (RealOnline.Storage.Backend =
+// memory) i test rozpočtu dotazů (tests/). Round tripy počítá stejně jako
+// MySQL backend. Logování snapshotu je na volajícím.
+namespace RealOnline
+{
+    struct MemoryTuning
+    {
+        uint32 latencyUs = 0;
+        float  faultRate = 0.0f;  // 0..1
+        uint32 faultSeed = 1;
+    };
+
+    struct SnapshotLoad
+    {
+        bool   found = false;
+        size_t rows  = 0;
+        size_t bad   = 0; // přeskočené řádky
+    };
+
+    // Jeden zámek nad vším (volat se smí z libovolného threadu). Latence
+    // se simuluje uspáním volajícího, u async načtení posunem doručení;
+    // chyba = operace se neprovede a vrátí false.
+    class MemoryRewardStorage final : public RewardStorage
+    {
+    public:
+        void Configure(MemoryTuning const& t);
+
+        // Textový snapshot, jeden záznam na řádek:
+        //   L account item entitled claimed stored
+        //   S account last_serial last_reward_serial streak_day consecutive_days
+        //   M account guid milestone
+        //   C account milestone cnt
+        SnapshotLoad LoadSnapshot(std::string const& path);
+        bool SaveSnapshot(std::string const& path, std::string& error);
+
+        StorageBackend Backend() const override { return StorageBackend::Memory; }
+        char const* Name() const override { return "memory"; }
+
+        bool ReadBalance(uint32 account, uint32 itemId, LedgerBalance& out) override;
+        bool ReadStored(uint32 account, uint32 itemId, uint32& out) override;
+        bool AddEntitled(std::vector<LedgerDelta> const& rows) override;
+        bool AddClaimed(uint32 account, uint32 itemId, uint32 count) override;
+        bool AddStored(uint32 account, uint32 itemId, uint32 count) override;
+        bool TakeStored(uint32 account, uint32 itemId, uint32 count) override;
+
+        bool ReadStreak(uint32 account, std::optional<StreakRecord>& out) override;
+        void LoadStreaks(std::vector<uint32> const& accounts, StreakLoadedFn&& done) override;
+        bool WriteStreaks(std::vector<std::pair<uint32, StreakRecord>> const& rows) override;
+
+        void LoadMilestones(uint32 account, uint32 guid, MilestoneLoadedFn&& done) override;
+        bool RecordMilestone(uint32 account, uint32 guid, uint8 milestone) override;
+
+        void Update() override;
+        void Shutdown() override;
+
+    private:
+        static uint64 LedgerKey(uint32 account, uint32 itemId) { return (uint64(account) << 32) | itemId; }
+        static uint64 CharKey(uint32 account, uint32 guid)     { return (uint64(account) << 32) | guid; }
+
+        void Delay() const;
+        bool Fault(); // pod _lock
+        void Defer(std::function<void()>&& fn);
+
+        MemoryTuning _tuning;
+        std::mt19937 _rng{ 1 };
+        std::mutex   _lock;
+        std::atomic<uint32> _latencyUs{ 0 };
+
+        std::unordered_map<uint64, LedgerBalance> _ledger;                       // (account << 32 | item)
+        std::unordered_map<uint32, StreakRecord>  _streaks;
+        std::unordered_map<uint64, std::bitset<256>> _milestones;                // (account << 32 | guid)
+        std::unordered_map<uint32, std::array<uint32, 256>> _milestoneCounts;    // account -> milník -> cnt
+
+        std::mutex _deferLock;
+        std::deque<std::pair<std::chrono::steady_clock::time_point, std::function<void()>>> _deferred;
+    };
+}
+
+#endif // MOD_REAL_ONLINE_REWARD_STORAGE_MEMORY_H
@@ -0,0 +1,167 @@
+// modules/mod-real-online/src/rewards_archive.cpp
+
+#include "autoupdate.h"
+#include "reward_storage.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "DatabaseEnv.h"
+#include "QueryCallback.h"
+#include "AsyncCallbackProcessor.h"
+#include "GameTime.h"
+#include "Timer.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+// =============================
+// Archivace customs.rewards
+// =============================
+// Vyrovnané řádky (entitled = claimed, stored = 0) bez změny za InactiveDays
+// se po malých dávkách přesouvají do customs.rewards_archive. Dávka je okno
+// po primárním klíči (keyset), INSERT…SELECT + DELETE v jedné krátké
+// transakci. V peak hodinách job stojí. Čtení entitled/claimed sčítá live
+// řádek a archiv, takže vracející se účet o nic nepřijde.
+namespace
+{
+    struct ArchiveCfg
+    {
+        bool   enable       = true;
+        uint32 inactiveDays = 90;
+        uint32 batchSize    = 200;
+        uint32 intervalMs   = 5000;
+        int32  peakFrom     = -1; // -1 = bez peak okna
+        int32  peakTo       = -1;
+    };
+
+    ArchiveCfg ReadArchiveCfg()
+    {
+        ArchiveCfg c;
+        c.enable       = sConfigMgr->GetOption<bool>("RealOnline.Archive.Enable", true);
+        c.inactiveDays = std::max(1u, sConfigMgr->GetOption<uint32>("RealOnline.Archive.InactiveDays", 90u));
+        c.batchSize    = std::clamp(sConfigMgr->GetOption<uint32>("RealOnline.Archive.BatchSize", 200u), 1u, 5000u);
+        c.intervalMs   = std::max(500u, sConfigMgr->GetOption<uint32>("RealOnline.Archive.IntervalMs", 5000u));
+
+        // "od-do" v lokálních hodinách, včetně obou; "20-2" přes půlnoc
+        std::string peak = sConfigMgr->GetOption<std::string>("RealOnline.Archive.PeakHours", "16-23");
+        auto dash = peak.find('-');
+        if (dash != std::string::npos)
+        {
+            int32 from = std::atoi(peak.substr(0, dash).c_str());
+            int32 to   = std::atoi(peak.substr(dash + 1).c_str());
+            if (from >= 0 && from <= 23 && to >= 0 && to <= 23)
+            {
+                c.peakFrom = from;
+                c.peakTo   = to;
+            }
+        }
+        return c;
+    }
+
+    bool InPeak(ArchiveCfg const& c)
+    {
+        if (c.peakFrom < 0)
+            return false;
+
+        int32 hour = Acore::Time::TimeBreakdown(static_cast<time_t>(GameTime::GetGameTime().count())).tm_hour;
+        if (c.peakFrom <= c.peakTo)
+            return hour >= c.peakFrom && hour <= c.peakTo;
+        return hour >= c.peakFrom || hour <= c.peakTo;
+    }
+}
+
+class RealOnlineRewardsArchiveWS : public WorldScript
+{
+public:
+    RealOnlineRewardsArchiveWS()
+        : WorldScript("RealOnlineRewardsArchiveWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_UPDATE }) {}
+
+    void OnAfterConfigLoad(bool /*reload*/) override { _cfg = ReadArchiveCfg(); }
+
+    void OnUpdate(uint32 diff) override
+    {
+        _queryProcessor.ProcessReadyCallbacks();
+
+        _timer += diff;
+        if (_timer < _cfg.intervalMs)
+            return;
+        _timer = 0;
+
+        // archiv existuje jen v MySQL backendu
+        if (!_cfg.enable || _inFlight || !RealOnline::IsCustomsSchemaReady() || InPeak(_cfg))
+            return;
+        if (RealOnline::Storage().Backend() != RealOnline::StorageBackend::MySql)
+            return;
+
+        // horní hranice okna = batchSize-tý klíč za kurzorem (čistý range scan po PK)
+        std::string q = "SELECT account, item FROM customs.rewards WHERE (account, item) > ("
+                      + std::to_string(_cursorAccount) + "," + std::to_string(_cursorItem)
+                      + ") ORDER BY account, item LIMIT " + std::to_string(_cfg.batchSize - 1) + ",1";
+
+        _inFlight = true;
+        _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(q).WithCallback([this](QueryResult res)
+        {
+            _inFlight = false;
+
+            std::string window = "(account, item) > (" + std::to_string(_cursorAccount) + "," + std::to_string(_cursorItem) + ")";
+            bool last = !res;
+            uint32 upAccount = 0, upItem = 0;
+            if (!last)
+            {
+                Field* f  = res->Fetch();
+                upAccount = f[0].Get<uint32>();
+                upItem    = f[1].Get<uint32>();
+                window += " AND (account, item) <= (" + std::to_string(upAccount) + "," + std::to_string(upItem) + ")";
+            }
+
+            ArchiveWindow(window);
+
+            if (last)
+            {
+                LOG_DEBUG("module", "[reward] Archive pass over customs.rewards finished.");
+                _cursorAccount = 0;
+                _cursorItem    = 0;
+            }
+            else
+            {
+                _cursorAccount = upAccount;
+                _cursorItem    = upItem;
+            }
+        }));
+    }
+
+private:
+    // INSERT…SELECT drží sdílené zámky jen na řádcích okna, DELETE má stejnou
+    // podmínku -> co se mezitím změnilo, se nepřesune ani nesmaže. Hranice
+    // stáří je konstanta spočtená jednou: s NOW() v každém příkazu zvlášť by
+    // řádek, který ji mezi nimi překročí, DELETE smazal bez archivace.
+    void ArchiveWindow(std::string const& window)
+    {
+        int64 cutoff = int64(GameTime::GetGameTime().count()) - int64(_cfg.inactiveDays) * 86400;
+        std::string cond = window + " AND entitled = claimed AND stored = 0"
+                           " AND updated_at < FROM_UNIXTIME(" + std::to_string(std::max<int64>(cutoff, 0)) + ")";
+
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+        trans->Append("INSERT INTO customs.rewards_archive (account, item, entitled, claimed, updated_at) "
+                      "SELECT account, item, entitled, claimed, updated_at FROM customs.rewards WHERE " + cond +
+                      " ON DUPLICATE KEY UPDATE rewards_archive.entitled = rewards_archive.entitled + VALUES(entitled),"
+                      " rewards_archive.claimed = rewards_archive.claimed + VALUES(claimed),"
+                      " rewards_archive.updated_at = VALUES(updated_at)");
+        trans->Append("DELETE FROM customs.rewards WHERE " + cond);
+        CharacterDatabase.CommitTransaction(trans);
+    }
+
+    QueryCallbackProcessor _queryProcessor;
+    ArchiveCfg _cfg;
+    uint32 _timer         = 0;
+    uint32 _cursorAccount = 0;
+    uint32 _cursorItem    = 0;
+    bool   _inFlight      = false;
+};
+
+void AddRealOnlineRewardsArchiveScripts()
+{
+    new RealOnlineRewardsArchiveWS();
+}
@@ -0,0 +1,89 @@
+// modules/mod-real-online/src/roster_harness.cpp
+
+#include "roster_harness.h"
+
+#include <random>
+
+namespace RealOnline
+{
+    void StandInRoster::Reset(uint32 count, uint32 firstAccount, uint32 gmEvery, uint32 seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> len(4, 12), ch(0, 25), level(1, 80);
+
+        _firstAccount = firstAccount;
+        _players.assign(count, StandInPlayer());
+        for (uint32 i = 0; i < count; ++i)
+        {
+            StandInPlayer& p = _players[i];
+            p.name.resize(size_t(len(rng)));
+            for (size_t c = 0; c < p.name.size(); ++c)
+                p.name[c] = char((c ? 'a' : 'A') + ch(rng));
+
+            p.view.account    = firstAccount + i;
+            p.view.level      = uint32(level(rng));
+            p.view.gameMaster = gmEvery && i % gmEvery == gmEvery - 1;
+            p.faction         = i % 2 ? Msg::FactionHorde : Msg::FactionAlliance;
+        }
+    }
+
+    PlayerView const* StandInRoster::Find(uint32 account) const
+    {
+        if (account < _firstAccount || account - _firstAccount >= _players.size())
+            return nullptr;
+        return &_players[account - _firstAccount].view;
+    }
+
+    bool StandInRoster::RenderPage(EligibilityFilter const& f, uint32 online, std::string_view args, uint32 pageSize,
+                                   bool showLevel, Lang lang, size_t& bytes, Msg& err)
+    {
+        bytes = 0;
+        online = std::min<uint32>(online, uint32(_players.size()));
+
+        _list.clear();
+        for (uint32 i = 0; i < online; ++i)
+            if (CheckEligibility(f, _players[i].view) == Eligibility::Eligible)
+                _list.push_back(&_players[i]);
+
+        SortRoster(_list, [](StandInPlayer const* p) -> std::string const& { return p->name; });
+
+        uint32 total = uint32(_list.size());
+        uint32 beginIndex = 0, endIndex = 0, errArg = 0;
+        if (!ParsePageOrRange(args, total, pageSize, beginIndex, endIndex, err, errArg))
+            return false;
+
+        MessageBuffer head;
+        FormatRosterHead(head, lang, args, total, pageSize, beginIndex, endIndex);
+        bytes += head.Size();
+
+        _lines.clear();
+        for (uint32 i = beginIndex; i < endIndex; ++i)
+        {
+            StandInPlayer const* p = _list[i];
+            _lines.push_back({ p->name, p->view.level, MsgText(p->faction, lang) });
+        }
+
+        RenderRoster(_lines.data(), _lines.size(), showLevel, [&bytes](std::string_view chunk){ bytes += chunk.size(); });
+        return true;
+    }
+
+    void StandInRoster::CollectEligible(EligibilityFilter const& f, uint32 online, std::vector<uint32>& out, uint32& afkSkipped) const
+    {
+        out.clear();
+        online = std::min<uint32>(online, uint32(_players.size()));
+        for (uint32 i = 0; i < online; ++i)
+        {
+            switch (CheckEligibility(f, _players[i].view))
+            {
+                case Eligibility::Eligible:
+                    out.push_back(_players[i].view.account);
+                    break;
+                case Eligibility::Afk:
+                    ++afkSkipped;
+                    break;
+                case Eligibility::Excluded:
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+// modules/mod-real-online/src/roster_harness.h
+
+#ifndef MOD_REAL_ONLINE_ROSTER_HARNESS_H
+#define MOD_REAL_ONLINE_ROSTER_HARNESS_H
+
+#include "roster_view.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =============================
+// Náhradní roster (benchmark, simulátor, testy)
+// =============================
+// Syntetičtí hráči místo sessions. .online i výběr účtů pro playtime tick
+// nad nimi běží přes stejný filtr, řazení, stránkování a výpis jako na
+// serveru; chybí jen procházení sessions / hráčů map, gettery Player a
+// odeslání do chatu.
+namespace RealOnline
+{
+    struct StandInPlayer
+    {
+        std::string name;
+        PlayerView  view;
+        Msg         faction = Msg::FactionAlliance;
+    };
+
+    class StandInRoster
+    {
+    public:
+        // count hráčů s účty od firstAccount, každý gmEvery-tý je GM (0 = žádný);
+        // pevný seed -> běhy jsou srovnatelné
+        void Reset(uint32 count, uint32 firstAccount, uint32 gmEvery = 100, uint32 seed = 42);
+
+        uint32 Size() const { return uint32(_players.size()); }
+        PlayerView const* Find(uint32 account) const;
+
+        // .online <args> nad prvními online hráči: filtr, řazení podle jména,
+        // stránka, hlavička a výpis; bytes = délka výpisu, false = chybný argument
+        bool RenderPage(EligibilityFilter const& f, uint32 online, std::string_view args, uint32 pageSize,
+                        bool showLevel, Lang lang, size_t& bytes, Msg& err);
+
+        // playtime tick: účty prvních online hráčů, které projdou filtrem
+        void CollectEligible(EligibilityFilter const& f, uint32 online, std::vector<uint32>& out, uint32& afkSkipped) const;
+
+    private:
+        std::vector<StandInPlayer> _players;
+        uint32 _firstAccount = 0;
+
+        // kapacita zůstává mezi voláními jako u HandleOnline
+        std::vector<StandInPlayer const*> _list;
+        std::vector<RosterLine> _lines;
+    };
+}
+
+#endif // MOD_REAL_ONLINE_ROSTER_HARNESS_H
@@ -0,0 +1,72 @@
+// modules/mod-real-online/src/roster_view.cpp
+
+#include "roster_view.h"
+#include "text_parse.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace RealOnline
+{
+    bool ParsePageOrRange(std::string_view args, uint32 total, uint32 pageSize,
+                          uint32& outBeginIndex, uint32& outEndIndex, Msg& err, uint32& errArg)
+    {
+        outBeginIndex = 0; outEndIndex = 0; errArg = 0;
+
+        std::string_view s = TrimView(args);
+        if (s.empty())
+        {
+            outBeginIndex = 0;
+            outEndIndex   = std::min(pageSize, total);
+            return true;
+        }
+
+        auto dash = s.find('-');
+        if (dash != std::string_view::npos)
+        {
+            std::string_view a = TrimView(s.substr(0, dash));
+            std::string_view b = TrimView(s.substr(dash + 1));
+            if (a.empty() || b.empty()) { err = Msg::RangeFormat; return false; }
+            if (!std::all_of(a.begin(), a.end(), ::isdigit) || !std::all_of(b.begin(), b.end(), ::isdigit))
+            { err = Msg::RangeDigits; return false; }
+            uint32 A = 0, B = 0;
+            if (!ParseU32(a, A) || !ParseU32(b, B) || A == 0 || B == 0 || A > B) { err = Msg::RangeInvalid; return false; }
+            if (A > total) { err = Msg::RangeStartBeyond; return false; }
+            outBeginIndex = A - 1;
+            outEndIndex   = std::min(B, total);
+            return true;
+        }
+
+        uint32 page = 0;
+        if (!std::all_of(s.begin(), s.end(), ::isdigit))
+        { err = Msg::PageExpected; return false; }
+        if (!ParseU32(s, page) || page == 0) { err = Msg::PageStartsAtOne; return false; }
+
+        uint32 pages = (total + pageSize - 1) / pageSize;
+        if (pages == 0) pages = 1;
+        if (page > pages)
+        {
+            err    = Msg::PageNotExist;
+            errArg = pages;
+            return false;
+        }
+
+        outBeginIndex = (page - 1) * pageSize;
+        outEndIndex   = std::min(outBeginIndex + pageSize, total);
+        return true;
+    }
+
+    void FormatRosterHead(MessageBuffer& out, Lang lang, std::string_view args, uint32 total, uint32 pageSize,
+                          uint32 beginIndex, uint32 endIndex)
+    {
+        if (args.find('-') != std::string_view::npos)
+        {
+            out.Format(Msg::OnlineHeadRange, lang, total, beginIndex + 1, endIndex);
+            return;
+        }
+
+        uint32 pages = (total + pageSize - 1) / pageSize;
+        if (pages == 0) pages = 1;
+        out.Format(Msg::OnlineHeadPage, lang, total, beginIndex / pageSize + 1, pages, pageSize);
+    }
+}
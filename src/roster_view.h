@@ -0,0 +1,112 @@
+// modules/mod-real-online/src/roster_view.h
+
+#ifndef MOD_REAL_ONLINE_ROSTER_VIEW_H
+#define MOD_REAL_ONLINE_ROSTER_VIEW_H
+
+#include "message_catalog.h"
+#include "text_parse.h"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+// =============================
+// Filtr, stránkování a výpis seznamu .online
+// =============================
+// Procházení sessions a map zůstává v mod_real_online.cpp; tady je filtr
+// hráče (.online, playtime tick) nad náhradou za Player* a práce nad hotovým
+// seznamem. Stejný kód měří samostatný benchmark a simulátor (roster_harness.h).
+namespace RealOnline
+{
+    // co filtry potřebují z Player/WorldSession
+    struct PlayerView
+    {
+        uint32 account    = 0;
+        uint32 level      = 0;
+        bool   inWorld    = true;
+        bool   gameMaster = false;
+    };
+
+    struct EligibilityFilter
+    {
+        bool   hideGMs     = false;
+        uint32 minLevel    = 0;
+        uint32 activeSince = 0; // 0 = bez AFK filtru
+        std::vector<Range> ignoreRanges;
+        bool (*isBot)(uint32 account) = nullptr;                      // nullptr = bez botů
+        bool (*isActiveSince)(uint32 account, uint32 since) = nullptr; // nullptr = všichni aktivní
+    };
+
+    enum class Eligibility : uint8
+    {
+        Eligible,
+        Excluded, // mimo svět, GM, level, ignorovaný rozsah, bot
+        Afk
+    };
+
+    // volá se i z map threadů – filtr se během update map nemění
+    inline Eligibility CheckEligibility(EligibilityFilter const& f, PlayerView const& p)
+    {
+        if (!p.inWorld)
+            return Eligibility::Excluded;
+        if (f.hideGMs && p.gameMaster)
+            return Eligibility::Excluded;
+        if (f.minLevel > 0 && p.level < f.minLevel)
+            return Eligibility::Excluded;
+        if (!f.ignoreRanges.empty() && InRanges(p.account, f.ignoreRanges))
+            return Eligibility::Excluded;
+        if (f.isBot && f.isBot(p.account))
+            return Eligibility::Excluded;
+        if (f.activeSince && f.isActiveSince && !f.isActiveSince(p.account, f.activeSince))
+            return Eligibility::Afk;
+        return Eligibility::Eligible;
+    }
+
+    // .online řadí podle jména; name(x) -> std::string const&
+    template<class T, class Name>
+    void SortRoster(std::vector<T>& list, Name&& name)
+    {
+        std::sort(list.begin(), list.end(), [&name](T const& a, T const& b){ return name(a) < name(b); });
+    }
+
+    // stránkování / rozsah A-B; výstup [begin, end) (EXCLUSIVE)
+    // chyba -> err (+ errArg pro Msg::PageNotExist)
+    bool ParsePageOrRange(std::string_view args, uint32 total, uint32 pageSize,
+                          uint32& outBeginIndex, uint32& outEndIndex, Msg& err, uint32& errArg);
+
+    // hlavička výpisu: stránka, nebo rozsah (args s '-') podle ParsePageOrRange
+    void FormatRosterHead(MessageBuffer& out, Lang lang, std::string_view args, uint32 total, uint32 pageSize,
+                          uint32 beginIndex, uint32 endIndex);
+
+    struct RosterLine
+    {
+        std::string_view name;
+        uint32 level = 0;
+        std::string_view faction;
+    };
+
+    // řádky se skládají do MessageBufferu, plný buffer -> send(chunk)
+    template<class Send>
+    void RenderRoster(RosterLine const* lines, size_t count, bool showLevel, Send&& send)
+    {
+        MessageBuffer out;
+        for (size_t i = 0; i < count; ++i)
+        {
+            RosterLine const& l = lines[i];
+            if (out.Remaining() < l.name.size() + l.faction.size() + 24)
+            {
+                send(out.View());
+                out.Clear();
+            }
+
+            out.Append(l.name);
+            if (showLevel)
+                out.Append(" [lvl ").Append(l.level).Append("]");
+            out.Append(" - ").Append(l.faction).Append("\n");
+        }
+        if (!out.Empty())
+            send(out.View());
+    }
+}
+
+#endif // MOD_REAL_ONLINE_ROSTER_VIEW_H
@@ -0,0 +1,312 @@
+// modules/mod-real-online/src/sql_reader.cpp
+
+#include "sql_reader.h"
+#include "text_parse.h"
+
+#include <algorithm>
+#include <cctype>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/resource.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace RealOnline
+{
+    // ---------- mmap ----------
+    MappedSqlFile::MappedSqlFile(std::string const& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+        _file = file;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file, &sz)) return;
+        _size = size_t(sz.QuadPart);
+        _open = true;
+        if (_size == 0) return;
+        _mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!_mapping) { _open = false; return; }
+        _data = static_cast<char const*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        _open = _data != nullptr;
+#else
+        _fd = ::open(path.c_str(), O_RDONLY);
+        if (_fd < 0) return;
+        struct stat st;
+        if (::fstat(_fd, &st) != 0) return;
+        _size = size_t(st.st_size);
+        _open = true;
+        if (_size == 0) return;
+        void* p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (p == MAP_FAILED) { _open = false; return; }
+        _data = static_cast<char const*>(p);
+        ::madvise(p, _size, MADV_SEQUENTIAL);
+#endif
+    }
+
+    MappedSqlFile::~MappedSqlFile()
+    {
+#ifdef _WIN32
+        if (_data) UnmapViewOfFile(_data);
+        if (_mapping) CloseHandle(_mapping);
+        if (_file) CloseHandle(_file);
+#else
+        if (_data) ::munmap(const_cast<char*>(_data), _size);
+        if (_fd >= 0) ::close(_fd);
+#endif
+    }
+
+    void MappedSqlFile::Release(size_t upTo)
+    {
+#ifndef _WIN32
+        static size_t const page = size_t(::sysconf(_SC_PAGESIZE));
+        size_t end = (std::min(upTo, _size) / page) * page;
+        if (_data && end > _released)
+        {
+            ::madvise(const_cast<char*>(_data) + _released, end - _released, MADV_DONTNEED);
+            _released = end;
+        }
+#else
+        (void)upTo;
+#endif
+    }
+
+    void MappedSqlFile::ReleaseBehind(size_t offset)
+    {
+#ifndef _WIN32
+        if (offset >= _released + 2 * ReleaseLag)
+            Release(offset - ReleaseLag);
+#else
+        (void)offset;
+#endif
+    }
+
+    void MappedSqlFile::Rewind()
+    {
+#ifndef _WIN32
+        if (_data && _size)
+            ::madvise(const_cast<char*>(_data), _size, MADV_DONTNEED);
+        _released = 0;
+#endif
+    }
+
+    // ---------- tokenizer ----------
+    namespace
+    {
+        bool IsSpace(char c) { return std::isspace((unsigned char)c) != 0; }
+
+        // needle musí být velkými písmeny; první znak se porovná levně,
+        // EqualsI až na kandidátech (SplitInsert hledá přes celé n-tice)
+        size_t FindI(std::string_view hay, std::string_view needle)
+        {
+            if (needle.empty() || needle.size() > hay.size()) return std::string_view::npos;
+            char const upper = needle[0];
+            char const lower = char(std::tolower((unsigned char)upper));
+            for (size_t i = 0; i + needle.size() <= hay.size(); ++i)
+                if ((hay[i] == upper || hay[i] == lower) && EqualsI(hay.substr(i, needle.size()), needle))
+                    return i;
+            return std::string_view::npos;
+        }
+
+        std::string_view FirstWord(std::string_view s)
+        {
+            size_t e = 0;
+            while (e < s.size() && std::isalpha((unsigned char)s[e])) ++e;
+            return s.substr(0, e);
+        }
+    }
+
+    SqlStatementReader::SqlStatementReader(std::string_view src) : _src(src)
+    {
+        if (_src.size() >= 3 && (unsigned char)_src[0] == 0xEF && (unsigned char)_src[1] == 0xBB && (unsigned char)_src[2] == 0xBF)
+            _pos = 3;
+    }
+
+    bool SqlStatementReader::Next(std::string_view& stmt)
+    {
+        while (true)
+        {
+            SkipSpaceAndComments();
+            if (_pos >= _src.size())
+                return false;
+
+            if (StartsWithI(_src.substr(_pos), "DELIMITER") && _pos + 9 < _src.size() && IsSpace(_src[_pos + 9]))
+            {
+                size_t eol = _src.find('\n', _pos);
+                if (eol == std::string_view::npos) eol = _src.size();
+                std::string_view delim = TrimView(_src.substr(_pos + 9, eol - _pos - 9));
+                _delim.assign(delim.data(), delim.size());
+                if (_delim.empty()) _delim = ";";
+                _pos = eol;
+                continue;
+            }
+
+            size_t start = _pos;
+            size_t end   = ScanToDelimiter();
+            stmt = TrimView(_src.substr(start, end - start));
+
+            if (stmt.empty() || StartsWithI(stmt, "USE ") || EqualsI(stmt, "SELECT 1"))
+                continue;
+            return true;
+        }
+    }
+
+    // -- je komentář jen s mezerou/koncem řádku za sebou (jako v MySQL)
+    bool SqlStatementReader::AtLineComment() const
+    {
+        char c = _src[_pos];
+        if (c == '#') return true;
+        return c == '-' && _pos + 1 < _src.size() && _src[_pos + 1] == '-'
+            && (_pos + 2 >= _src.size() || IsSpace(_src[_pos + 2]));
+    }
+
+    bool SqlStatementReader::AtBlockComment() const
+    {
+        return _src[_pos] == '/' && _pos + 1 < _src.size() && _src[_pos + 1] == '*';
+    }
+
+    void SqlStatementReader::SkipComment()
+    {
+        if (AtBlockComment())
+        {
+            size_t e = _src.find("*/", _pos + 2);
+            _pos = (e == std::string_view::npos) ? _src.size() : e + 2;
+        }
+        else
+        {
+            size_t e = _src.find('\n', _pos);
+            _pos = (e == std::string_view::npos) ? _src.size() : e + 1;
+        }
+    }
+
+    void SqlStatementReader::SkipSpaceAndComments()
+    {
+        while (_pos < _src.size())
+        {
+            if (IsSpace(_src[_pos])) { ++_pos; continue; }
+            if (AtLineComment() || AtBlockComment()) { SkipComment(); continue; }
+            break;
+        }
+    }
+
+    // posune _pos za delimiter, vrátí konec statementu (bez delimiteru)
+    size_t SqlStatementReader::ScanToDelimiter()
+    {
+        char quote = 0;
+        while (_pos < _src.size())
+        {
+            char c = _src[_pos];
+            if (quote)
+            {
+                if (c == '\\' && quote != '`') { _pos += 2; continue; }
+                if (c == quote) quote = 0;
+                ++_pos;
+                continue;
+            }
+
+            if (c == '\'' || c == '"' || c == '`') { quote = c; ++_pos; continue; }
+            if (AtLineComment() || AtBlockComment()) { SkipComment(); continue; }
+
+            if (c == _delim[0] && _src.compare(_pos, _delim.size(), _delim) == 0)
+            {
+                size_t end = _pos;
+                _pos += _delim.size();
+                return end;
+            }
+            ++_pos;
+        }
+        return _src.size();
+    }
+
+    // ---------- klasifikace a slučování ----------
+    bool IsDdl(std::string_view stmt)
+    {
+        std::string_view w = FirstWord(stmt);
+        for (char const* kw : { "CREATE", "ALTER", "DROP", "RENAME", "TRUNCATE" })
+            if (EqualsI(w, kw))
+                return true;
+        return false;
+    }
+
+    bool SplitInsert(std::string_view stmt, std::string_view& prefix, std::string_view& tuples)
+    {
+        std::string_view w = FirstWord(stmt);
+        if (!EqualsI(w, "INSERT") && !EqualsI(w, "REPLACE"))
+            return false;
+
+        size_t quote = stmt.find_first_of("'\"");
+        size_t v = FindI(stmt.substr(0, quote), "VALUES");
+        if (v == std::string_view::npos || v == 0 || !(IsSpace(stmt[v - 1]) || stmt[v - 1] == ')'))
+            return false;
+
+        std::string_view rest = stmt.substr(v + 6);
+        size_t i = 0;
+        while (i < rest.size() && IsSpace(rest[i])) ++i;
+        if (i >= rest.size() || rest[i] != '(')
+            return false;
+        if (FindI(rest, "ON DUPLICATE") != std::string_view::npos)
+            return false;
+
+        prefix = stmt.substr(0, v + 6);
+        tuples = rest.substr(i);
+        return true;
+    }
+
+    void StatementBatcher::Add(std::string_view stmt)
+    {
+        ++_statements;
+
+        std::string_view prefix, tuples;
+        if (!SplitInsert(stmt, prefix, tuples))
+        {
+            Flush();
+            Send(stmt);
+            return;
+        }
+
+        if (!_buf.empty() && prefix == _prefix && _buf.size() + 1 + tuples.size() <= _max)
+        {
+            _buf += ',';
+            _buf.append(tuples);
+            return;
+        }
+
+        Flush();
+        _prefix.assign(prefix);
+        _buf.assign(stmt);
+    }
+
+    void StatementBatcher::Flush()
+    {
+        if (_buf.empty()) return;
+        Send(_buf);
+        _buf.clear();
+        _prefix.clear();
+    }
+
+    void StatementBatcher::Send(std::string_view stmt)
+    {
+        ++_roundTrips;
+        _sink(stmt);
+    }
+
+    uint64 PeakRssKB()
+    {
+#ifdef _WIN32
+        return 0;
+#else
+        struct rusage ru;
+        if (::getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+#ifdef __APPLE__
+        return uint64(ru.ru_maxrss) / 1024;
+#else
+        return uint64(ru.ru_maxrss);
+#endif
+#endif
+    }
+}
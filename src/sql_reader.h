@@ -0,0 +1,121 @@
+// modules/mod-real-online/src/sql_reader.h
+
+#ifndef MOD_REAL_ONLINE_SQL_READER_H
+#define MOD_REAL_ONLINE_SQL_READER_H
+
+#include "core_types.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+// =============================
+// Čtení SQL souborů updateru
+// =============================
+// Mapování souboru, tokenizer statementů a slučování INSERTů – bez DB a bez
+// jádra, takže je měří samostatný benchmark (bench/) stejným kódem, jaký
+// pouští updater.
+namespace RealOnline
+{
+    // Soubor se mapuje jen pro čtení; zpracovaná část se průběžně vrací OS,
+    // takže RSS zůstává omezené i u migrací o stovkách MB.
+    class MappedSqlFile
+    {
+    public:
+        explicit MappedSqlFile(std::string const& path);
+        ~MappedSqlFile();
+
+        MappedSqlFile(MappedSqlFile const&) = delete;
+        MappedSqlFile& operator=(MappedSqlFile const&) = delete;
+
+        bool IsOpen() const { return _open; }
+        size_t Size() const { return _size; }
+        std::string_view View() const { return _data ? std::string_view(_data, _size) : std::string_view(); }
+
+        // Volá se průběžně s pozicí čtení; stránky víc než ReleaseLag za ní
+        // vrátí OS. Každý průchod souborem ji musí volat (i klasifikační),
+        // jinak zůstane rezidentní celý soubor.
+        void ReleaseBehind(size_t offset);
+
+        // před dalším průchodem od začátku: vrátí OS vše načtené
+        void Rewind();
+
+        static constexpr size_t ReleaseLag = 64u * 1024 * 1024;
+
+    private:
+        // stránky před offsetem už nejsou potřeba
+        void Release(size_t upTo);
+
+        char const* _data = nullptr;
+        size_t _size      = 0;
+        bool   _open      = false;
+#ifdef _WIN32
+        void*  _file     = nullptr; // HANDLE
+        void*  _mapping  = nullptr;
+#else
+        int    _fd       = -1;
+        size_t _released = 0;
+#endif
+    };
+
+    // Jeden průchod přes mapovaný soubor, statementy jako string_view do mapy
+    // (bez kopií). Zná '…', "…", `…` včetně \ escape, komentáře -- # /* */
+    // a bloky DELIMITER. Komentáře uvnitř statementu zůstávají – zpracuje je server.
+    class SqlStatementReader
+    {
+    public:
+        explicit SqlStatementReader(std::string_view src);
+
+        size_t Offset() const { return _pos; }
+
+        bool Next(std::string_view& stmt);
+
+    private:
+        bool AtLineComment() const;
+        bool AtBlockComment() const;
+        void SkipComment();
+        void SkipSpaceAndComments();
+        size_t ScanToDelimiter();
+
+        std::string_view _src;
+        size_t      _pos   = 0;
+        std::string _delim = ";";
+    };
+
+    // DDL dělá v MySQL implicitní commit -> soubor s DDL nejde aplikovat atomicky
+    bool IsDdl(std::string_view stmt);
+
+    // "INSERT … VALUES (…),(…)" -> prefix do VALUES včetně + n-tice; jinak false
+    bool SplitInsert(std::string_view stmt, std::string_view& prefix, std::string_view& tuples);
+
+    // Slučuje po sobě jdoucí INSERTy do stejné tabulky se stejnými sloupci
+    // do jednoho multi-row statementu (do maxPacketBytes); ostatní posílá beze změny.
+    class StatementBatcher
+    {
+    public:
+        using Sink = std::function<void(std::string_view)>;
+
+        StatementBatcher(size_t maxPacketBytes, Sink sink) : _max(maxPacketBytes), _sink(std::move(sink)) {}
+
+        void Add(std::string_view stmt);
+        void Flush();
+
+        uint32 Statements() const { return _statements; }
+        uint32 RoundTrips() const { return _roundTrips; }
+
+    private:
+        void Send(std::string_view stmt);
+
+        size_t      _max;
+        Sink        _sink;
+        std::string _prefix;
+        std::string _buf;
+        uint32      _statements = 0;
+        uint32      _roundTrips = 0;
+    };
+
+    // špička RSS procesu v KB (0 = nezjištěno)
+    uint64 PeakRssKB();
+}
+
+#endif // MOD_REAL_ONLINE_SQL_READER_H
@@ -0,0 +1,219 @@
+// modules/mod-real-online/src/storage_ops.cpp
+
+#include "storage_ops.h"
+
+#include <algorithm>
+
+namespace RealOnline
+{
+    // ==== ledger ====
+    bool ReadRewardStatus(RewardStorage& storage, uint32 account, uint32 itemId, RewardStatus& out)
+    {
+        LedgerBalance bal;
+        if (!storage.ReadBalance(account, itemId, bal))
+            return false;
+
+        out.entitled  = bal.entitled;
+        out.claimed   = bal.claimed;
+        out.available = bal.entitled > bal.claimed ? bal.entitled - bal.claimed : 0;
+        return true;
+    }
+
+    bool ReadTokenStored(RewardStorage& storage, uint32 account, uint32 itemId, uint32& stored)
+    {
+        stored = 0;
+        return storage.ReadStored(account, itemId, stored);
+    }
+
+    LedgerResult ClaimEntitlement(RewardStorage& storage, uint32 account, uint32 itemId, DeliverFn const& deliver, uint32& count)
+    {
+        count = 0;
+        LedgerBalance bal;
+        if (!storage.ReadBalance(account, itemId, bal))
+            return LedgerResult::StoreError;
+
+        uint32 available = bal.entitled > bal.claimed ? bal.entitled - bal.claimed : 0;
+        if (available == 0)
+            return LedgerResult::Nothing;
+
+        if (!deliver(available))
+            return LedgerResult::NotDelivered;
+
+        count = available;
+        return storage.AddClaimed(account, itemId, available) ? LedgerResult::Ok : LedgerResult::NotRecorded;
+    }
+
+    LedgerResult DepositStored(RewardStorage& storage, uint32 account, uint32 itemId, uint32 amount, DeliverFn const& has)
+    {
+        uint32 stored = 0;
+        if (!storage.ReadStored(account, itemId, stored))
+            return LedgerResult::StoreError;
+
+        if (!has(amount))
+            return LedgerResult::NotDelivered;
+
+        return storage.AddStored(account, itemId, amount) ? LedgerResult::Ok : LedgerResult::StoreError;
+    }
+
+    LedgerResult WithdrawStored(RewardStorage& storage, uint32 account, uint32 itemId, uint32 amount, DeliverFn const& deliver, uint32& stored)
+    {
+        stored = 0;
+        if (!storage.ReadStored(account, itemId, stored))
+            return LedgerResult::StoreError;
+
+        if (stored < amount)
+            return LedgerResult::Insufficient;
+
+        if (!deliver(amount))
+            return LedgerResult::NotDelivered;
+
+        return storage.TakeStored(account, itemId, amount) ? LedgerResult::Ok : LedgerResult::NotRecorded;
+    }
+
+    // ==== virtuální tokeny ====
+    bool ReadTokenBalance(RewardStorage& storage, uint32 account, uint32 itemId, TokenBalance& out)
+    {
+        LedgerBalance bal;
+        if (!storage.ReadBalance(account, itemId, bal))
+            return false;
+
+        out.available = bal.entitled > bal.claimed ? bal.entitled - bal.claimed : 0;
+        out.stored    = bal.stored;
+        return true;
+    }
+
+    TokenSpend SpendTokenBalance(RewardStorage& storage, uint32 account, uint32 itemId, TokenBalance& balance, uint32 amount)
+    {
+        if (uint64(balance.available) + balance.stored < amount)
+            return TokenSpend::Insufficient;
+
+        uint32 fromAvailable = std::min(balance.available, amount);
+        uint32 fromStored    = amount - fromAvailable;
+
+        if (fromAvailable && !storage.AddClaimed(account, itemId, fromAvailable))
+            return TokenSpend::StoreError;
+        balance.available -= fromAvailable;
+
+        if (fromStored && !storage.TakeStored(account, itemId, fromStored))
+        {
+            // entitlement už je vyčerpaný – vrátit do stored, zůstatek se nemění
+            if (fromAvailable && storage.AddStored(account, itemId, fromAvailable))
+                balance.stored += fromAvailable;
+            return TokenSpend::StoreError;
+        }
+        balance.stored -= fromStored;
+        return TokenSpend::Ok;
+    }
+
+    // ==== login streak ====
+    StreakState StreakFromRecord(StreakRecord const& r)
+    {
+        StreakState st;
+        st.exists           = true;
+        st.lastSerial       = r.lastSerial;
+        st.lastRewardSerial = r.lastRewardSerial;
+        st.streakDay        = r.streakDay;
+        st.consecutiveDays  = r.consecutiveDays;
+        return st;
+    }
+
+    StreakRecord StreakToRecord(StreakState const& st)
+    {
+        return { st.lastSerial, st.lastRewardSerial, st.streakDay, st.consecutiveDays };
+    }
+
+    StreakStep AdvanceLoginStreak(RewardStorage& storage, uint32 account, uint32 today, uint32 cycleLen, bool resetOnMiss, StreakState& st)
+    {
+        std::optional<StreakRecord> rec;
+        if (!storage.ReadStreak(account, rec))
+            return StreakStep::ReadError;
+        st = rec ? StreakFromRecord(*rec) : StreakState();
+
+        if (!AdvanceStreak(st, today, cycleLen, resetOnMiss))
+            return StreakStep::AlreadyRewarded;
+
+        if (!storage.WriteStreaks({ { account, StreakToRecord(st) } }))
+            return StreakStep::WriteError;
+        return StreakStep::Advanced;
+    }
+
+    // ==== milníky ====
+    MilestoneCheck ReachMilestone(AccountMilestones& st, uint32 milestone)
+    {
+        std::bitset<256>& bits = st.byGuid[st.guid];
+        if (bits.test(milestone))
+            return MilestoneCheck::AlreadyReached;
+        if (st.perMilestone[milestone] >= MilestoneAccountCap)
+            return MilestoneCheck::AccountCap;
+
+        bits.set(milestone);
+        ++st.perMilestone[milestone];
+        return MilestoneCheck::Reached;
+    }
+
+    void ApplyMilestoneSnapshot(AccountMilestones& st, MilestoneSnapshot const& snap)
+    {
+        for (auto const& [m, cnt] : snap.counts)
+            st.perMilestone[m] = uint8(std::min<uint32>(cnt, 255u));
+        for (uint8 m : snap.reached)
+            st.byGuid[st.guid].set(m);
+        st.loaded = true;
+    }
+
+    uint32 RecordLevelRange(RewardStorage& storage, uint32 account, AccountMilestones& st,
+        std::vector<MilestoneReward> const& byLevel, uint32 oldLevel, uint32 newLevel, MilestoneFn const& onMilestone)
+    {
+        uint32 attempts = 0;
+        for (uint32 lvl = oldLevel + 1; lvl <= newLevel && lvl < byLevel.size(); ++lvl)
+        {
+            MilestoneReward const& reward = byLevel[lvl];
+            if (!reward.itemId || ReachMilestone(st, lvl) != MilestoneCheck::Reached)
+                continue;
+
+            // záznam i čítač atomicky – duplicitní záznam neprojde (ani odměna)
+            ++attempts;
+            bool ok = storage.RecordMilestone(account, st.guid, uint8(lvl));
+            if (!ok)
+            {
+                // nezapsáno -> rozhodnutí v paměti zpět, jinak by milník už nikdy nepadl
+                st.byGuid[st.guid].reset(lvl);
+                --st.perMilestone[lvl];
+            }
+            onMilestone(lvl, reward, ok);
+        }
+        return attempts;
+    }
+
+    // ==== entitlementy ====
+    void EntitlementQueue::Add(uint32 account, uint32 itemId, uint32 count)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _pending[(uint64(account) << 32) | itemId] += count;
+    }
+
+    bool EntitlementQueue::Flush(RewardStorage& storage, std::vector<LedgerDelta>& rows)
+    {
+        rows.clear();
+
+        std::unordered_map<uint64, uint32> batch;
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            if (_pending.empty())
+                return true;
+            batch.swap(_pending);
+        }
+
+        rows.reserve(batch.size());
+        for (auto const& [key, count] : batch)
+            rows.push_back({ uint32(key >> 32), uint32(key), count });
+
+        if (storage.AddEntitled(rows))
+            return true;
+
+        // zpět do fronty, zkusí se další tick
+        std::lock_guard<std::mutex> guard(_lock);
+        for (auto const& [key, count] : batch)
+            _pending[key] += count;
+        return false;
+    }
+}
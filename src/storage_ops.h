@@ -0,0 +1,153 @@
+// modules/mod-real-online/src/storage_ops.h
+
+#ifndef MOD_REAL_ONLINE_STORAGE_OPS_H
+#define MOD_REAL_ONLINE_STORAGE_OPS_H
+
+#include "reward_storage.h"
+#include "streak_logic.h"
+
+#include <array>
+#include <bitset>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// =============================
+// Práce horkých cest s úložištěm
+// =============================
+// Co příkazy a hooky dělají s RewardStorage – bez hráče, chatu a configu.
+// Handler dodá doručení do tašek (callback) a hlášky podle výsledku. Právě
+// tyto sekvence hlídá rozpočet v query_budget.h a test rozpočtu
+// (tests/query_budget_test.cpp) je volá nad paměťovým backendem.
+namespace RealOnline
+{
+    enum class LedgerResult : uint8
+    {
+        Ok,
+        StoreError,   // čtení nebo zápis selhal, nic se nezměnilo
+        Nothing,      // claim bez dostupného entitlementu
+        Insufficient, // withdraw víc, než je uloženo
+        NotDelivered, // doručení hráči selhalo (hlášku poslal callback)
+        NotRecorded   // doručeno, zápis do úložiště selhal
+    };
+
+    // doručí count itemů hráči; false = nic nedoručeno
+    using DeliverFn = std::function<bool(uint32 count)>;
+
+    struct RewardStatus
+    {
+        uint32 entitled  = 0;
+        uint32 claimed   = 0;
+        uint32 available = 0; // entitled - claimed
+    };
+
+    // .reward: ReadBalance
+    bool ReadRewardStatus(RewardStorage& storage, uint32 account, uint32 itemId, RewardStatus& out);
+
+    // .token: ReadStored
+    bool ReadTokenStored(RewardStorage& storage, uint32 account, uint32 itemId, uint32& stored);
+
+    // .reward claim: ReadBalance, doručení, AddClaimed; count = vyzvednuto
+    LedgerResult ClaimEntitlement(RewardStorage& storage, uint32 account, uint32 itemId, DeliverFn const& deliver, uint32& count);
+
+    // .token deposit: ReadStored, has (má hráč itemy v taškách?), AddStored;
+    // itemy z tašek odebere volající až po Ok
+    LedgerResult DepositStored(RewardStorage& storage, uint32 account, uint32 itemId, uint32 amount, DeliverFn const& has);
+
+    // .token withdraw: ReadStored, doručení, TakeStored; stored = stav před výběrem
+    LedgerResult WithdrawStored(RewardStorage& storage, uint32 account, uint32 itemId, uint32 amount, DeliverFn const& deliver, uint32& stored);
+
+    // ---- virtuální tokeny ----
+    struct TokenBalance
+    {
+        uint32 available = 0; // entitled - claimed
+        uint32 stored    = 0;
+    };
+
+    bool ReadTokenBalance(RewardStorage& storage, uint32 account, uint32 itemId, TokenBalance& out);
+
+    enum class TokenSpend : uint8
+    {
+        Ok,
+        Insufficient,
+        StoreError
+    };
+
+    // odečte nejdřív z entitlementu, pak ze stored; balance drží volající
+    TokenSpend SpendTokenBalance(RewardStorage& storage, uint32 account, uint32 itemId, TokenBalance& balance, uint32 amount);
+
+    // ---- login streak ----
+    StreakState StreakFromRecord(StreakRecord const& r);
+    StreakRecord StreakToRecord(StreakState const& st);
+
+    enum class StreakStep : uint8
+    {
+        Advanced,
+        AlreadyRewarded, // dnes už odměna padla
+        ReadError,
+        WriteError
+    };
+
+    // ReadStreak, posun na today, WriteStreaks; st = nový stav
+    StreakStep AdvanceLoginStreak(RewardStorage& storage, uint32 account, uint32 today, uint32 cycleLen, bool resetOnMiss, StreakState& st);
+
+    // ---- milníky ----
+    inline constexpr uint32 MilestoneAccountCap = 10; // prvních 10 postav účtu
+
+    struct MilestoneReward
+    {
+        uint32 itemId = 0;
+        uint32 count = 0;
+    };
+
+    // Načte se asynchronně při loginu; rozhodnutí při level-upu jsou pak čistě v paměti.
+    struct AccountMilestones
+    {
+        bool loaded = false;
+        std::unordered_map<uint32, std::bitset<256>> byGuid; // guid -> dosažené milníky (přihlášená postava)
+        std::array<uint8, 256> perMilestone{};               // milník -> počet postav účtu (level_milestone_counts)
+        std::vector<std::pair<uint8, uint8>> deferred;       // level-upy před dokončením načtení
+        uint32 guid    = 0;                                  // přihlášená postava
+        uint32 loadSeq = 0;
+    };
+
+    // rozhodnutí čistě v paměti: milník postavy st.guid ještě nepadl a účet nemá plný limit
+    enum class MilestoneCheck : uint8
+    {
+        Reached,
+        AlreadyReached,
+        AccountCap
+    };
+
+    MilestoneCheck ReachMilestone(AccountMilestones& st, uint32 milestone);
+    void ApplyMilestoneSnapshot(AccountMilestones& st, MilestoneSnapshot const& snap);
+
+    // recorded = false -> RecordMilestone selhal, odměna se nedává a stav
+    // v paměti se vrátí (milník zkusí další level-up přes tento level)
+    using MilestoneFn = std::function<void(uint32 milestone, MilestoneReward const& reward, bool recorded)>;
+
+    // Milníky v (oldLevel, newLevel]; byLevel: index = level, itemId 0 = není
+    // milník. Vrací počet volání RecordMilestone, i neúspěšných (jednotky
+    // rozpočtu levelup).
+    uint32 RecordLevelRange(RewardStorage& storage, uint32 account, AccountMilestones& st,
+        std::vector<MilestoneReward> const& byLevel, uint32 oldLevel, uint32 newLevel, MilestoneFn const& onMilestone);
+
+    // ---- entitlementy ----
+    // Granty se slučují podle (účet, item) a zapisují jedním AddEntitled za
+    // tick. Add smí volat libovolný thread (level-up v map threadech).
+    class EntitlementQueue
+    {
+    public:
+        void Add(uint32 account, uint32 itemId, uint32 count);
+
+        // rows = zapsané řádky; při chybě zůstává vše ve frontě na další pokus
+        bool Flush(RewardStorage& storage, std::vector<LedgerDelta>& rows);
+
+    private:
+        std::mutex _lock;
+        std::unordered_map<uint64, uint32> _pending; // (account << 32 | item) -> count
+    };
+}
+
+#endif // MOD_REAL_ONLINE_STORAGE_OPS_H
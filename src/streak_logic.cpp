@@ -0,0 +1,70 @@
+// modules/mod-real-online/src/streak_logic.cpp
+
+#include "streak_logic.h"
+
+namespace RealOnline
+{
+    uint32 StreakDaySerial(time_t now, uint32 boundaryHour)
+    {
+        int64 shifted = static_cast<int64>(now) - static_cast<int64>(boundaryHour) * 3600;
+        if (shifted < 0) shifted = 0;
+        return static_cast<uint32>(shifted / 86400);
+    }
+
+    bool AdvanceStreak(StreakState& st, uint32 today, uint32 cycleLen, bool resetOnMiss)
+    {
+        if (!st.exists)
+        {
+            st.streakDay       = 1;
+            st.consecutiveDays = 1;
+        }
+        else
+        {
+            int64 delta = static_cast<int64>(today) - static_cast<int64>(st.lastSerial);
+
+            if (delta <= 0)
+            {
+                if (st.lastRewardSerial == today)
+                    return false;
+            }
+            else if (delta == 1)
+            {
+                st.streakDay = (st.streakDay % cycleLen) + 1;
+                ++st.consecutiveDays;
+            }
+            else
+            {
+                // série dní je přerušená i bez ResetOnMiss (ten řídí jen cyklus odměn)
+                st.consecutiveDays = 1;
+                if (resetOnMiss)
+                    st.streakDay = 1;
+                else
+                    st.streakDay = (st.streakDay % cycleLen) + 1;
+            }
+        }
+
+        st.exists           = true;
+        st.lastSerial       = today;
+        st.lastRewardSerial = today;
+        return true;
+    }
+
+    StreakGrant ResolveStreakGrant(uint32 baseCount, std::vector<SpecialReward> const& byDay, uint32 streakDay)
+    {
+        StreakGrant g;
+        g.streakDay  = streakDay;
+        g.totalCount = baseCount;
+
+        if (streakDay < byDay.size())
+        {
+            SpecialReward const& sp = byDay[streakDay];
+            g.spItem = sp.itemId;
+            g.spCnt  = sp.count;
+            if (g.spItem && g.spCnt)
+                g.separateBonus = true;
+            else
+                g.totalCount += g.spCnt; // bonus stejného itemu
+        }
+        return g;
+    }
+}
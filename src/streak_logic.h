@@ -0,0 +1,52 @@
+// modules/mod-real-online/src/streak_logic.h
+
+#ifndef MOD_REAL_ONLINE_STREAK_LOGIC_H
+#define MOD_REAL_ONLINE_STREAK_LOGIC_H
+
+#include "core_types.h"
+
+#include <ctime>
+#include <vector>
+
+// =============================
+// Čistá logika login streaku
+// =============================
+// Posun série a výpočet odměny bez úložiště, configu a hráče. Používá ji
+// login, sweep na hranici dne i replay; měří ji samostatný benchmark.
+namespace RealOnline
+{
+    struct StreakState
+    {
+        bool   exists = false;
+        uint32 lastSerial = 0;
+        uint32 lastRewardSerial = 0;
+        uint32 streakDay = 0;       // den cyklu odměn (1..cycleLen)
+        uint32 consecutiveDays = 0; // dní v řadě bez výpadku, nepřetéká (.streak top)
+    };
+
+    struct SpecialReward
+    {
+        uint32 itemId = 0; // 0 = bonus základního itemu
+        uint32 count = 0;
+    };
+
+    struct StreakGrant
+    {
+        uint32 streakDay = 0;
+        uint32 totalCount = 0;
+        bool   separateBonus = false;
+        uint32 spItem = 0;
+        uint32 spCnt = 0;
+    };
+
+    // pořadové číslo dne; den začíná v boundaryHour (UTC)
+    uint32 StreakDaySerial(time_t now, uint32 boundaryHour);
+
+    // posune sérii na den "today"; vrací false, pokud dnes už odměna padla
+    bool AdvanceStreak(StreakState& st, uint32 today, uint32 cycleLen, bool resetOnMiss);
+
+    // byDay: index = den cyklu (1..cycleLen)
+    StreakGrant ResolveStreakGrant(uint32 baseCount, std::vector<SpecialReward> const& byDay, uint32 streakDay);
+}
+
+#endif // MOD_REAL_ONLINE_STREAK_LOGIC_H
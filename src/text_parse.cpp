@@ -0,0 +1,92 @@
+// modules/mod-real-online/src/text_parse.cpp
+
+#include "text_parse.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <sstream>
+
+namespace RealOnline
+{
+    std::string Trim(std::string s)
+    {
+        auto notSpace = [](int ch){ return !std::isspace(ch); };
+        s.erase(s.begin(), std::find_if(s.begin(), s.end(), notSpace));
+        s.erase(std::find_if(s.rbegin(), s.rend(), notSpace).base(), s.end());
+        return s;
+    }
+
+    std::string_view TrimView(std::string_view s)
+    {
+        while (!s.empty() && std::isspace((unsigned char)s.front())) s.remove_prefix(1);
+        while (!s.empty() && std::isspace((unsigned char)s.back()))  s.remove_suffix(1);
+        return s;
+    }
+
+    bool ParseU32(std::string_view s, uint32& out)
+    {
+        if (s.empty() || !std::all_of(s.begin(), s.end(), [](char c){ return std::isdigit((unsigned char)c) != 0; }))
+            return false;
+        auto res = std::from_chars(s.data(), s.data() + s.size(), out);
+        return res.ec == std::errc() && res.ptr == s.data() + s.size();
+    }
+
+    std::vector<uint32> ParseCSVu32(std::string const& s)
+    {
+        std::vector<uint32> out;
+        std::stringstream ss(s);
+        std::string seg;
+        while (std::getline(ss, seg, ','))
+        {
+            seg = Trim(seg);
+            if (seg.empty()) continue;
+            try { out.push_back(static_cast<uint32>(std::stoul(seg))); } catch (...) {}
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+        return out;
+    }
+
+    std::string_view NextWord(std::string_view s, std::string_view& rest)
+    {
+        s = TrimView(s);
+        size_t sp = 0;
+        while (sp < s.size() && !std::isspace((unsigned char)s[sp])) ++sp;
+        rest = TrimView(s.substr(sp));
+        return s.substr(0, sp);
+    }
+
+    bool EqualsI(std::string_view a, std::string_view b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+            [](char x, char y){ return std::tolower((unsigned char)x) == std::tolower((unsigned char)y); });
+    }
+
+    bool StartsWithI(std::string_view s, std::string_view prefix)
+    {
+        return s.size() >= prefix.size() && EqualsI(s.substr(0, prefix.size()), prefix);
+    }
+
+    std::vector<Range> ParseRanges(std::string const& txt)
+    {
+        std::vector<Range> out;
+        std::stringstream ss(txt);
+        std::string seg;
+        while (std::getline(ss, seg, ';'))
+        {
+            seg = Trim(seg);
+            if (seg.empty()) continue;
+            auto dash = seg.find('-');
+            if (dash == std::string::npos) continue;
+            std::string a = Trim(seg.substr(0, dash));
+            std::string b = Trim(seg.substr(dash + 1));
+            if (a.empty() || b.empty()) continue;
+            uint32 mn = 0, mx = 0;
+            try { mn = static_cast<uint32>(std::stoul(a)); mx = static_cast<uint32>(std::stoul(b)); } catch (...) { continue; }
+            if (mn > mx) std::swap(mn, mx);
+            out.push_back({ mn, mx });
+        }
+        return out;
+    }
+}
@@ -0,0 +1,48 @@
+// modules/mod-real-online/src/text_parse.h
+
+#ifndef MOD_REAL_ONLINE_TEXT_PARSE_H
+#define MOD_REAL_ONLINE_TEXT_PARSE_H
+
+#include "core_types.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =============================
+// Parsery configu a argumentů příkazů
+// =============================
+// Sdílí je .online, .reward, milníky i streak (dřív vlastní kopie v každém TU).
+// Bez závislosti na jádru -> měří je i samostatný benchmark.
+namespace RealOnline
+{
+    std::string Trim(std::string s);
+    std::string_view TrimView(std::string_view s);
+
+    // jen číslice, bez přetečení
+    bool ParseU32(std::string_view s, uint32& out);
+
+    // "10, 20,30" -> seřazené, bez duplicit; nečíselné položky se přeskočí
+    std::vector<uint32> ParseCSVu32(std::string const& s);
+
+    // první slovo argumentů -> návrat, zbytek -> rest (bez alokací)
+    std::string_view NextWord(std::string_view s, std::string_view& rest);
+
+    bool EqualsI(std::string_view a, std::string_view b);
+    bool StartsWithI(std::string_view s, std::string_view prefix);
+
+    // rozsahy účtů "A-B;C-D;..." (A > B se prohodí, neplatné se přeskočí)
+    struct Range { uint32 min = 0, max = 0; };
+
+    std::vector<Range> ParseRanges(std::string const& txt);
+
+    inline bool InRanges(uint32 id, std::vector<Range> const& rs)
+    {
+        for (Range const& r : rs)
+            if (id >= r.min && id <= r.max)
+                return true;
+        return false;
+    }
+}
+
+#endif // MOD_REAL_ONLINE_TEXT_PARSE_H
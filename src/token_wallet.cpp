@@ -0,0 +1,325 @@
+// modules/mod-real-online/src/token_wallet.cpp
+
+#include "token_wallet.h"
+#include "autoupdate.h"
+#include "messages.h"
+#include "query_budget.h"
+#include "reward_pipeline.h"
+#include "reward_storage.h"
+#include "storage_ops.h"
+
+#include "Config.h"
+#include "ScriptMgr.h"
+#include "ScriptedGossip.h"
+#include "Creature.h"
+#include "Player.h"
+#include "WorldSession.h"
+#include "ObjectMgr.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RealOnline
+{
+    namespace
+    {
+        struct VendorItem
+        {
+            uint32 itemId = 0;
+            uint32 count  = 1;
+            uint32 price  = 0;
+        };
+
+        struct WalletCfg
+        {
+            bool   virtualTokens = false;
+            uint32 tokenItem     = 0;
+            std::vector<VendorItem> vendor;
+        };
+
+        WalletCfg sWalletCfg;
+
+        // jen online účty, které zůstatek už použily
+        std::unordered_map<uint32, TokenBalance> sWallets;
+
+        TokenBalance* LoadWallet(uint32 account)
+        {
+            auto itr = sWallets.find(account);
+            if (itr != sWallets.end())
+                return &itr->second;
+
+            TokenBalance w;
+            if (!ReadTokenBalance(Storage(), account, sWalletCfg.tokenItem, w))
+                return nullptr;
+            return &(sWallets[account] = w);
+        }
+
+        // "item:počet:cena, ..." (počet lze vynechat: "item:cena")
+        std::vector<VendorItem> ParseVendorItems(std::string const& txt)
+        {
+            std::vector<VendorItem> out;
+            std::stringstream ss(txt);
+            std::string seg;
+            while (std::getline(ss, seg, ','))
+            {
+                std::vector<uint32> parts;
+                std::stringstream ps(seg);
+                std::string p;
+                while (std::getline(ps, p, ':'))
+                {
+                    try { parts.push_back(static_cast<uint32>(std::stoul(p))); }
+                    catch (...) { parts.clear(); break; }
+                }
+
+                VendorItem v;
+                if (parts.size() == 2)
+                    v = { parts[0], 1, parts[1] };
+                else if (parts.size() == 3)
+                    v = { parts[0], parts[1], parts[2] };
+                else
+                {
+                    if (seg.find_first_not_of(" \t") != std::string::npos)
+                        LOG_ERROR("module", "[wallet] RealOnline.Token.Vendor.Items: cannot parse '{}', skipped.", seg);
+                    continue;
+                }
+
+                if (!v.itemId || !v.count || !v.price)
+                    continue;
+                if (!sObjectMgr->GetItemTemplate(v.itemId))
+                {
+                    LOG_ERROR("module", "[wallet] RealOnline.Token.Vendor.Items: item {} does not exist in item_template, skipped.", v.itemId);
+                    continue;
+                }
+                out.push_back(v);
+            }
+            return out;
+        }
+
+        void LoadWalletCfg()
+        {
+            WalletCfg c;
+            c.virtualTokens = sConfigMgr->GetOption<bool>("RealOnline.Token.Virtual", false);
+            c.tokenItem     = sConfigMgr->GetOption<uint32>("RealOnline.Reward.ItemId", 0u);
+            c.vendor        = ParseVendorItems(sConfigMgr->GetOption<std::string>("RealOnline.Token.Vendor.Items", ""));
+
+            // jiný token / režim -> zůstatky v paměti neplatí
+            if (c.tokenItem != sWalletCfg.tokenItem || c.virtualTokens != sWalletCfg.virtualTokens)
+                sWallets.clear();
+            sWalletCfg = std::move(c);
+        }
+    }
+
+    bool VirtualTokensEnabled()
+    {
+        return sWalletCfg.virtualTokens && sWalletCfg.tokenItem;
+    }
+
+    bool IsVirtualToken(uint32 itemId)
+    {
+        return VirtualTokensEnabled() && itemId == sWalletCfg.tokenItem;
+    }
+
+    bool GetTokenBalance(uint32 account, uint32& out)
+    {
+        TokenBalance* w = LoadWallet(account);
+        if (!w)
+            return false;
+        out = w->available + w->stored;
+        return true;
+    }
+
+    SpendResult SpendTokens(uint32 account, uint32 amount)
+    {
+        if (!VirtualTokensEnabled())
+            return SpendResult::Disabled;
+        if (!IsCustomsSchemaReady())
+            return SpendResult::StoreError;
+
+        QueryBudgetScope budget(BudgetOp::TokenSpend);
+
+        TokenBalance* w = LoadWallet(account);
+        if (!w)
+            return SpendResult::StoreError;
+
+        switch (SpendTokenBalance(Storage(), account, sWalletCfg.tokenItem, *w, amount))
+        {
+            case TokenSpend::Ok:           return SpendResult::Ok;
+            case TokenSpend::Insufficient: return SpendResult::Insufficient;
+            default:                       return SpendResult::StoreError;
+        }
+    }
+
+    bool RefundTokens(uint32 account, uint32 amount)
+    {
+        if (!Storage().AddStored(account, sWalletCfg.tokenItem, amount))
+        {
+            LOG_ERROR("module", "[wallet] Refund of {} token(s) to account {} failed ({} storage).", amount, account, Storage().Name());
+            return false;
+        }
+        NoteTokenStored(account, amount);
+        return true;
+    }
+
+    void NoteTokenEntitled(uint32 account, uint32 itemId, uint32 count)
+    {
+        if (itemId != sWalletCfg.tokenItem)
+            return;
+        auto itr = sWallets.find(account);
+        if (itr != sWallets.end())
+            itr->second.available += count;
+    }
+
+    void NoteTokenStored(uint32 account, int64 delta)
+    {
+        auto itr = sWallets.find(account);
+        if (itr != sWallets.end())
+            itr->second.stored = uint32(std::max<int64>(0, int64(itr->second.stored) + delta));
+    }
+
+    void ForgetTokenBalance(uint32 account)
+    {
+        sWallets.erase(account);
+    }
+}
+
+// =============================
+// Gossip obchodník (creature_template.ScriptName = npc_real_online_token_vendor)
+// =============================
+// Nabídka z RealOnline.Token.Vendor.Items, platí se přímo ze zůstatku.
+// Akce = GOSSIP_ACTION_INFO_DEF + index položky, INFO_DEF samotné = obnovit.
+// CMSG_GOSSIP_* jsou thread-unsafe opcody -> world thread, stejně jako příkazy.
+class npc_real_online_token_vendor : public CreatureScript
+{
+public:
+    npc_real_online_token_vendor() : CreatureScript("npc_real_online_token_vendor") {}
+
+    bool OnGossipHello(Player* player, Creature* creature) override
+    {
+        ShowMenu(player, creature);
+        return true;
+    }
+
+    bool OnGossipSelect(Player* player, Creature* creature, uint32 /*sender*/, uint32 action) override
+    {
+        using namespace RealOnline;
+
+        if (action > GOSSIP_ACTION_INFO_DEF && action - GOSSIP_ACTION_INFO_DEF <= sWalletCfg.vendor.size())
+            Buy(player, sWalletCfg.vendor[action - GOSSIP_ACTION_INFO_DEF - 1]);
+
+        ShowMenu(player, creature);
+        return true;
+    }
+
+private:
+    static void ShowMenu(Player* player, Creature* creature)
+    {
+        using namespace RealOnline;
+
+        ClearGossipMenuFor(player);
+        WorldSession* session = player->GetSession();
+        Lang lang = SessionLang(session);
+        MessageBuffer buf;
+
+        uint32 balance = 0;
+        if (!VirtualTokensEnabled() || !IsCustomsSchemaReady())
+            buf.Format(Msg::VendorClosed, lang);
+        else if (!GetTokenBalance(session->GetAccountId(), balance))
+            buf.Format(Msg::TokenWalletError, lang);
+        else
+            buf.Format(Msg::VendorBalance, lang, balance);
+        AddGossipItemFor(player, GOSSIP_ICON_MONEY_BAG, std::string(buf.View()), GOSSIP_SENDER_MAIN, GOSSIP_ACTION_INFO_DEF);
+
+        if (VirtualTokensEnabled())
+        {
+            for (size_t i = 0; i < sWalletCfg.vendor.size(); ++i)
+            {
+                VendorItem const& v = sWalletCfg.vendor[i];
+                ItemTemplate const* proto = sObjectMgr->GetItemTemplate(v.itemId);
+                buf.Clear();
+                buf.Format(Msg::VendorItem, lang, v.count, proto ? std::string_view(proto->Name1) : std::string_view(), v.price);
+                AddGossipItemFor(player, GOSSIP_ICON_VENDOR, std::string(buf.View()), GOSSIP_SENDER_MAIN, GOSSIP_ACTION_INFO_DEF + uint32(i) + 1);
+            }
+        }
+
+        SendGossipMenuFor(player, DEFAULT_GOSSIP_MESSAGE, creature);
+    }
+
+    // místo v taškách -> platba -> item; když se item přesto nevejde, tokeny se vrátí
+    static void Buy(Player* player, RealOnline::VendorItem const& v)
+    {
+        using namespace RealOnline;
+
+        ChatHandler handler(player->GetSession());
+        uint32 acc = player->GetSession()->GetAccountId();
+
+        ItemPosCountVec dest;
+        if (player->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, v.itemId, v.count) != EQUIP_ERR_OK)
+        {
+            SendMsg(&handler, Msg::TokenNoSpace);
+            return;
+        }
+
+        switch (SpendTokens(acc, v.price))
+        {
+            case SpendResult::Ok:
+                break;
+            case SpendResult::Insufficient:
+                SendMsg(&handler, Msg::VendorNotEnough, v.price);
+                return;
+            case SpendResult::Disabled:
+                SendMsg(&handler, Msg::VendorClosed);
+                return;
+            case SpendResult::StoreError:
+                SendMsg(&handler, Msg::TokenWalletError);
+                return;
+        }
+
+        if (!StoreRewardItem(player, v.itemId, v.count))
+        {
+            RefundTokens(acc, v.price);
+            SendMsg(&handler, Msg::TokenNoSpace);
+            return;
+        }
+
+        SendMsg(&handler, Msg::VendorBought, v.count, v.price);
+    }
+};
+
+class RealOnlineTokenWalletPS : public PlayerScript
+{
+public:
+    RealOnlineTokenWalletPS() : PlayerScript("RealOnlineTokenWalletPS") {}
+
+    void OnPlayerLogout(Player* player) override
+    {
+        if (player && player->GetSession())
+            RealOnline::ForgetTokenBalance(player->GetSession()->GetAccountId());
+    }
+};
+
+class RealOnlineTokenWalletWS : public WorldScript
+{
+public:
+    RealOnlineTokenWalletWS()
+        : WorldScript("RealOnlineTokenWalletWS", std::vector<uint16>{ WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP }) {}
+
+    // nabídka ověřuje item_template -> poprvé až OnStartup
+    void OnAfterConfigLoad(bool reload) override
+    {
+        if (reload)
+            RealOnline::LoadWalletCfg();
+    }
+
+    void OnStartup() override { RealOnline::LoadWalletCfg(); }
+};
+
+void AddRealOnlineTokenWalletScripts()
+{
+    new RealOnlineTokenWalletWS();
+    new RealOnlineTokenWalletPS();
+    new npc_real_online_token_vendor();
+}
@@ -0,0 +1,50 @@
+// modules/mod-real-online/src/token_wallet.h
+
+#ifndef MOD_REAL_ONLINE_TOKEN_WALLET_H
+#define MOD_REAL_ONLINE_TOKEN_WALLET_H
+
+#include "Define.h"
+
+// =============================
+// Virtuální tokeny (RealOnline.Token.Virtual)
+// =============================
+// Token (RealOnline.Reward.ItemId) existuje jen jako číslo: zůstatek účtu je
+// nevyzvednutý entitlement + customs.rewards.stored. Odměny tokenem do tašek
+// jdou rovnou do entitlementu, .reward claim items nevytváří a utrácí se
+// přímo ze zůstatku (SpendTokens, gossip obchodník). Žádné item_instance
+// řádky pro tokeny, žádné DestroyItemCount / StoreNewItem tam a zpět.
+//
+// Zůstatek se načte jedním čtením při prvním použití v session a pak se
+// drží v paměti (world thread); zápisy jdou dál přes Storage().
+namespace RealOnline
+{
+    bool VirtualTokensEnabled();
+
+    // true = item je token a virtuální režim je zapnutý
+    bool IsVirtualToken(uint32 itemId);
+
+    enum class SpendResult : uint8
+    {
+        Ok,
+        Disabled,      // virtuální režim vypnut
+        Insufficient,
+        StoreError
+    };
+
+    // zůstatek účtu (načte se, pokud ještě není v paměti); false = chyba úložiště
+    bool GetTokenBalance(uint32 account, uint32& out);
+
+    // odečte nejdřív z entitlementu, pak ze stored
+    SpendResult SpendTokens(uint32 account, uint32 amount);
+
+    // vrácení po nepovedeném nákupu (do stored)
+    bool RefundTokens(uint32 account, uint32 amount);
+
+    // změny zapsané jinudy – jen úprava paměti, pokud je účet načtený
+    void NoteTokenEntitled(uint32 account, uint32 itemId, uint32 count);
+    void NoteTokenStored(uint32 account, int64 delta);
+
+    void ForgetTokenBalance(uint32 account);
+}
+
+#endif // MOD_REAL_ONLINE_TOKEN_WALLET_H
@@ -0,0 +1,357 @@
+// modules/mod-real-online/tests/query_budget_test.cpp
+
+#include "query_budget.h"
+#include "reward_storage_memory.h"
+#include "storage_ops.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// =============================
+// Test rozpočtu DB round tripů (ctest)
+// =============================
+// Každá operace z QueryBudgets běží v QueryBudgetScope nad paměťovým
+// backendem přes stejné funkce jako server (storage_ops.h). Překročení
+// rozpočtu i operace, která do úložiště nesáhla, test shodí.
+namespace
+{
+    using namespace RealOnline;
+
+    std::vector<std::string> sFailures;
+
+    void OnOverrun(QueryBudgetOverrun const& o)
+    {
+        QueryBudget const& b = QueryBudgets[size_t(o.op)];
+        sFailures.push_back(std::string(b.name) + ": " + std::to_string(o.blocking) + " blocking + " +
+            std::to_string(o.queued) + " queued, budget " + std::to_string(b.blocking) + " + " +
+            std::to_string(o.maxQueued) + " (units " + std::to_string(o.units) + ")");
+    }
+
+    void Fail(std::string what)
+    {
+        sFailures.push_back(std::move(what));
+    }
+
+    // operace musí do úložiště opravdu sáhnout, jinak test nic neměří
+    template<class Fn>
+    void Run(char const* label, BudgetOp op, Fn&& fn)
+    {
+        StorageCounters before = ThreadStorageCounters();
+        size_t failures = sFailures.size();
+        {
+            QueryBudgetScope budget(op);
+            fn(budget);
+        }
+        StorageCounters after = ThreadStorageCounters();
+        uint64 blocking = after.blocking - before.blocking, queued = after.queued - before.queued;
+        if (blocking + queued == 0)
+            Fail(std::string(label) + ": no storage round trip, the case does not exercise the operation");
+
+        std::printf("%-4s %-50s blocking %llu, queued %llu\n", sFailures.size() == failures ? "ok" : "FAIL",
+            label, (unsigned long long)blocking, (unsigned long long)queued);
+    }
+
+    constexpr uint32 Item = 49426;
+
+    void SeedEntitled(MemoryRewardStorage& storage, uint32 account, uint32 count)
+    {
+        storage.AddEntitled({ { account, Item, count } });
+    }
+
+    void TestLedger(MemoryRewardStorage& storage)
+    {
+        auto deliver = [](uint32) { return true; };
+
+        SeedEntitled(storage, 1, 5);
+        Run(".reward", BudgetOp::Reward, [&](QueryBudgetScope&)
+        {
+            RewardStatus st;
+            if (!ReadRewardStatus(storage, 1, Item, st) || st.entitled != 5 || st.available != 5)
+                Fail(".reward: expected 5 entitled, 5 available");
+        });
+
+        Run(".reward (virtual tokens)", BudgetOp::Reward, [&](QueryBudgetScope&)
+        {
+            TokenBalance bal;
+            ReadTokenBalance(storage, 1, Item, bal);
+        });
+
+        SeedEntitled(storage, 2, 7);
+        Run(".reward claim", BudgetOp::RewardClaim, [&](QueryBudgetScope&)
+        {
+            uint32 count = 0;
+            if (ClaimEntitlement(storage, 2, Item, deliver, count) != LedgerResult::Ok || count != 7)
+                Fail(".reward claim: expected 7 claimed");
+        });
+
+        Run(".reward claim (nothing left)", BudgetOp::RewardClaim, [&](QueryBudgetScope&)
+        {
+            uint32 count = 0;
+            if (ClaimEntitlement(storage, 2, Item, deliver, count) != LedgerResult::Nothing)
+                Fail(".reward claim: second claim must find nothing");
+        });
+
+        Run(".token", BudgetOp::TokenStatus, [&](QueryBudgetScope&)
+        {
+            uint32 stored = 1;
+            if (!ReadTokenStored(storage, 3, Item, stored) || stored != 0)
+                Fail(".token: expected nothing stored");
+        });
+
+        Run(".token deposit", BudgetOp::TokenDeposit, [&](QueryBudgetScope&)
+        {
+            if (DepositStored(storage, 3, Item, 10, deliver) != LedgerResult::Ok)
+                Fail(".token deposit: expected Ok");
+        });
+
+        Run(".token withdraw", BudgetOp::TokenWithdraw, [&](QueryBudgetScope&)
+        {
+            uint32 stored = 0;
+            if (WithdrawStored(storage, 3, Item, 4, deliver, stored) != LedgerResult::Ok || stored != 10)
+                Fail(".token withdraw: expected Ok from 10 stored");
+        });
+    }
+
+    void TestTokenSpend(MemoryRewardStorage& storage)
+    {
+        SeedEntitled(storage, 4, 3);
+        storage.AddStored(4, Item, 5);
+
+        // první nákup v session: načtení zůstatku + entitlement + stored
+        TokenBalance wallet;
+        Run("token.spend (first, 3 + 3 tokens)", BudgetOp::TokenSpend, [&](QueryBudgetScope&)
+        {
+            if (!ReadTokenBalance(storage, 4, Item, wallet) || SpendTokenBalance(storage, 4, Item, wallet, 6) != TokenSpend::Ok)
+                Fail("token.spend: expected Ok");
+        });
+
+        // zůstatek v paměti nesedí s úložištěm -> TakeStored selže, vrací se do stored
+        SeedEntitled(storage, 5, 2);
+        Run("token.spend (TakeStored fails)", BudgetOp::TokenSpend, [&](QueryBudgetScope&)
+        {
+            TokenBalance stale;
+            if (!ReadTokenBalance(storage, 5, Item, stale))
+                Fail("token.spend: balance read failed");
+            stale.stored = 5;
+            if (SpendTokenBalance(storage, 5, Item, stale, 4) != TokenSpend::StoreError)
+                Fail("token.spend: expected StoreError");
+        });
+    }
+
+    void TestStreak(MemoryRewardStorage& storage)
+    {
+        StreakState st;
+        Run("login.streak (first login)", BudgetOp::LoginStreak, [&](QueryBudgetScope&)
+        {
+            if (AdvanceLoginStreak(storage, 6, 100, 7, true, st) != StreakStep::Advanced)
+                Fail("login.streak: first login must advance");
+        });
+
+        Run("login.streak (relog same day)", BudgetOp::LoginStreak, [&](QueryBudgetScope&)
+        {
+            if (AdvanceLoginStreak(storage, 6, 100, 7, true, st) != StreakStep::AlreadyRewarded)
+                Fail("login.streak: relog must not advance");
+        });
+
+        Run("login.streak (next day)", BudgetOp::LoginStreak, [&](QueryBudgetScope&)
+        {
+            if (AdvanceLoginStreak(storage, 6, 101, 7, true, st) != StreakStep::Advanced || st.streakDay != 2)
+                Fail("login.streak: next day must reach day 2");
+        });
+
+        // cyklus 7 dní přeteče, dny v řadě (žebříček) běží dál
+        for (uint32 day = 102; day < 108; ++day)
+            AdvanceLoginStreak(storage, 6, day, 7, true, st);
+        Run("login.streak (past the reward cycle)", BudgetOp::LoginStreak, [&](QueryBudgetScope&)
+        {
+            if (AdvanceLoginStreak(storage, 6, 108, 7, true, st) != StreakStep::Advanced || st.streakDay != 2 || st.consecutiveDays != 9)
+                Fail("login.streak: day 9 in a row must be cycle day 2");
+        });
+
+        Run("login.streak (missed day)", BudgetOp::LoginStreak, [&](QueryBudgetScope&)
+        {
+            if (AdvanceLoginStreak(storage, 6, 110, 7, false, st) != StreakStep::Advanced || st.streakDay != 3 || st.consecutiveDays != 1)
+                Fail("login.streak: a missed day must restart the days in a row");
+        });
+    }
+
+    // byLevel s milníkem na každém levelu 1..n
+    std::vector<MilestoneReward> MilestoneEveryLevel(uint32 n)
+    {
+        std::vector<MilestoneReward> byLevel(n + 1);
+        for (uint32 lvl = 1; lvl <= n; ++lvl)
+            byLevel[lvl] = { Item, 1 };
+        return byLevel;
+    }
+
+    void LoadMilestonesNow(MemoryRewardStorage& storage, uint32 account, AccountMilestones& st)
+    {
+        storage.LoadMilestones(account, st.guid, [&st](bool ok, MilestoneSnapshot&& snap)
+        {
+            if (ok)
+                ApplyMilestoneSnapshot(st, snap);
+        });
+        storage.Update();
+    }
+
+    void TestMilestones(MemoryRewardStorage& storage)
+    {
+        auto ignore = [](uint32, MilestoneReward const&, bool) {};
+
+        for (uint32 n : { 1u, 8u, 80u, 255u })
+        {
+            uint32 const account = 1000 + n;
+            std::vector<MilestoneReward> byLevel = MilestoneEveryLevel(n);
+
+            AccountMilestones st;
+            st.guid = account * 10;
+            std::string login = "login.milestones (" + std::to_string(n) + " milestone(s))";
+            Run(login.c_str(), BudgetOp::LoginMilestones, [&](QueryBudgetScope&)
+            {
+                LoadMilestonesNow(storage, account, st);
+            });
+
+            // jeden level-up přes n milníků (GM .levelup, dávka zkušeností)
+            std::string label = "levelup across " + std::to_string(n) + " milestone(s)";
+            Run(label.c_str(), BudgetOp::LevelUp, [&](QueryBudgetScope& budget)
+            {
+                uint32 recorded = RecordLevelRange(storage, account, st, byLevel, 0, n, ignore);
+                if (recorded != n)
+                    Fail(label + ": recorded " + std::to_string(recorded));
+                budget.AddUnits(recorded);
+            });
+        }
+
+        // level-up před dokončeným načtením: načtení ve scope level-upu,
+        // odložené milníky se zapíšou po doručení
+        uint32 const account = 2000, n = 20;
+        std::vector<MilestoneReward> byLevel = MilestoneEveryLevel(n);
+        AccountMilestones st;
+        st.guid = 20000;
+        Run("levelup before milestones loaded", BudgetOp::LevelUp, [&](QueryBudgetScope&)
+        {
+            QueryBudgetScope load(BudgetOp::LoginMilestones);
+            storage.LoadMilestones(account, st.guid, [&st](bool ok, MilestoneSnapshot&& snap)
+            {
+                if (ok)
+                    ApplyMilestoneSnapshot(st, snap);
+            });
+        });
+        Run("levelup deferred across 20 milestones", BudgetOp::LevelUp, [&](QueryBudgetScope& budget)
+        {
+            storage.Update();
+            budget.AddUnits(RecordLevelRange(storage, account, st, byLevel, 0, n, ignore));
+        });
+    }
+
+    // RecordMilestone selže -> bez odměny, stav v paměti zpět; po obnově
+    // úložiště další level-up přes stejné levely milníky zapíše
+    void TestMilestoneRecordFails()
+    {
+        MemoryRewardStorage storage;
+        MemoryTuning failing;
+        failing.faultRate = 1.0f;
+        storage.Configure(failing);
+
+        uint32 const account = 3000, n = 8;
+        std::vector<MilestoneReward> byLevel = MilestoneEveryLevel(n);
+        AccountMilestones st;
+        st.guid   = 30000;
+        st.loaded = true;
+
+        uint32 rewarded = 0;
+        auto count = [&rewarded](uint32, MilestoneReward const&, bool recorded) { rewarded += recorded; };
+
+        Run("levelup with failing storage", BudgetOp::LevelUp, [&](QueryBudgetScope& budget)
+        {
+            budget.AddUnits(RecordLevelRange(storage, account, st, byLevel, 0, n, count));
+            if (rewarded)
+                Fail("levelup with failing storage: " + std::to_string(rewarded) + " reward(s) without a record");
+            if (st.byGuid[st.guid].any() || st.perMilestone[1] || st.perMilestone[n])
+                Fail("levelup with failing storage: in-memory milestones not rolled back");
+        });
+
+        storage.Configure(MemoryTuning());
+        Run("levelup after storage recovered", BudgetOp::LevelUp, [&](QueryBudgetScope& budget)
+        {
+            budget.AddUnits(RecordLevelRange(storage, account, st, byLevel, 0, n, count));
+            if (rewarded != n || st.perMilestone[n] != 1)
+                Fail("levelup after storage recovered: rewarded " + std::to_string(rewarded) + " of " + std::to_string(n));
+        });
+    }
+
+    void TestRewardTick(MemoryRewardStorage& storage)
+    {
+        EntitlementQueue queue;
+
+        // (účty ticku, čekající granty jiných zdrojů – streak, milníky)
+        std::pair<uint32, uint32> const cases[] =
+        {
+            { 1, 0 }, { 499, 0 }, { 500, 0 }, { 501, 0 }, { 5000, 0 }, { 20000, 0 },
+            { 1, 499 }, { 500, 1 }, { 20000, 499 },
+        };
+
+        for (auto const& [accounts, other] : cases)
+        {
+            for (uint32 i = 0; i < other; ++i)
+                queue.Add(900000 + i, Item + 1, 1);
+
+            std::string label = "reward.tick with " + std::to_string(accounts) + " account(s)";
+            if (other)
+                label += " + " + std::to_string(other) + " pending";
+
+            Run(label.c_str(), BudgetOp::RewardTick, [&](QueryBudgetScope& budget)
+            {
+                budget.AddUnits(accounts);
+                for (uint32 acc = 1; acc <= accounts; ++acc)
+                    queue.Add(acc, Item, 1);
+
+                std::vector<LedgerDelta> rows;
+                if (!queue.Flush(storage, rows) || rows.size() != accounts + other)
+                    Fail(label + ": flushed " + std::to_string(rows.size()) + " row(s)");
+            });
+        }
+    }
+
+    // kontrola testu samotného: dvojí čtení v .reward musí rozpočet překročit
+    void TestOverrunIsReported(MemoryRewardStorage& storage)
+    {
+        size_t before = sFailures.size();
+        {
+            QueryBudgetScope budget(BudgetOp::Reward);
+            LedgerBalance bal;
+            storage.ReadBalance(1, Item, bal);
+            storage.ReadBalance(1, Item, bal);
+        }
+
+        if (sFailures.size() != before + 1)
+            Fail("an extra round trip in .reward was not reported as an overrun");
+        else
+            sFailures.pop_back();
+    }
+}
+
+int main()
+{
+    SetQueryBudgetOverrunHandler(&OnOverrun);
+    MemoryRewardStorage storage;
+
+    TestOverrunIsReported(storage);
+    TestLedger(storage);
+    TestTokenSpend(storage);
+    TestStreak(storage);
+    TestMilestones(storage);
+    TestMilestoneRecordFails();
+    TestRewardTick(storage);
+
+    // každá operace z tabulky musí mít aspoň jeden případ
+    for (size_t i = 0; i < QueryBudgets.size(); ++i)
+        if (GetQueryBudgetStats(BudgetOp(i)).calls == 0)
+            Fail(std::string(QueryBudgets[i].name) + ": no test case");
+
+    for (std::string const& f : sFailures)
+        std::fprintf(stderr, "FAIL %s\n", f.c_str());
+    std::printf("%zu failure(s)\n", sFailures.size());
+    return sFailures.empty() ? 0 : 1;
+}
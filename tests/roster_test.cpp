@@ -0,0 +1,144 @@
+// modules/mod-real-online/tests/roster_test.cpp
+
+#include "roster_harness.h"
+#include "roster_view.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// =============================
+// Test filtru a rosteru .online (ctest)
+// =============================
+// CheckEligibility je jediný filtr .online, sériového výběru účtů i map
+// threadů; StandInRoster nad ním staví stránku .online a seznam pro
+// playtime tick stejně jako server (a benchmark a simulátor).
+namespace
+{
+    using namespace RealOnline;
+
+    std::vector<std::string> sFailures;
+
+    void Expect(bool ok, std::string what)
+    {
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+        if (!ok)
+            sFailures.push_back(std::move(what));
+    }
+
+    bool TestIsBot(uint32 account)                        { return account == 13; }
+    bool TestIsActiveSince(uint32 account, uint32 since) { return account != 14 || since > 100; }
+
+    EligibilityFilter TickFilter()
+    {
+        EligibilityFilter f;
+        f.hideGMs       = true;
+        f.minLevel      = 10;
+        f.activeSince   = 50;
+        f.ignoreRanges  = ParseRanges("20-29");
+        f.isBot         = &TestIsBot;
+        f.isActiveSince = &TestIsActiveSince;
+        return f;
+    }
+
+    Eligibility Check(EligibilityFilter const& f, uint32 account, uint32 level, bool inWorld = true, bool gm = false)
+    {
+        PlayerView v;
+        v.account    = account;
+        v.level      = level;
+        v.inWorld    = inWorld;
+        v.gameMaster = gm;
+        return CheckEligibility(f, v);
+    }
+
+    void TestFilter()
+    {
+        EligibilityFilter const f = TickFilter();
+        Expect(Check(f, 1, 60) == Eligibility::Eligible, "filter: eligible player");
+        Expect(Check(f, 1, 60, false) == Eligibility::Excluded, "filter: not in world");
+        Expect(Check(f, 1, 60, true, true) == Eligibility::Excluded, "filter: GM hidden");
+        Expect(Check(f, 1, 9) == Eligibility::Excluded, "filter: below min level");
+        Expect(Check(f, 25, 60) == Eligibility::Excluded, "filter: ignored account range");
+        Expect(Check(f, 13, 60) == Eligibility::Excluded, "filter: bot account");
+        Expect(Check(f, 14, 60) == Eligibility::Afk, "filter: AFK account");
+
+        // prázdný filtr (bez callbacků) pustí i GM s levelem 1
+        EligibilityFilter none;
+        Expect(Check(none, 13, 1, true, true) == Eligibility::Eligible, "filter: empty filter lets everyone in");
+    }
+
+    void TestCollect()
+    {
+        StandInRoster roster;
+        roster.Reset(40, 1, 10);
+
+        // GM každý 10. (účty 10, 20, 30, 40), rozsah 20-29, bot 13, AFK 14
+        uint32 expected = 0, expectedAfk = 0;
+        EligibilityFilter const f = TickFilter();
+        for (uint32 acc = 1; acc <= 40; ++acc)
+        {
+            Eligibility e = CheckEligibility(f, *roster.Find(acc));
+            expected    += e == Eligibility::Eligible;
+            expectedAfk += e == Eligibility::Afk;
+        }
+
+        std::vector<uint32> accounts;
+        uint32 afk = 0;
+        roster.CollectEligible(f, 40, accounts, afk);
+        Expect(accounts.size() == expected && afk == expectedAfk, "collect: same result as the filter per player");
+
+        bool clean = true;
+        for (uint32 acc : accounts)
+            clean = clean && !(acc >= 20 && acc <= 29) && acc % 10 != 0 && acc != 13 && acc != 14;
+        Expect(clean, "collect: no GM, ignored, bot or AFK account");
+
+        accounts.clear();
+        afk = 0;
+        roster.CollectEligible(f, 5, accounts, afk);
+        bool prefix = true;
+        for (uint32 acc : accounts)
+            prefix = prefix && acc <= 5;
+        Expect(prefix, "collect: only the first online players");
+    }
+
+    void TestRenderPage()
+    {
+        StandInRoster roster;
+        roster.Reset(120, 1, 0);
+
+        EligibilityFilter f;
+        size_t bytes = 0;
+        Msg err = Msg::PageExpected;
+        Expect(roster.RenderPage(f, 120, "3", 50, true, Lang::EN, bytes, err) && bytes > 0, "render: page 3 of 3");
+        Expect(roster.RenderPage(f, 120, "10-20", 50, false, Lang::CS, bytes, err) && bytes > 0, "render: range");
+
+        Expect(!roster.RenderPage(f, 120, "4", 50, true, Lang::EN, bytes, err) && err == Msg::PageNotExist,
+            "render: page out of range is rejected");
+
+        // prázdný roster -> jen hlavička
+        Expect(roster.RenderPage(f, 0, "", 50, true, Lang::EN, bytes, err) && bytes > 0, "render: empty roster");
+    }
+
+    void TestSort()
+    {
+        std::vector<std::string> names{ "Zed", "Anna", "Mira", "Bob" };
+        std::vector<std::string const*> list;
+        for (std::string const& n : names)
+            list.push_back(&n);
+        SortRoster(list, [](std::string const* n) -> std::string const& { return *n; });
+        Expect(*list[0] == "Anna" && *list[1] == "Bob" && *list[2] == "Mira" && *list[3] == "Zed", "sort: by name");
+    }
+}
+
+int main()
+{
+    TestFilter();
+    TestCollect();
+    TestRenderPage();
+    TestSort();
+
+    for (std::string const& f : sFailures)
+        std::fprintf(stderr, "FAIL %s\n", f.c_str());
+    std::printf("%zu failure(s)\n", sFailures.size());
+    return sFailures.empty() ? 0 : 1;
+}